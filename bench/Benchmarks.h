@@ -0,0 +1,31 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+// Headless benchmark entry points. Each one builds its own entities,
+// drives the systems directly (no window, no textures) and prints a
+// small report to stdout. Returns a process exit code.
+int runCrowdBenchmark(const std::vector<std::string>& args);
+int runRayBoxBenchmark(const std::vector<std::string>& args);
+int runLevelSweepBenchmark(const std::vector<std::string>& args);
+int runProceduralImageBenchmark(const std::vector<std::string>& args);
+// Not a benchmark: writes a generated level file for inspection or play
+int runGenerateLevel(const std::vector<std::string>& args);
+
+// Wall-clock stopwatch for frame timings
+class BenchTimer {
+public:
+    BenchTimer() : m_start(std::chrono::steady_clock::now()) {}
+
+    void restart() { m_start = std::chrono::steady_clock::now(); }
+
+    double elapsedMs() const {
+        const auto now = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(now - m_start).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point m_start;
+};
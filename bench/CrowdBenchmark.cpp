@@ -0,0 +1,256 @@
+#include "Benchmarks.h"
+#include "Systems.h"
+#include "components/CollisionComponent.h"
+#include "components/EnemyAIComponent.h"
+#include "components/PlayerComponent.h"
+#include "components/TransformComponent.h"
+#include "systems/CollisionSystem.h"
+#include "GameSettings.h"
+#include "Log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace {
+
+constexpr float kFrameTime = 1.f / 60.f;
+
+struct CrowdWorld {
+    std::vector<std::unique_ptr<Entity>> storage;
+    std::vector<Entity*> entities;
+    Entity* player = nullptr;
+};
+
+Entity& addEntity(CrowdWorld& world, const std::string& name) {
+    auto ptr = std::make_unique<Entity>();
+    ptr->name = name;
+    world.entities.push_back(ptr.get());
+    world.storage.push_back(std::move(ptr));
+    return *world.storage.back();
+}
+
+void addWall(CrowdWorld& world, const sf::Vector2f& center, const sf::Vector2f& size) {
+    Entity& wall = addEntity(world, "Wall");
+    wall.components.emplace_back(std::make_unique<eol::TransformComponent>(center, sf::Vector2f{1.f, 1.f}, 0.f));
+    auto collision = std::make_unique<eol::CollisionComponent>();
+    collision->setBoundingBox(size);
+    collision->setSolid(true);
+    wall.components.emplace_back(std::move(collision));
+}
+
+// Movement part of Game's enemy prefab: transform and AI, without melee,
+// hitbox or rendering
+Entity& addEnemy(CrowdWorld& world, const sf::Vector2f& spawnPos) {
+    Entity& enemy = addEntity(world, "Enemy");
+    enemy.components.emplace_back(std::make_unique<eol::TransformComponent>(spawnPos, sf::Vector2f{1.5f, 1.5f}, 0.f));
+
+    auto ai = std::make_unique<eol::EnemyAIComponent>();
+    ai->setPatrolPoints({
+        spawnPos,
+        spawnPos + sf::Vector2f{-GameSettings::relativeX(0.1f), 0.f},
+        spawnPos + sf::Vector2f{GameSettings::relativeX(0.1f), 0.f} });
+    ai->setDetectionRange(GameSettings::relativeMin(0.37f));
+    ai->setAttackRange(GameSettings::relativeMin(0.014f));
+    ai->setMoveSpeed(GameSettings::relativeMin(0.046f));
+    enemy.components.emplace_back(std::move(ai));
+    return enemy;
+}
+
+// A solid collider puts the enemy in the AI system's obstacle grid as a
+// moving solid. It then patrols between its spawn and target.
+void makeSolid(Entity& enemy, const sf::Vector2f& spawnPos, const sf::Vector2f& target) {
+    enemy.getComponent<eol::EnemyAIComponent>()->setPatrolPoints({ target, spawnPos });
+
+    auto collision = std::make_unique<eol::CollisionComponent>();
+    collision->setBoundingBox(GameSettings::relativeSize(0.02f, 0.035f));
+    collision->setSolid(true);
+    enemy.components.emplace_back(std::move(collision));
+}
+
+CrowdWorld buildWorld(int enemyCount) {
+    CrowdWorld world;
+    world.storage.reserve(enemyCount + 16);
+
+    // Arena border plus two interior walls for line-of-sight and avoidance
+    const float w = GameSettings::width();
+    const float h = GameSettings::height();
+    const float t = 40.f;
+    addWall(world, { w * 0.5f, t * 0.5f }, { w, t });
+    addWall(world, { w * 0.5f, h - t * 0.5f }, { w, t });
+    addWall(world, { t * 0.5f, h * 0.5f }, { t, h });
+    addWall(world, { w - t * 0.5f, h * 0.5f }, { t, h });
+    addWall(world, { w * 0.35f, h * 0.5f }, { t, h * 0.4f });
+    addWall(world, { w * 0.65f, h * 0.5f }, { t, h * 0.4f });
+
+    Entity& player = addEntity(world, "Player");
+    player.components.emplace_back(std::make_unique<eol::TransformComponent>(GameSettings::center(), sf::Vector2f{0.75f, 0.75f}, 0.f));
+    player.components.emplace_back(std::make_unique<eol::PlayerComponent>());
+    auto collision = std::make_unique<eol::CollisionComponent>();
+    collision->setBoundingBox(GameSettings::relativeSize(0.022f, 0.039f));
+    player.components.emplace_back(std::move(collision));
+    world.player = &player;
+
+    const sf::Vector2f spawners[] = {
+        GameSettings::relativePos(0.15f, 0.2f),
+        GameSettings::relativePos(0.85f, 0.2f),
+        GameSettings::relativePos(0.15f, 0.8f),
+        GameSettings::relativePos(0.85f, 0.8f),
+    };
+    // Most enemies stack on the spawners. The solid ones go in pairs along
+    // the top of the arena (stacked solids couldn't move apart), each
+    // patrolling through its partner's spawn so the two walk into each other
+    const int solidPairs = std::clamp(enemyCount / 100, 1, 8);
+    for (int i = 0; i < enemyCount; ++i) {
+        if (i < solidPairs * 2) {
+            const float pairX = 0.1f + 0.8f * (static_cast<float>(i / 2) + 0.5f) / static_cast<float>(solidPairs);
+            const float side = i % 2 == 0 ? -1.f : 1.f;
+            const sf::Vector2f spawn = GameSettings::relativePos(pairX + side * 0.025f, 0.12f);
+            makeSolid(addEnemy(world, spawn), spawn, GameSettings::relativePos(pairX - side * 0.04f, 0.12f));
+        }
+        else {
+            addEnemy(world, spawners[i % 4]);
+        }
+    }
+
+    return world;
+}
+
+// Pairs of enemies closer than the given distance (brute force)
+int countOverlaps(CrowdWorld& world, float minDistance) {
+    std::vector<sf::Vector2f> positions;
+    for (Entity* entity : world.entities) {
+        if (entity->hasComponent<eol::EnemyAIComponent>()) {
+            positions.push_back(entity->getComponent<eol::TransformComponent>()->getPosition());
+        }
+    }
+
+    int overlaps = 0;
+    for (std::size_t i = 0; i < positions.size(); ++i) {
+        for (std::size_t j = i + 1; j < positions.size(); ++j) {
+            const sf::Vector2f d = positions[i] - positions[j];
+            if (d.x * d.x + d.y * d.y < minDistance * minDistance) {
+                ++overlaps;
+            }
+        }
+    }
+    return overlaps;
+}
+
+// Solid enemies overlapping a wall or each other. Each move is tested
+// against where the other solids are at that moment, so this stays 0.
+int countSolidOverlaps(CrowdWorld& world) {
+    std::vector<sf::FloatRect> walls;
+    std::vector<sf::FloatRect> agents;
+    for (Entity* entity : world.entities) {
+        auto* collision = entity->getComponent<eol::CollisionComponent>();
+        if (!collision || !collision->isSolid()) {
+            continue;
+        }
+        (entity->hasComponent<eol::EnemyAIComponent>() ? agents : walls).push_back(CollisionSystem::getBounds(*entity));
+    }
+
+    int overlaps = 0;
+    for (std::size_t i = 0; i < agents.size(); ++i) {
+        for (const sf::FloatRect& wall : walls) {
+            overlaps += CollisionSystem::checkOverlap(agents[i], wall) ? 1 : 0;
+        }
+        for (std::size_t j = i + 1; j < agents.size(); ++j) {
+            overlaps += CollisionSystem::checkOverlap(agents[i], agents[j]) ? 1 : 0;
+        }
+    }
+    return overlaps;
+}
+
+// FNV-1a over every enemy's position bits, in entity order
+std::uint64_t positionChecksum(CrowdWorld& world) {
+    std::uint64_t hash = 14695981039346656037ull;
+    for (Entity* entity : world.entities) {
+        if (!entity->hasComponent<eol::EnemyAIComponent>()) {
+            continue;
+        }
+        const sf::Vector2f position = entity->getComponent<eol::TransformComponent>()->getPosition();
+        std::uint32_t bits[2];
+        std::memcpy(&bits[0], &position.x, sizeof(float));
+        std::memcpy(&bits[1], &position.y, sizeof(float));
+        for (std::uint32_t word : bits) {
+            for (int shift = 0; shift < 32; shift += 8) {
+                hash ^= (word >> shift) & 0xFFu;
+                hash *= 1099511628211ull;
+            }
+        }
+    }
+    return hash;
+}
+
+struct CrowdResult {
+    int overlaps = 0;
+    int solidOverlaps = 0;
+    std::uint64_t checksum = 0;
+};
+
+CrowdResult runMode(int enemyCount, int frames, bool steering) {
+    CrowdWorld world = buildWorld(enemyCount);
+    EnemyAISystem ai;
+    ai.setCrowdSteeringEnabled(steering);
+
+    double total = 0.0;
+    double worst = 0.0;
+    BenchTimer timer;
+    for (int frame = 0; frame < frames; ++frame) {
+        timer.restart();
+        ai.update(world.entities, kFrameTime, *world.player);
+        const double ms = timer.elapsedMs();
+        total += ms;
+        worst = std::max(worst, ms);
+    }
+
+    CrowdResult result;
+    result.overlaps = countOverlaps(world, ai.getSeparationRadius() * 0.5f);
+    result.solidOverlaps = countSolidOverlaps(world);
+    result.checksum = positionChecksum(world);
+    EOL_LOG_INFO << (steering ? "steering" : "direct  ")
+              << "  avg " << total / frames << " ms"
+              << "  max " << worst << " ms"
+              << "  overlapping pairs " << result.overlaps
+              << "  solid overlaps " << result.solidOverlaps
+              << "  checksum " << std::hex << result.checksum << std::dec;
+    return result;
+}
+
+} // namespace
+
+int runCrowdBenchmark(const std::vector<std::string>& args) {
+    const int enemyCount = args.size() > 0 ? std::max(1, std::stoi(args[0])) : 500;
+    const int frames = args.size() > 1 ? std::max(1, std::stoi(args[1])) : 600;
+
+    EOL_LOG_INFO << "EnemyAISystem crowd: " << enemyCount << " enemies, "
+              << frames << " frames @ 60 Hz";
+    const CrowdResult direct = runMode(enemyCount, frames, false);
+    const CrowdResult steering = runMode(enemyCount, frames, true);
+
+    // The timings are only worth reading if the crowd behaved: no solid
+    // enemy may end up inside a wall or another solid, steering has to
+    // spread the agents out, and a second run has to land every agent in
+    // exactly the same place
+    int failures = 0;
+    for (const CrowdResult* result : { &direct, &steering }) {
+        if (result->solidOverlaps != 0) {
+            EOL_LOG_ERROR << "crowd: " << result->solidOverlaps << " solid enemies overlap a wall or each other";
+            ++failures;
+        }
+    }
+    if (enemyCount > 1 && steering.overlaps >= direct.overlaps) {
+        EOL_LOG_ERROR << "crowd: steering left " << steering.overlaps
+                      << " overlapping pairs, direct movement " << direct.overlaps;
+        ++failures;
+    }
+    EOL_LOG_INFO << "steering again, for the determinism check:";
+    if (runMode(enemyCount, frames, true).checksum != steering.checksum) {
+        EOL_LOG_ERROR << "crowd: steering is not deterministic across runs";
+        ++failures;
+    }
+    return failures == 0 ? 0 : 1;
+}
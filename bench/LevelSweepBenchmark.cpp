@@ -0,0 +1,327 @@
+#include "Benchmarks.h"
+#include "Game.h"
+#include "PrefabLibrary.h"
+#include "Systems.h"
+#include "components/AnimationComponent.h"
+#include "components/AnimationLibrary.h"
+#include "components/CollisionComponent.h"
+#include "components/LevelGenerator.h"
+#include "components/LightComponent.h"
+#include "components/LightEmitterComponent.h"
+#include "components/Map.h"
+#include "components/MirrorComponent.h"
+#include "components/PlayerComponent.h"
+#include "components/TransformComponent.h"
+#include "systems/Camera.h"
+#include "systems/SpawnerSystem.h"
+#include "systems/WorldChunks.h"
+#include "GameSettings.h"
+#include "Log.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <memory>
+
+namespace {
+
+constexpr float kFrameTime = 1.f / 60.f;
+constexpr float kTileSize = 48.f;   // Game's minimum tile size, so big maps scroll
+
+const int kSizes[] = { 64, 128, 256 };
+const int kEnemyCounts[] = { 0, 100, 400 };
+const int kMirrorCounts[] = { 0, 64, 256 };
+
+// Per-system frame times, summed over the run
+struct SystemTimes {
+    double chunks = 0.0;
+    double animation = 0.0;
+    double ai = 0.0;
+    double melee = 0.0;
+    double spawners = 0.0;
+    double light = 0.0;
+
+    double total() const { return chunks + animation + ai + melee + spawners + light; }
+};
+
+// A generated level instantiated from the game's prefabs the way
+// Game::createEntities does it, without drawing anything
+struct SweepWorld {
+    Map map;
+    std::vector<std::unique_ptr<Entity>> storage;
+    std::vector<Entity*> entities;
+    Entity* player = nullptr;
+    WorldChunks chunks;
+    Camera camera;
+    sf::FloatRect bounds;
+};
+
+Entity& addEntity(SweepWorld& world, Entity&& entity) {
+    world.storage.push_back(std::make_unique<Entity>(std::move(entity)));
+    world.entities.push_back(world.storage.back().get());
+    return *world.storage.back();
+}
+
+sf::Vector2f tileCenter(int x, int y) {
+    return { (x + 0.5f) * kTileSize, (y + 0.5f) * kTileSize };
+}
+
+// The game's own archetypes; blank textures since nothing is drawn. Enemies
+// also get a looping clip so AnimationSystem has one row per enemy, as it
+// would with animated enemy sprites.
+struct SweepPrefabs {
+    sf::Texture blank;
+    PrefabLibrary library;
+    PrefabLibrary::PrefabId wall = PrefabLibrary::InvalidPrefab;
+    PrefabLibrary::PrefabId lightNode = PrefabLibrary::InvalidPrefab;
+    PrefabLibrary::PrefabId beacon = PrefabLibrary::InvalidPrefab;
+    PrefabLibrary::PrefabId mirror = PrefabLibrary::InvalidPrefab;
+    PrefabLibrary::PrefabId spawner = PrefabLibrary::InvalidPrefab;
+    PrefabLibrary::PrefabId enemy = PrefabLibrary::InvalidPrefab;
+
+    SweepPrefabs() {
+        Game::definePrefabs(library, blank, blank);
+        wall = library.find("Wall");
+        lightNode = library.find("LightNode");
+        beacon = library.find("LightBeacon");
+        mirror = library.find("Mirror");
+        spawner = library.find("Spawner");
+        enemy = library.find("Enemy");
+
+        eol::Animation walk;
+        walk.name = "bench.enemyWalk";
+        walk.frameCount = 6;
+        walk.frameWidth = 64;
+        walk.frameHeight = 64;
+        walk.frameDuration = 0.1f;
+        eol::AnimationLibrary::instance().add(walk);
+
+        Entity animated = library.instantiate(enemy);
+        auto clip = std::make_unique<eol::AnimationComponent>();
+        clip->setAnimation(walk.name);
+        animated.components.emplace_back(std::move(clip));
+        library.define("Enemy", std::move(animated));
+    }
+};
+
+// Alternating diagonals so beams actually bounce between mirrors
+void tiltMirror(Entity& e, bool rising) {
+    if (auto* mirror = e.getComponent<eol::MirrorComponent>()) {
+        mirror->setNormal(rising ? sf::Vector2f{0.7071f, -0.7071f} : sf::Vector2f{0.7071f, 0.7071f});
+    }
+    if (auto* transform = e.getComponent<eol::TransformComponent>()) {
+        transform->setRotation(rising ? -45.f : 45.f);
+    }
+}
+
+Entity makePlayer(const sf::Vector2f& position) {
+    Entity e;
+    e.name = "Player";
+    e.components.emplace_back(std::make_unique<eol::TransformComponent>(position, sf::Vector2f{0.75f, 0.75f}, 0.f));
+    e.components.emplace_back(std::make_unique<eol::PlayerComponent>());
+    auto collision = std::make_unique<eol::CollisionComponent>();
+    collision->setBoundingBox(GameSettings::relativeSize(0.022f, 0.039f));
+    collision->setSolid(true);
+    e.components.emplace_back(std::move(collision));
+    e.components.emplace_back(std::make_unique<eol::LightComponent>());
+    auto emitter = std::make_unique<eol::LightEmitterComponent>();
+    emitter->setBeamLength(GameSettings::relativeX(0.625f));
+    emitter->setBeamWidth(GameSettings::relativeMin(0.015f));
+    emitter->setDamage(50.f);
+    emitter->setMaxReflections(4);
+    emitter->setContinuousFire(true);
+    emitter->setTriggerHeld(true);
+    e.components.emplace_back(std::move(emitter));
+    return e;
+}
+
+void buildWorld(SweepWorld& world, const SweepPrefabs& prefabs, int size, int enemies, int mirrors, std::uint32_t seed) {
+    LevelGenSettings settings;
+    settings.width = size;
+    settings.height = size;
+    settings.seed = seed;
+    settings.beacons = 4;
+    settings.lightSources = size / 4;
+    settings.mirrors = mirrors;
+    settings.spawners = size / 16;
+    LevelGenerator::generate(settings, world.map);
+
+    world.bounds = sf::FloatRect({ 0.f, 0.f }, { size * kTileSize, size * kTileSize });
+    world.camera.setWorldBounds(world.bounds);
+    world.chunks.build(world.map, kTileSize, { 0.f, 0.f });
+
+    for (std::size_t chunk = 0; chunk < world.chunks.getChunkCount(); ++chunk) {
+        for (const sf::IntRect& rect : world.map.buildWallRects(world.chunks.getChunkTiles(chunk))) {
+            PrefabOverrides block;
+            block.size = sf::Vector2f(rect.size.x * kTileSize, rect.size.y * kTileSize);
+            block.position = sf::Vector2f(rect.position.x * kTileSize, rect.position.y * kTileSize) + *block.size * 0.5f;
+            addEntity(world, prefabs.library.instantiate(prefabs.wall, block));
+        }
+    }
+
+    const PrefabLibrary& library = prefabs.library;
+    sf::Vector2f start = tileCenter(1, 1);
+    std::vector<sf::Vector2f> floor;
+    bool rising = false;
+    for (int y = 0; y < world.map.getHeight(); ++y) {
+        for (int x = 0; x < world.map.getWidth(); ++x) {
+            PrefabOverrides at;
+            at.position = tileCenter(x, y);
+            switch (world.map.getTile(x, y)) {
+            case TileType::START:
+                start = *at.position;
+                break;
+            case TileType::LIGHT_SOURCE:
+                addEntity(world, library.instantiate(prefabs.lightNode, at));
+                break;
+            case TileType::BEACON_1:
+                at.requiredSources = 1;
+                addEntity(world, library.instantiate(prefabs.beacon, at));
+                break;
+            case TileType::BEACON_2:
+                at.requiredSources = 2;
+                addEntity(world, library.instantiate(prefabs.beacon, at));
+                break;
+            case TileType::BEACON_3:
+                at.requiredSources = 3;
+                addEntity(world, library.instantiate(prefabs.beacon, at));
+                break;
+            case TileType::BEACON_4:
+                at.requiredSources = 4;
+                addEntity(world, library.instantiate(prefabs.beacon, at));
+                break;
+            case TileType::MIRROR:
+                tiltMirror(addEntity(world, library.instantiate(prefabs.mirror, at)), rising = !rising);
+                break;
+            case TileType::SPAWNER:
+                addEntity(world, library.instantiate(prefabs.spawner, at));
+                break;
+            case TileType::EMPTY:
+                floor.push_back(*at.position);
+                break;
+            default:
+                break;
+            }
+        }
+    }
+
+    world.player = &addEntity(world, makePlayer(start));
+
+    // Enemies on seeded floor tiles; an LCG is plenty for scattering
+    std::uint32_t state = seed * 2654435761u + 1u;
+    for (int i = 0; i < enemies && !floor.empty(); ++i) {
+        state = state * 1664525u + 1013904223u;
+        addEntity(world, Game::instantiateEnemy(library, prefabs.enemy, floor[(state >> 8) % floor.size()]));
+    }
+
+    world.camera.snapTo(start);
+    world.chunks.assign(world.entities);
+    world.chunks.update(world.camera.getViewRect());
+}
+
+void runCase(const SweepPrefabs& prefabs, int size, int enemies, int mirrors, int frames, std::uint32_t seed,
+             bool useChunks) {
+    SweepWorld world;
+    buildWorld(world, prefabs, size, enemies, mirrors, seed);
+
+    CombatSystem combat;
+    LightSystem light(combat);
+    light.setOccluders(world.map, kTileSize, { 0.f, 0.f });
+    EnemyAISystem ai;
+    ai.setWorldBounds(world.bounds);
+    SpawnerSystem spawners;
+    spawners.setEnemyFactory([&prefabs](const sf::Vector2f& position) {
+        return Game::instantiateEnemy(prefabs.library, prefabs.enemy, position);
+    });
+
+    AnimationSystem animation;
+    SystemTimes times;
+    BenchTimer timer;
+    std::size_t activeSum = 0;
+    for (int frame = 0; frame < frames; ++frame) {
+        // The player walks right so chunks wake and sleep along the way
+        auto* transform = world.player->getComponent<eol::TransformComponent>();
+        transform->setPosition(GameSettings::clampToWorld(
+            transform->getPosition() + sf::Vector2f{ kTileSize * 0.25f, 0.f }, world.bounds));
+        world.camera.follow(transform->getPosition(), kFrameTime);
+
+        timer.restart();
+        if (useChunks) world.chunks.update(world.camera.getViewRect());
+        times.chunks += timer.elapsedMs();
+        std::vector<Entity*>& active = useChunks ? world.chunks.getActiveEntities() : world.entities;
+        activeSum += active.size();
+
+        timer.restart();
+        animation.update(active, kFrameTime);
+        times.animation += timer.elapsedMs();
+
+        timer.restart();
+        ai.update(active, kFrameTime, *world.player);
+        times.ai += timer.elapsedMs();
+
+        timer.restart();
+        combat.updateMeleeAttacks(active, kFrameTime);
+        times.melee += timer.elapsedMs();
+
+        timer.restart();
+        std::vector<Entity> spawned = spawners.update(active, kFrameTime);
+        for (Entity& enemy : spawned) {
+            Entity& added = addEntity(world, std::move(enemy));
+            world.chunks.add(&added);
+        }
+        times.spawners += timer.elapsedMs();
+
+        timer.restart();
+        light.update(active, kFrameTime);
+        times.light += timer.elapsedMs();
+    }
+
+    const double n = static_cast<double>(frames);
+    EOL_LOG_INFO << std::fixed << std::setprecision(3)
+        << std::setw(5) << size << std::setw(8) << enemies << std::setw(8) << mirrors
+        << std::setw(9) << world.entities.size() << std::setw(8) << activeSum / static_cast<std::size_t>(frames)
+        << std::setw(9) << times.chunks / n << std::setw(9) << times.animation / n << std::setw(9) << times.ai / n
+        << std::setw(9) << times.melee / n << std::setw(9) << times.spawners / n
+        << std::setw(9) << times.light / n << std::setw(9) << times.total() / n;
+}
+
+} // namespace
+
+int runLevelSweepBenchmark(const std::vector<std::string>& args) {
+    const int frames = args.size() > 0 ? std::max(1, std::stoi(args[0])) : 120;
+    const std::uint32_t seed = args.size() > 1 ? static_cast<std::uint32_t>(std::stoul(args[1])) : 1u;
+    const bool useChunks = args.size() > 2 ? std::stoi(args[2]) != 0 : true;
+
+    EOL_LOG_INFO << "Level sweep: " << frames << " frames @ 60 Hz, seed " << seed
+        << ", chunks " << (useChunks ? "on" : "off") << " (times are ms per frame)";
+    EOL_LOG_INFO << " size enemies mirrors entities  active   chunks     anim       ai    melee  spawner    light    total";
+    const SweepPrefabs prefabs;
+    for (int size : kSizes) {
+        for (int enemies : kEnemyCounts) {
+            for (int mirrors : kMirrorCounts) {
+                runCase(prefabs, size, enemies, mirrors, frames, seed, useChunks);
+            }
+        }
+    }
+    return 0;
+}
+
+int runGenerateLevel(const std::vector<std::string>& args) {
+    if (args.empty()) {
+        EOL_LOG_ERROR << "genlevel: missing output file";
+        return 1;
+    }
+
+    LevelGenSettings settings;
+    if (args.size() > 1) settings.width = std::stoi(args[1]);
+    if (args.size() > 2) settings.height = std::stoi(args[2]);
+    if (args.size() > 3) settings.seed = static_cast<std::uint32_t>(std::stoul(args[3]));
+    if (args.size() > 4) settings.mirrors = std::stoi(args[4]);
+
+    const std::vector<std::string> rows = LevelGenerator::generate(settings);
+    if (!LevelGenerator::writeToFile(rows, args[0])) {
+        return 1;
+    }
+    EOL_LOG_INFO << "Wrote " << rows[0].size() << "x" << rows.size() << " level to " << args[0];
+    return 0;
+}
@@ -0,0 +1,83 @@
+#include "Benchmarks.h"
+#include "systems/ProceduralImage.h"
+#include "Log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <functional>
+
+namespace {
+
+const sf::Color kCenter(255, 255, 230, 255);
+const sf::Color kEdge(255, 255, 230, 80);
+
+// The per-pixel setPixel generator Game used before the procedural module
+sf::Image referenceFalloff(unsigned int size) {
+    sf::Image img(sf::Vector2u(size, size), sf::Color::Transparent);
+    const float half = static_cast<float>(size) * 0.5f;
+    for (unsigned int y = 0; y < size; ++y) {
+        for (unsigned int x = 0; x < size; ++x) {
+            const float dx = static_cast<float>(x) - half + 0.5f;
+            const float dy = static_cast<float>(y) - half + 0.5f;
+            const float norm = std::sqrt(dx * dx + dy * dy) / half;
+            if (norm <= 1.f) {
+                const float t = std::clamp(norm, 0.f, 1.f);
+                auto mix = [t](std::uint8_t a, std::uint8_t b) {
+                    return static_cast<std::uint8_t>(a * (1.f - t) + b * t);
+                };
+                img.setPixel({ x, y }, sf::Color(mix(kCenter.r, kEdge.r), mix(kCenter.g, kEdge.g),
+                                                 mix(kCenter.b, kEdge.b), mix(kCenter.a, kEdge.a)));
+            }
+        }
+    }
+    return img;
+}
+
+// Best of repeats, in ms
+double bestOf(int repeats, const std::function<void()>& work) {
+    double best = 1e30;
+    for (int i = 0; i < repeats; ++i) {
+        BenchTimer timer;
+        work();
+        best = std::min(best, timer.elapsedMs());
+    }
+    return best;
+}
+
+} // namespace
+
+int runProceduralImageBenchmark(const std::vector<std::string>& args) {
+    const unsigned int size = args.size() > 0 ? static_cast<unsigned int>(std::max(1, std::stoi(args[0]))) : 1024u;
+    const int repeats = args.size() > 1 ? std::max(1, std::stoi(args[1])) : 5;
+
+    procedural::RadialFalloff glow;
+    glow.size = size;
+    glow.center = kCenter;
+    glow.edge = kEdge;
+
+    const std::string cacheDir = "cache/bench";
+    procedural::ImageCache cache(cacheDir);
+    procedural::PixelBuffer pixels;
+    procedural::generate(glow, pixels);
+    cache.store(procedural::cacheKey(glow), pixels);
+
+    sf::Image reference;
+    const double setPixelMs = bestOf(repeats, [&]() { reference = referenceFalloff(size); });
+    const double rowsMs = bestOf(repeats, [&]() { procedural::generate(glow, pixels); });
+    const double cachedMs = bestOf(repeats, [&]() { cache.load(procedural::cacheKey(glow), pixels); });
+    const double imageMs = bestOf(repeats, [&]() { reference = pixels.toImage(); });
+
+    const bool identical = std::equal(pixels.rgba.begin(), pixels.rgba.end(), referenceFalloff(size).getPixelsPtr());
+
+    EOL_LOG_INFO << "Radial falloff " << size << "x" << size << ", best of " << repeats;
+    EOL_LOG_INFO << "  setPixel loop   " << setPixelMs << " ms";
+    EOL_LOG_INFO << "  row kernels     " << rowsMs << " ms";
+    EOL_LOG_INFO << "  disk cache load " << cachedMs << " ms";
+    EOL_LOG_INFO << "  to sf::Image    " << imageMs << " ms";
+    EOL_LOG_INFO << "  output " << (identical ? "identical" : "DIFFERS");
+
+    std::error_code error;
+    std::filesystem::remove_all(cacheDir, error);
+    return identical ? 0 : 1;
+}
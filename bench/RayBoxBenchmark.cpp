@@ -0,0 +1,115 @@
+#include "Benchmarks.h"
+#include "systems/Geometry.h"
+#include "Log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace {
+
+struct Ray {
+    sf::Vector2f origin;
+    sf::Vector2f direction;
+};
+
+constexpr float kWorldSize = 4096.f;
+constexpr float kRayLength = 1500.f;
+
+// Nearest hit through the single-box call, as the systems did before batching
+bool nearestOneByOne(const Ray& ray, const std::vector<sf::FloatRect>& boxes, geometry::RayHit& outHit) {
+    bool found = false;
+    float best = kRayLength;
+    for (std::size_t i = 0; i < boxes.size(); ++i) {
+        float distance = 0.f;
+        sf::Vector2f normal;
+        if (geometry::intersectRayBox(ray.origin, ray.direction, best, boxes[i], distance, normal) &&
+            (!found || distance < best)) {
+            found = true;
+            best = distance;
+            outHit = geometry::RayHit{i, distance, normal};
+        }
+    }
+    return found;
+}
+
+template<typename Fn>
+double timeRays(const std::vector<Ray>& rays, Fn&& query, std::size_t& hits) {
+    hits = 0;
+    BenchTimer timer;
+    for (const Ray& ray : rays) {
+        geometry::RayHit hit;
+        if (query(ray, hit)) {
+            ++hits;
+        }
+    }
+    return timer.elapsedMs();
+}
+
+} // namespace
+
+int runRayBoxBenchmark(const std::vector<std::string>& args) {
+    const int boxCount = args.size() > 0 ? std::max(1, std::stoi(args[0])) : 1024;
+    const int rayCount = args.size() > 1 ? std::max(1, std::stoi(args[1])) : 20000;
+
+    std::mt19937 rng(1337);
+    std::uniform_real_distribution<float> position(0.f, kWorldSize);
+    std::uniform_real_distribution<float> extent(8.f, 96.f);
+    std::uniform_real_distribution<float> angle(0.f, 6.2831853f);
+
+    std::vector<sf::FloatRect> rects;
+    geometry::BoxBatch batch;
+    batch.reserve(static_cast<std::size_t>(boxCount));
+    for (int i = 0; i < boxCount; ++i) {
+        const sf::FloatRect rect({position(rng), position(rng)}, {extent(rng), extent(rng)});
+        rects.push_back(rect);
+        batch.add(rect);
+    }
+
+    std::vector<Ray> rays;
+    rays.reserve(static_cast<std::size_t>(rayCount));
+    for (int i = 0; i < rayCount; ++i) {
+        const float a = angle(rng);
+        rays.push_back(Ray{{position(rng), position(rng)}, {std::cos(a), std::sin(a)}});
+    }
+
+    // The batch kernel must agree with the scalar reference on every ray
+    std::size_t mismatches = 0;
+    for (const Ray& ray : rays) {
+        geometry::RayHit batched;
+        geometry::RayHit reference;
+        const bool hitBatched = geometry::intersectRayBoxes(ray.origin, ray.direction, kRayLength, batch, batched);
+        const bool hitReference = geometry::intersectRayBoxesScalar(ray.origin, ray.direction, kRayLength, batch, reference);
+        if (hitBatched != hitReference ||
+            (hitBatched && (batched.index != reference.index || batched.distance != reference.distance))) {
+            ++mismatches;
+        }
+    }
+
+    std::size_t hitsSingle = 0;
+    std::size_t hitsScalar = 0;
+    std::size_t hitsBatch = 0;
+    const double single = timeRays(rays, [&](const Ray& ray, geometry::RayHit& hit) {
+        return nearestOneByOne(ray, rects, hit);
+    }, hitsSingle);
+    const double scalar = timeRays(rays, [&](const Ray& ray, geometry::RayHit& hit) {
+        return geometry::intersectRayBoxesScalar(ray.origin, ray.direction, kRayLength, batch, hit);
+    }, hitsScalar);
+    const double batched = timeRays(rays, [&](const Ray& ray, geometry::RayHit& hit) {
+        return geometry::intersectRayBoxes(ray.origin, ray.direction, kRayLength, batch, hit);
+    }, hitsBatch);
+
+    const double tests = static_cast<double>(boxCount) * rayCount;
+    auto report = [&](const char* label, double ms, std::size_t hits) {
+        EOL_LOG_INFO << label << "  " << ms << " ms  "
+                  << ms * 1e6 / tests << " ns/test  hits " << hits;
+    };
+
+    EOL_LOG_INFO << "Ray vs AABB: " << boxCount << " boxes, " << rayCount << " rays, kernel "
+              << geometry::batchKernelName();
+    report("one-by-one", single, hitsSingle);
+    report("soa scalar", scalar, hitsScalar);
+    report("soa batch ", batched, hitsBatch);
+    EOL_LOG_INFO << "mismatches " << mismatches;
+    return mismatches == 0 ? 0 : 1;
+}
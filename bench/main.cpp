@@ -0,0 +1,57 @@
+#include <exception>
+#include <string>
+#include <vector>
+#include "Benchmarks.h"
+#include "Log.h"
+
+namespace {
+struct BenchmarkEntry {
+    const char* name;
+    const char* usage;
+    int (*run)(const std::vector<std::string>& args);
+};
+
+const BenchmarkEntry kBenchmarks[] = {
+    { "crowd", "crowd [enemies=500] [frames=600]", &runCrowdBenchmark },
+    { "raybox", "raybox [boxes=1024] [rays=20000]", &runRayBoxBenchmark },
+    { "sweep", "sweep [frames=120] [seed=1] [chunks=1]", &runLevelSweepBenchmark },
+    { "procimage", "procimage [size=1024] [repeats=5]", &runProceduralImageBenchmark },
+    { "genlevel", "genlevel <out.txt> [width=64] [height=36] [seed=1] [mirrors=8]", &runGenerateLevel },
+};
+
+void printUsage() {
+    EOL_LOG_INFO << "Usage: eol-bench <benchmark> [args...]";
+    for (const BenchmarkEntry& entry : kBenchmarks) {
+        EOL_LOG_INFO << "  " << entry.usage;
+    }
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        printUsage();
+        return 1;
+    }
+
+    const std::string name = argv[1];
+    const std::vector<std::string> args(argv + 2, argv + argc);
+
+    for (const BenchmarkEntry& entry : kBenchmarks) {
+        if (name == entry.name) {
+            // Arguments go straight to std::stoi and friends
+            try {
+                return entry.run(args);
+            }
+            catch (const std::exception& e) {
+                EOL_LOG_ERROR << name << ": bad arguments (" << e.what() << ")";
+                EOL_LOG_INFO << "Usage: eol-bench " << entry.usage;
+                return 1;
+            }
+        }
+    }
+
+    EOL_LOG_ERROR << "Unknown benchmark: " << name;
+    printUsage();
+    return 1;
+}
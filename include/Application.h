@@ -1,8 +1,10 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include <memory>
+#include <string>
 #include "scenes/SceneStack.h"
 #include "GameSettings.h"
+#include "ViewManager.h"
 
 
 class Application
@@ -16,9 +18,32 @@ public:
     void popScene();
     void replaceScene(std::shared_ptr<Scene> scene);
 
+    // Shared instance of a scene type constructed as T(Application&);
+    // see SceneStack::getCachedScene
+    template <typename T>
+    std::shared_ptr<T> getScene()
+    {
+        return sceneStack.getCachedScene<T>([this]() { return std::make_shared<T>(*this); });
+    }
+    void preloadScene(std::shared_ptr<Scene> scene) { sceneStack.queuePreload(std::move(scene)); }
+    bool isSceneOnStack(const std::shared_ptr<Scene>& scene) const { return sceneStack.contains(scene); }
+
+    // Fonts and other assets shared between scenes
+    SceneResources& getResources() { return sceneStack.getResources(); }
+
     // Access to window for scenes
     sf::RenderWindow& getWindow() { return window; }
 
+    // Cached letterboxed / world views and the pixel -> world mapping
+    ViewManager& getViews() { return views; }
+
+    // Per-frame input actions (fed by processEvents)
+    InputActionMap& getInput() { return sceneStack.getInput(); }
+
+    // Session recording: the first gameplay session takes (and clears) the path
+    void setRecordPath(const std::string& path) { recordPath = path; }
+    std::string takeRecordPath() { std::string path; path.swap(recordPath); return path; }
+
     // Resolution / framerate control
     void setResolution(unsigned int index);
     void setFramerateLimit(unsigned int limit);
@@ -31,7 +56,7 @@ private:
 
 private:
     sf::RenderWindow window;
-    sf::View scaledView;
+    ViewManager views;
 
     SceneStack sceneStack;
 
@@ -40,4 +65,6 @@ private:
     // Current settings
     unsigned int currentResolutionIndex = 0;
     unsigned int currentFramerate = 60;
+
+    std::string recordPath;
 };
@@ -1,13 +1,20 @@
 ﻿#pragma once
 #include <SFML/Graphics.hpp>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <memory>
 #include "Systems.h"
 #include "components/MirrorComponent.h"
+#include "systems/Camera.h"
 #include "systems/DialogSystem.h"
 #include "components/LevelManager.h"
 #include "systems/SpawnerSystem.h"
+#include "systems/WorldChunks.h"
+#include "ViewManager.h"
+#include "WorldSnapshot.h"
+#include "PrefabLibrary.h"
+#include "ResourceLoader.h"
 
 class Game
 {
@@ -16,19 +23,58 @@ public:
     explicit Game(int startLevel);
     int run();
 
+    // Loads any resources not already loaded through queueResources
     bool initialize();
+
+    // Background loading: queue the textures and font on a loader, and once
+    // it is done (isDone) call finishResources before initialize
+    void queueResources(ResourceLoader& loader);
+    bool finishResources(const ResourceLoader& loader);
     
-    void update(float deltaTime, sf::RenderWindow& window);
+    // Advances the simulation; reads no window or device state so a
+    // recorded (deltaTime, input) stream reproduces a session exactly
+    void update(float deltaTime, const InputFrame& input);
     
-    void render(sf::RenderWindow& window);
+    // Draws the world through views.getWorldView() moved to the camera,
+    // then the HUD and dialog through the scaled view
+    void render(sf::RenderWindow& window, ViewManager& views);
+
+    // Centre for the world view; map cursor positions through it
+    sf::Vector2f getCameraCenter() const { return camera_.getCenter(); }
     
     // Frame rate control
     void setFramerateLimit(unsigned int limit);
     unsigned int getFramerateLimit() const;
 
+    int getStartLevel() const { return startLevelIndex_; }
+
+    // Hash of gameplay-relevant entity state, used by replay checkpoints
+    std::uint64_t computeStateHash() const;
+
+    // Full world state (level, entities, components, beams, dialog) in one
+    // flat buffer. Restoring into the same level reuses the live entities;
+    // only spawned enemies are added or dropped to match the snapshot.
+    // A snapshot that doesn't fit is refused with the world left unchanged.
+    void saveSnapshot(WorldSnapshot& snapshot) const;
+    bool restoreSnapshot(const WorldSnapshot& snapshot);
+
+    // Defines the built-in archetypes (Wall, LightNode, LightBeacon, Mirror,
+    // Spawner, Enemy) without the data file patches. Headless tools can pass
+    // blank textures.
+    static void definePrefabs(PrefabLibrary& prefabs, const sf::Texture& debugWhite, const sf::Texture& lightNode);
+
+    // An Enemy instance patrolling around position, as spawners place them
+    static Entity instantiateEnemy(const PrefabLibrary& prefabs, PrefabLibrary::PrefabId enemy,
+        const sf::Vector2f& position);
+
+    // Instant restart to the state the current level started in
+    bool restartLevel();
+
 private:
     
+    // Same as queueResources + finishResources, blocking
     bool loadResources();
+    bool resourcesLoaded_ = false;
     std::string findResourcePath(const std::string& relativePath) const;
 
     LevelManager levels_;
@@ -37,22 +83,41 @@ private:
     void recalculateTileSize();
     void applyWallTextureForCurrentLevel();
     void createEntities();
+    void matchEntityCount(std::size_t count);
+
+    // Shared clips in eol::AnimationLibrary; must run before any entity
+    // with an AnimationComponent is created
+    void registerAnimationClips();
+
+    // Archetypes for map tiles and spawned enemies, built once after the
+    // textures are loaded and then patched from resources/prefabs
+    void buildPrefabs();
+    PrefabLibrary prefabs_;
+    PrefabLibrary::PrefabId wallPrefab_ = PrefabLibrary::InvalidPrefab;
+    PrefabLibrary::PrefabId lightNodePrefab_ = PrefabLibrary::InvalidPrefab;
+    PrefabLibrary::PrefabId beaconPrefab_ = PrefabLibrary::InvalidPrefab;
+    PrefabLibrary::PrefabId mirrorPrefab_ = PrefabLibrary::InvalidPrefab;
+    PrefabLibrary::PrefabId spawnerPrefab_ = PrefabLibrary::InvalidPrefab;
+    PrefabLibrary::PrefabId enemyPrefab_ = PrefabLibrary::InvalidPrefab;
 
 
     
     Entity createPlayerEntity();
-    Entity createLightBeaconEntity(const sf::Vector2f& worldPosition, int beaconNumber);
-    Entity createEnemyEntity();
-    Entity createMirrorEntity(const sf::Vector2f& position,
+    static Entity createLightBeaconEntity(const sf::Vector2f& worldPosition, int beaconNumber);
+    static Entity createEnemyEntity(const sf::Texture& debugWhite);
+    static Entity createMirrorEntity(const sf::Texture& debugWhite,
+        const sf::Vector2f& position,
         const sf::Vector2f& normal,
         const sf::Vector2f& size,
         eol::MirrorComponent::MirrorType type);
-    Entity createLightSourceNode(const std::string& name,
+    static Entity createLightSourceNode(const sf::Texture& lightNode,
+        const std::string& name,
         const sf::Vector2f& position,
         bool movable);
-    Entity createWallEntity(const sf::Vector2f& position,
+    static Entity createWallEntity(const sf::Texture& debugWhite,
+        const sf::Vector2f& position,
         const sf::Vector2f& size);
-    Entity createSpawnerEntity(const sf::Vector2f& position,
+    static Entity createSpawnerEntity(const sf::Vector2f& position,
         float interval,
         int maxEnemies);
     Entity createEnemyAtPosition(const sf::Vector2f& position);
@@ -62,6 +127,13 @@ private:
     float tileSize_ = 0.f;
     sf::Vector2f mapOffset_ = { 0.f, 0.f };
 
+    // Follows the player over levels larger than one screen
+    Camera camera_;
+
+    // Level split into chunks; only those around the camera are simulated
+    // and drawn
+    WorldChunks chunks_;
+
 
     // Helper to convert tile coords to world coords
     sf::Vector2f tileToWorld(int tileX, int tileY) const;
@@ -91,7 +163,24 @@ private:
     };
     TutorialStep tutorialStep_ = TutorialStep::None;
     bool tutorialActionDetected_ = false;  // Tracks if current action was performed
-    void updateTutorial();
+
+    // What a snapshot holds, read without touching the world so a restore
+    // can be refused before anything changes
+    struct SnapshotLayout {
+        int level = 0;
+        bool gameComplete = false;
+        bool beaconsPreviouslySolved = false;
+        int lastBeaconHintShown = 0;
+        TutorialStep tutorialStep = TutorialStep::None;
+        bool tutorialActionDetected = false;
+        std::vector<std::uint32_t> componentCounts;   // one per entity
+    };
+    static bool readSnapshotLayout(const WorldSnapshot& snapshot, SnapshotLayout& layout);
+    bool snapshotFitsWorld(const SnapshotLayout& layout) const;
+    bool switchToLevel(int level);
+    void applySnapshot(const WorldSnapshot& snapshot, const SnapshotLayout& layout);
+    WorldSnapshot restoreRollback_;
+    void updateTutorial(const InputFrame& input);
     void advanceTutorial();
 
 
@@ -112,6 +201,10 @@ private:
     
     std::vector<std::unique_ptr<Entity>> worldObjects_;
 
+    // Entities built from the map (plus player/enemy); anything after is spawned
+    std::size_t levelEntityCount_ = 0;
+    WorldSnapshot levelStartSnapshot_;
+
 
     
     InputSystem inputSystem_;
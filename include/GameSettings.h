@@ -127,10 +127,20 @@ public:
 
     // Clamp a position to stay within world bounds
     static sf::Vector2f clampToWorld(const sf::Vector2f& pos, float marginPercent = 0.025f) {
+        return clampToWorld(pos, referenceBounds(), marginPercent);
+    }
+
+    // Same, for a world of any size (levels larger than one screen)
+    static sf::Vector2f clampToWorld(const sf::Vector2f& pos, const sf::FloatRect& world, float marginPercent = 0.025f) {
         float margin = relativeMin(marginPercent);
         return sf::Vector2f{
-            std::max(margin, std::min(pos.x, width() - margin)),
-            std::max(margin, std::min(pos.y, height() - margin))
+            std::max(world.position.x + margin, std::min(pos.x, world.position.x + world.size.x - margin)),
+            std::max(world.position.y + margin, std::min(pos.y, world.position.y + world.size.y - margin))
         };
     }
+
+    // The reference resolution as a rectangle at the origin
+    static sf::FloatRect referenceBounds() {
+        return sf::FloatRect(sf::Vector2f{ 0.f, 0.f }, sf::Vector2f{ width(), height() });
+    }
 };
\ No newline at end of file
@@ -0,0 +1,88 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// Logical gameplay actions - systems ask for these instead of raw keys
+enum class InputAction : std::uint8_t {
+    MoveUp,
+    MoveDown,
+    MoveLeft,
+    MoveRight,
+    Fire,
+    Interact,       // pick up / drop
+    Rotate,         // rotate carried object
+    Advance,        // continue dialog
+    Count
+};
+
+// State of every action for one frame.
+// Plain data (bitmasks + cursor) so a frame can be copied, stored or replayed.
+struct InputFrame {
+    std::uint16_t held = 0;       // action is down at the end of the frame
+    std::uint16_t pressed = 0;    // went down during the frame
+    std::uint16_t released = 0;   // went up during the frame
+    sf::Vector2i cursor{ 0, 0 };  // last known mouse position in window pixels
+    sf::Vector2f aim{ 0.f, 0.f }; // cursor in world coordinates, filled in by the
+                                  // gameplay scene once its view is applied
+
+    static constexpr std::uint16_t bit(InputAction action) {
+        return static_cast<std::uint16_t>(1u << static_cast<unsigned>(action));
+    }
+
+    bool isHeld(InputAction action) const { return (held & bit(action)) != 0; }
+    bool wasPressed(InputAction action) const { return (pressed & bit(action)) != 0; }
+    bool wasReleased(InputAction action) const { return (released & bit(action)) != 0; }
+
+    // Held now, or tapped and released within the same frame
+    bool isActive(InputAction action) const { return isHeld(action) || wasPressed(action); }
+};
+
+// Turns window events into per-frame action state.
+// Fed from SceneStack::handleEvent; edges are cleared by endFrame()
+// once the scenes have run their update.
+class InputActionMap {
+public:
+    InputActionMap();
+
+    // Rebinding - an action may have several keys/buttons
+    void bindKey(InputAction action, sf::Keyboard::Key key);
+    void bindMouseButton(InputAction action, sf::Mouse::Button button);
+    void clearBindings(InputAction action);
+    void resetToDefaults();
+
+    void handleEvent(const sf::Event& event);
+
+    const InputFrame& getFrame() const noexcept { return frame; }
+
+    // Clear pressed/released edges, keep held state and cursor
+    void endFrame() noexcept;
+
+    // Release everything (e.g. window lost focus)
+    void releaseAll() noexcept;
+
+private:
+    struct KeyBinding {
+        sf::Keyboard::Key key;
+        InputAction action;
+    };
+
+    struct MouseBinding {
+        sf::Mouse::Button button;
+        InputAction action;
+    };
+
+    void setKeyState(sf::Keyboard::Key key, bool down);
+    void setMouseState(sf::Mouse::Button button, bool down);
+    void refreshAction(InputAction action);
+
+private:
+    std::vector<KeyBinding> keyBindings;
+    std::vector<MouseBinding> mouseBindings;
+
+    std::array<bool, sf::Keyboard::KeyCount> keyDown{};
+    std::array<bool, sf::Mouse::ButtonCount> mouseDown{};
+
+    InputFrame frame;
+};
@@ -0,0 +1,100 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "InputActionMap.h"
+
+// One Game::update step exactly as it was fed during recording
+struct ReplayFrame
+{
+    float dt = 0.f;
+    InputFrame input;
+};
+
+// Entity-state hash taken once `frame` updates had been applied
+struct ReplayCheckpoint
+{
+    std::uint32_t frame = 0;
+    std::uint64_t hash = 0;
+};
+
+// FNV-1a accumulator for entity state.
+// Floats are hashed by bit pattern so any simulation drift shows up.
+class StateHasher
+{
+public:
+    void addBytes(const void* data, std::size_t size);
+    void addFloat(float value);
+    void addInt(std::int64_t value);
+    void addBool(bool value) { addInt(value ? 1 : 0); }
+    void addVector(const sf::Vector2f& value) { addFloat(value.x); addFloat(value.y); }
+    void addString(const std::string& value);
+
+    std::uint64_t getValue() const noexcept { return value; }
+
+private:
+    std::uint64_t value = 14695981039346656037ull;
+};
+
+// Writes a session's per-frame input and delta time to a compact binary file.
+//
+// Layout (little endian):
+//   header  "EOLR", u16 version, u16 reserved, i32 start level, u32 checkpoint interval
+//   records u8 tag, then payload
+//     tag < 0x80   frame; bits say which fields changed since the previous frame
+//                  (dt f32, held u16, pressed u16, released u16, aim 2 x f32)
+//     tag = 0x80   checkpoint; u64 state hash
+//     tag = 0xFF   end of stream; u32 frame count
+// Window-pixel cursor positions are not stored, only the world-space aim.
+class InputRecorder
+{
+public:
+    InputRecorder() = default;
+    ~InputRecorder();
+
+    InputRecorder(const InputRecorder&) = delete;
+    InputRecorder& operator=(const InputRecorder&) = delete;
+
+    bool open(const std::string& path, int startLevel, std::uint32_t checkpointInterval = 60);
+    bool isOpen() const noexcept { return file.is_open(); }
+
+    // Call once per Game::update with exactly the values it was given
+    void recordFrame(float dt, const InputFrame& input);
+
+    // True right after every checkpointInterval-th frame
+    bool isCheckpointDue() const noexcept;
+    void recordCheckpoint(std::uint64_t hash);
+
+    // Writes the end marker and closes the file
+    void close();
+
+    std::uint32_t getFrameCount() const noexcept { return frameCount; }
+
+private:
+    std::ofstream file;
+    ReplayFrame previous;
+    std::uint32_t frameCount = 0;
+    std::uint32_t checkpointInterval = 60;
+};
+
+// A recording loaded fully into memory
+class InputReplay
+{
+public:
+    bool load(const std::string& path);
+
+    int getStartLevel() const noexcept { return startLevel; }
+    std::uint32_t getCheckpointInterval() const noexcept { return checkpointInterval; }
+
+    const std::vector<ReplayFrame>& getFrames() const noexcept { return frames; }
+    const std::vector<ReplayCheckpoint>& getCheckpoints() const noexcept { return checkpoints; }
+
+private:
+    int startLevel = 0;
+    std::uint32_t checkpointInterval = 0;
+    std::vector<ReplayFrame> frames;
+    std::vector<ReplayCheckpoint> checkpoints;
+};
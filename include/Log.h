@@ -0,0 +1,133 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <thread>
+
+enum class LogLevel : std::uint8_t
+{
+    Debug = 0,
+    Info = 1,
+    Warning = 2,
+    Error = 3,
+};
+
+// Lowest level compiled in. EOL_LOG_* statements below it vanish entirely,
+// arguments included. Override with -DEOL_LOG_MIN_LEVEL=<0..4>.
+#ifndef EOL_LOG_MIN_LEVEL
+#ifdef NDEBUG
+#define EOL_LOG_MIN_LEVEL 1
+#else
+#define EOL_LOG_MIN_LEVEL 0
+#endif
+#endif
+
+// Process-wide asynchronous logger.
+//
+// Callers copy each line into a slot of a bounded lock-free ring and return;
+// a background thread writes Debug/Info to stdout and Warning/Error to stderr
+// and flushes once per batch. Multi-line messages take one slot per line.
+// When the ring is full the line is dropped and counted instead of blocking
+// the caller. After shutdown() lines are written synchronously.
+class Logger
+{
+public:
+    static constexpr std::size_t kCapacity = 1024;      // slots, power of two
+    static constexpr std::size_t kMaxLineLength = 240;  // longer lines are cut
+
+    static Logger& instance();
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    void write(LogLevel level, const std::string& message);
+
+    // Runtime filter on top of EOL_LOG_MIN_LEVEL
+    void setMinLevel(LogLevel level) noexcept;
+    bool isEnabled(LogLevel level) const noexcept
+    {
+        return static_cast<int>(level) >= minLevel.load(std::memory_order_relaxed);
+    }
+
+    // Blocks until every line queued before the call has been written
+    void flush();
+    // Flushes and stops the writer thread; registered with atexit
+    void shutdown();
+
+    std::uint64_t getDroppedCount() const noexcept { return dropped.load(std::memory_order_relaxed); }
+
+private:
+    Logger();
+
+    struct Slot
+    {
+        std::atomic<std::size_t> sequence{ 0 };
+        LogLevel level = LogLevel::Info;
+        std::uint16_t length = 0;
+        char text[kMaxLineLength];
+    };
+
+    void pushLine(LogLevel level, const char* text, std::size_t length);
+    bool drain();
+    void run();
+
+    std::array<Slot, kCapacity> slots;
+    alignas(64) std::atomic<std::size_t> enqueuePos{ 0 };
+    alignas(64) std::atomic<std::size_t> dequeuePos{ 0 };
+    std::atomic<std::uint64_t> dropped{ 0 };
+    std::uint64_t droppedReported = 0;
+    std::atomic<int> minLevel{ EOL_LOG_MIN_LEVEL };
+    std::atomic<bool> running{ false };
+    std::thread writer;
+};
+
+// One log statement: collects operator<< output and queues it when the
+// statement ends
+class LogLine
+{
+public:
+    explicit LogLine(LogLevel level) : level(level) {}
+    ~LogLine() { Logger::instance().write(level, stream.str()); }
+
+    LogLine(const LogLine&) = delete;
+    LogLine& operator=(const LogLine&) = delete;
+
+    template<typename T>
+    LogLine& operator<<(const T& value)
+    {
+        stream << value;
+        return *this;
+    }
+
+private:
+    LogLevel level;
+    std::ostringstream stream;
+};
+
+// Lets EOL_LOG be a single expression, so it is safe inside if/else
+struct LogVoidify
+{
+    void operator&(LogLine&) {}
+};
+
+// Compile-time half of the filter. A function rather than an inline
+// comparison, so a minimum level of 0 doesn't warn at every log site.
+constexpr bool logCompiledIn(LogLevel level)
+{
+    constexpr int minLevel = EOL_LOG_MIN_LEVEL;
+    return static_cast<int>(level) >= minLevel;
+}
+
+#define EOL_LOG(level)                                                      \
+    (!logCompiledIn(level) ||                                               \
+     !Logger::instance().isEnabled(level))                                  \
+        ? (void)0                                                           \
+        : LogVoidify() & LogLine(level)
+
+#define EOL_LOG_DEBUG EOL_LOG(LogLevel::Debug)
+#define EOL_LOG_INFO EOL_LOG(LogLevel::Info)
+#define EOL_LOG_WARNING EOL_LOG(LogLevel::Warning)
+#define EOL_LOG_ERROR EOL_LOG(LogLevel::Error)
@@ -0,0 +1,69 @@
+#pragma once
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Systems.h"
+
+// Per-instance changes applied to a freshly copied prefab
+struct PrefabOverrides
+{
+    std::optional<std::string> name;
+    std::optional<sf::Vector2f> position;         // Transform
+    std::optional<sf::Vector2f> size;             // Collision box and sprite scale
+    std::optional<unsigned int> requiredSources;  // Puzzle (beacon number)
+};
+
+// Archetype templates that level building and spawners copy from.
+// A prototype is set up once; instantiate() clones its components in a
+// single pass into pooled storage (see ComponentPool) and then applies the
+// overrides, instead of constructing and configuring every component anew.
+//
+// Prototypes can be patched from a text file:
+//
+//     # comment
+//     prefab Enemy
+//     Enemy health=150 maxHealth=150
+//     Render tint=255,80,80,240
+//
+// Each line after "prefab <name>" names a component (its getName()) followed
+// by key=value pairs. Components the prototype lacks are added. Vectors are
+// "x,y", colours "r,g,b[,a]", rects "left,top,width,height".
+class PrefabLibrary
+{
+public:
+    using PrefabId = std::size_t;
+    static constexpr PrefabId InvalidPrefab = static_cast<PrefabId>(-1);
+
+    // Maps a RenderComponent texture id from a data file to a loaded texture
+    using TextureResolver = std::function<const sf::Texture*(const std::string&)>;
+
+    // Adds or replaces an archetype; ids stay valid across redefinition
+    PrefabId define(const std::string& name, Entity prototype);
+
+    PrefabId find(const std::string& name) const;
+    const Entity* getPrototype(PrefabId id) const;
+    std::size_t size() const noexcept { return prototypes.size(); }
+
+    Entity instantiate(PrefabId id, const PrefabOverrides& overrides = {}) const;
+    Entity instantiate(const std::string& name, const PrefabOverrides& overrides = {}) const;
+
+    void setTextureResolver(TextureResolver resolver);
+
+    // Applies patches from a prefab data file. A missing file is not an
+    // error; malformed lines are reported and skipped.
+    bool loadFromFile(const std::string& path);
+
+    void clear();
+
+private:
+    bool applyLine(Entity& prototype, const std::string& line, const std::string& path, int lineNumber);
+
+    std::vector<Entity> prototypes;
+    std::unordered_map<std::string, PrefabId> ids;
+    TextureResolver textureResolver;
+};
@@ -0,0 +1,62 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+#include "InputRecording.h"
+#include "WorldSnapshot.h"
+
+class Game;
+
+// Drives Game::update with a recorded input stream, one frame per step(),
+// verifying the entity-state hash at each recorded checkpoint and timing
+// every update. Used both headless (main --replay --headless) and windowed
+// (GameplayScene).
+class ReplaySession
+{
+public:
+    explicit ReplaySession(InputReplay replay);
+
+    int getStartLevel() const noexcept { return replay.getStartLevel(); }
+
+    bool isFinished() const noexcept { return nextFrame >= replay.getFrames().size(); }
+
+    // Applies the next recorded frame; returns false once the stream is exhausted
+    bool step(Game& game);
+
+    // At every checkpoint also snapshot the world, restore it and re-hash,
+    // checking that save/restore is lossless mid-session
+    void setRollbackCheckEnabled(bool enabled) noexcept { rollbackCheck = enabled; }
+
+    std::size_t getFramesPlayed() const noexcept { return nextFrame; }
+    std::size_t getCheckpointsVerified() const noexcept { return verified; }
+    std::size_t getMismatchCount() const noexcept { return mismatches; }
+    std::size_t getRollbackFailureCount() const noexcept { return rollbackFailures; }
+
+    // Frame timing and checkpoint summary
+    void printReport(std::ostream& out) const;
+
+private:
+    void verifyCheckpoints(Game& game);
+
+private:
+    InputReplay replay;
+
+    std::size_t nextFrame = 0;
+    std::size_t nextCheckpoint = 0;
+    std::size_t verified = 0;
+    std::size_t mismatches = 0;
+
+    bool rollbackCheck = false;
+    std::size_t rollbackFailures = 0;
+    WorldSnapshot snapshot;
+    std::vector<float> snapshotTimesMs;
+    std::vector<float> restoreTimesMs;
+
+    std::vector<float> updateTimesMs;
+};
+
+// Replays a recording without opening a window.
+// Returns 0 when every checkpoint matched, 1 otherwise.
+int runHeadlessReplay(const std::string& path, bool rollbackCheck = false);
@@ -0,0 +1,94 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Loads textures and fonts in the background.
+//
+// Jobs are queued up front, then start() hands them to worker threads:
+// image files are decoded and procedural images generated there, and fonts
+// are opened there outright. Only the texture upload needs the thread that
+// owns the GL context, so decoded images wait until the main thread calls
+// uploadReady() (a few per frame, so a loading screen keeps drawing) or
+// finish(). Targets must stay alive until the loader is done or destroyed;
+// destroying it early skips the jobs no worker has picked up yet.
+class ResourceLoader
+{
+public:
+    // Fills in an image on a worker thread; returns false on failure
+    using ImageSource = std::function<bool(sf::Image&)>;
+
+    ResourceLoader() = default;
+    ~ResourceLoader();
+
+    ResourceLoader(const ResourceLoader&) = delete;
+    ResourceLoader& operator=(const ResourceLoader&) = delete;
+
+    // An image file. If it cannot be read, fallback is used (with a
+    // warning) when given; otherwise the whole load counts as failed.
+    void addTexture(sf::Texture& target, const std::string& path, ImageSource fallback = {});
+    void addGeneratedTexture(sf::Texture& target, const std::string& name, ImageSource source);
+    void addFont(sf::Font& target, const std::string& path);
+
+    // Launches the workers; 0 picks one per spare core (at most kMaxWorkers).
+    // No jobs may be added afterwards.
+    void start(unsigned int workerCount = 0);
+
+    // Main thread: uploads up to maxUploads decoded images, returns how many
+    // jobs completed in this call
+    std::size_t uploadReady(std::size_t maxUploads);
+    // Main thread: blocks until every job is decoded and uploaded
+    void finish();
+
+    bool isStarted() const noexcept { return started; }
+    bool isDone() const noexcept { return completed == jobs.size(); }
+    bool hasFailed() const noexcept { return failed; }
+    std::size_t getJobCount() const noexcept { return jobs.size(); }
+    // Share of jobs completed, 0..1
+    float getProgress() const noexcept;
+
+    static constexpr unsigned int kMaxWorkers = 4;
+
+private:
+    enum class JobKind { FileTexture, GeneratedTexture, Font };
+
+    struct Job
+    {
+        JobKind kind = JobKind::FileTexture;
+        std::string name;               // path, or a label for generated images
+        ImageSource source;             // generated image, or fallback for a file
+        sf::Texture* texture = nullptr;
+        sf::Font* font = nullptr;
+
+        // Written by the worker, read by the main thread once it is ready
+        sf::Image image;
+        bool decoded = false;
+        bool usedFallback = false;
+    };
+
+    void runWorker();
+    void decode(Job& job);
+    void complete(Job& job);
+
+    std::vector<Job> jobs;
+    std::vector<std::thread> workers;
+    std::atomic<std::size_t> nextJob{ 0 };
+    std::atomic<bool> cancelled{ false };
+
+    // Indices of decoded jobs waiting for the main thread
+    std::mutex readyMutex;
+    std::condition_variable readyChanged;
+    std::vector<std::size_t> ready;
+    std::vector<std::size_t> uploading;
+
+    // Main thread only
+    std::size_t completed = 0;
+    bool failed = false;
+    bool started = false;
+};
@@ -6,11 +6,31 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#include "GameSettings.h"
+#include "InputActionMap.h"
+#include "components/AnimationLibrary.h"
+#include "components/AnimationStore.h"
 #include "components/Component.h"
 #include "components/EnemyAIComponent.h"
+#include "components/LightFieldStore.h"
 #include "components/LightEmitterComponent.h"
+#include "components/MirrorComponent.h"
+#include "systems/BeamStore.h"
+#include "systems/EntityListTracker.h"
+#include "systems/Geometry.h"
+#include "systems/ShadowCaster.h"
+#include "systems/SpatialGrid.h"
+
+namespace eol {
+class AnimationComponent;
+class CollisionComponent;
+class LightComponent;
+class RenderComponent;
+class TransformComponent;
+} // namespace eol
 
 // Simple Entity structure 
 struct Entity {
@@ -34,42 +54,74 @@ struct Entity {
 };
 
 
-// INPUT SYSTEM - Handles player keyboard input
+// INPUT SYSTEM - Applies the frame's input actions to the player
 class InputSystem {
 public:
-    void update(Entity& player, float deltaTime, const sf::RenderWindow& window);
+    void update(Entity& player,
+        float deltaTime,
+        const InputFrame& input);
 
     // Updated with collision checking 
     void updateWithCollision(Entity& player,
         float deltaTime,
-        const sf::RenderWindow& window,
+        const InputFrame& input,
         std::vector<Entity*>& entities);
 
+    // Area the player is kept inside; defaults to the reference screen
+    void setWorldBounds(const sf::FloatRect& bounds) noexcept;
+
 private:
-    sf::Vector2f getMovementInput() const;
-    void updatePlayerEmitter(Entity& player, const sf::RenderWindow& window);
+    sf::Vector2f getMovementInput(const InputFrame& input) const;
+    void updatePlayerEmitter(Entity& player, const InputFrame& input);
 
-    void handlePickupDrop(Entity& player, std::vector<Entity*>& entities);
-    void handleMirrorRotation(Entity& player);
-    bool m_pickupKeyWasPressed{ false };
-    bool m_rotateKeyWasPressed{ false };
+    void handlePickupDrop(Entity& player, const InputFrame& input, std::vector<Entity*>& entities);
+    void handleMirrorRotation(Entity& player, const InputFrame& input);
+    void playMovementClip(eol::AnimationComponent& animation, bool isMoving);
+
+    // Resolved on first use; clips are registered after systems are built
+    eol::ClipHandle m_idleClip{ eol::InvalidClip };
+    eol::ClipHandle m_walkClip{ eol::InvalidClip };
+
+    sf::FloatRect m_worldBounds{ GameSettings::referenceBounds() };
 };
 
 // ANIMATION SYSTEM - Updates all entity animations
 class AnimationSystem {
 public:
     void update(std::vector<Entity*>& entities, float deltaTime);
+
+private:
+    void syncAnimations(std::vector<Entity*>& entities);
+
+    // Enabled animations in the entity list, advanced in one pass over the
+    // store; re-synced only when the list changes
+    eol::AnimationStore m_animations;
+    EntityListTracker m_entities;
+    std::vector<std::uint8_t> m_seen;
 };
 
 // RENDER SYSTEM - Draws all entities to the screen
 class RenderSystem {
 public:
+    // World pass: only entities whose sprite overlaps the window's current
+    // view are drawn, in entity order
     void render(sf::RenderWindow& window, std::vector<Entity*>& entities);
 
+    // Screen-space pass (health bar); call with the unscrolled view set
+    void renderHud(sf::RenderWindow& window, Entity& player);
+
 private:
     void updateSpriteFromComponents(sf::Sprite& sprite, Entity& entity);
     void drawEnemyHealthBar(sf::RenderWindow& window, Entity& entity);
     void drawPlayerHealthBar(sf::RenderWindow& window, Entity& player);
+
+    struct Drawable {
+        Entity* entity;
+        const sf::Sprite* sprite;
+    };
+
+    // Sprites inside the view this frame, in entity order
+    std::vector<Drawable> m_drawables;
 };
 
 // COMBAT SYSTEM - Handles HP, resistances and hit reactions
@@ -85,35 +137,77 @@ private:
     Entity* findPlayer(const std::vector<Entity*>& entities) const;
 };
 
-// ENEMY AI SYSTEM - Decision tree behaviors
+// ENEMY AI SYSTEM - Decision tree behaviors with crowd steering
 class EnemyAISystem {
 public:
+    EnemyAISystem();
+
     void update(std::vector<Entity*>& entities, float deltaTime, Entity& player);
 
+    // Separation / alignment / obstacle avoidance for chase and patrol.
+    // When disabled enemies head straight for their target (legacy behaviour).
+    void setCrowdSteeringEnabled(bool enabled) noexcept;
+    bool isCrowdSteeringEnabled() const noexcept;
+
+    void setSeparationRadius(float radius) noexcept;
+    float getSeparationRadius() const noexcept;
+
+    // Area enemies are kept inside; defaults to the reference screen
+    void setWorldBounds(const sf::FloatRect& bounds) noexcept;
+
 private:
-    void driveBehavior(Entity& entity,
-                       eol::EnemyAIComponent& ai,
+    static constexpr std::size_t kNotSolid = static_cast<std::size_t>(-1);
+
+    // One enemy; index matches the agent grid. The position follows the
+    // agent as it moves, the velocity is the one it started the frame with.
+    struct Agent {
+        Entity* entity;
+        eol::EnemyAIComponent* ai;
+        eol::TransformComponent* transform;
+        eol::CollisionComponent* collision;
+        sf::Vector2f position;
+        sf::Vector2f velocity;
+        std::size_t solid;      // index into m_solidBounds, or kNotSolid
+    };
+
+    void buildNeighbourGrids(std::vector<Entity*>& entities, float deltaTime);
+    void driveBehavior(std::size_t agentIndex,
                        const sf::Vector2f& playerPos,
-                       float deltaTime,
-                       std::vector<Entity*>& entities);
-    void executePatrol(Entity& entity,
-                       eol::EnemyAIComponent& ai,
-                       float deltaTime,
-                       std::vector<Entity*>& entities);
-    void executeChase(Entity& entity,
-                      const eol::EnemyAIComponent& ai,
+                       float deltaTime);
+    void executePatrol(std::size_t agentIndex, float deltaTime);
+    void executeChase(std::size_t agentIndex,
                       const sf::Vector2f& playerPos,
-                      float deltaTime,
-                      std::vector<Entity*>& entities);
-    void executeAttack(Entity& entity);
+                      float deltaTime);
+    void executeAttack(Agent& agent);
+    sf::Vector2f computeSteering(std::size_t agentIndex,
+                                 const sf::Vector2f& desiredDirection,
+                                 float deltaTime) const;
+    sf::Vector2f computeAvoidance(const Agent& agent, const sf::Vector2f& heading) const;
+    void moveAgent(Agent& agent, const sf::Vector2f& velocity, float deltaTime);
+    bool collidesWithSolids(const sf::Vector2f& position,
+                            const sf::Vector2f& size,
+                            const Entity* self) const;
     bool hasLineOfSight(const sf::Vector2f& origin,
                         const sf::Vector2f& target,
-                        const std::vector<Entity*>& entities,
                         Entity* self,
                         Entity* targetEntity) const;
-    bool lineIntersectsRect(const sf::Vector2f& a,
-                            const sf::Vector2f& b,
-                            const sf::FloatRect& rect) const;
+
+private:
+    std::vector<Agent> m_agents;
+    std::vector<sf::FloatRect> m_agentBounds;
+    SpatialGrid m_agentGrid;
+
+    // m_solidBounds is kept current as solid agents move; the grid is built
+    // from m_solidReach, where each solid agent's box is grown by the
+    // furthest it can move this frame, so queries still find it
+    std::vector<Entity*> m_solidEntities;
+    std::vector<sf::FloatRect> m_solidBounds;
+    std::vector<sf::FloatRect> m_solidReach;
+    SpatialGrid m_solidGrid;
+
+    float m_separationRadius;
+    bool m_crowdSteering{ true };
+    sf::FloatRect m_worldBounds{ GameSettings::referenceBounds() };
 };
 
 
@@ -122,7 +216,7 @@ class LightSystem {
 public:
     explicit LightSystem(CombatSystem& combatSystem);
 
-    void update(std::vector<Entity*>& entities, float deltaTime, const sf::RenderWindow& window);
+    void update(std::vector<Entity*>& entities, float deltaTime);
     void render(sf::RenderTarget& target, std::vector<Entity*>& entities);
 
     void setAmbientLight(float ambient) noexcept;
@@ -131,25 +225,53 @@ public:
     void setDebugOverlayEnabled(bool enabled) noexcept;
     bool isDebugOverlayEnabled() const noexcept;
 
+    // Walls that cast light shadows; call whenever a level has been built
+    void setOccluders(const Map& map, float tileSize, const sf::Vector2f& offset);
+
+    // Live beam list for world snapshots
+    void saveState(SnapshotWriter& out) const;
+    void loadState(SnapshotReader& in);
+
 private:
-    struct BeamSegment {
-        sf::Vector2f start;
-        sf::Vector2f end;
-        sf::Color color;
-        float width;
-        float ttl;
-        float lifetime;
-        float intensity;
+
+    // Cached visibility fan of one light; rebuilt only when the light moves,
+    // changes radius, or the level's walls change
+    struct LightShadow {
+        sf::Vector2f origin;
+        float radius = 0.f;
+        std::uint32_t occluderVersion = 0;
+        std::uint32_t lastFrame = 0;
+        float shadedIntensity = -1.f;   // intensity the fan colours were set for
+        std::vector<float> falloff;     // per fan vertex: 1 at the light, 0 at radius
+        sf::VertexArray fan{sf::PrimitiveType::TriangleFan};
     };
 
-    void updateEmitters(std::vector<Entity*>& entities, float deltaTime, const sf::RenderWindow& window);
+    void updateEmitters(std::vector<Entity*>& entities, float deltaTime);
+    // Decay and tinting run as flat branch-free passes over m_lightFields;
+    // tints are only written back when they change
     void updateLightFields(std::vector<Entity*>& entities, float deltaTime);
+    void syncLightFields(std::vector<Entity*>& entities);
     void refreshBeamTimers(float deltaTime);
     void emitBeam(Entity& owner,
                   eol::LightEmitterComponent& emitter,
                   std::vector<Entity*>& entities,
                   const sf::Vector2f& origin,
                   const sf::Vector2f& direction);
+    // One straight run of a beam tree; flat mirrors continue it in place,
+    // splitters and prisms end it and queue two child rays
+    struct BeamRay {
+        sf::Vector2f origin;
+        sf::Vector2f direction;
+        float range;
+        float width;
+        float intensity;
+        float ttl;
+        std::uint32_t reflectionsLeft;
+    };
+
+    // Breadth-first over a bounded queue: children of one generation sit
+    // next to each other, near-duplicate rays are merged, and the segment
+    // and ray counts per emitter per frame are capped
     void castBeam(Entity& owner,
                   std::vector<Entity*>& entities,
                   const sf::Vector2f& origin,
@@ -160,38 +282,135 @@ private:
                   float intensity,
                   float ttl,
                   std::uint32_t reflectionsLeft);
-    bool rayIntersectsRect(const sf::Vector2f& origin,
-                           const sf::Vector2f& direction,
-                           float maxDistance,
-                           const sf::FloatRect& bounds,
-                           float& outDistance,
-                           sf::Vector2f& outNormal) const;
+    bool enqueueRay(const BeamRay& ray);
+    void traceRay(Entity& owner,
+                  std::vector<Entity*>& entities,
+                  const BeamRay& ray,
+                  sf::Color color,
+                  std::size_t& segmentBudget);
+    void collectBeamObstacles(Entity& owner, std::vector<Entity*>& entities);
+    void refreshBeamObstacle(std::size_t index, Entity& entity);
+    // One row of the mirror table. Rows are refreshed from their mirror and
+    // transform only when either one's version has moved on.
+    struct MirrorSegment {
+        Entity* entity = nullptr;
+        const eol::MirrorComponent* mirror = nullptr;
+        const eol::TransformComponent* transform = nullptr;
+        std::uint32_t mirrorVersion = 0;
+        std::uint32_t transformVersion = 0;
+        bool active = false;        // inactive rows are kept but not hit
+        sf::Vector2f center;
+        sf::Vector2f normal;
+        sf::Vector2f tangent;
+        sf::Vector2f halfExtents;   // along the tangent, along the normal
+        eol::MirrorComponent::MirrorType type = eol::MirrorComponent::MirrorType::Flat;
+        float loss = 0.f;           // reflection loss, clamped
+    };
+
+    void syncMirrorTable(std::vector<Entity*>& entities);
+    void refreshMirrorRow(MirrorSegment& row) const;
     bool rayIntersectsMirror(const sf::Vector2f& origin,
                              const sf::Vector2f& direction,
                              float maxDistance,
-                             Entity& mirrorEntity,
-                             float& outDistance,
-                             sf::Vector2f& outNormal) const;
+                             const MirrorSegment& mirror,
+                             float& outDistance) const;
     std::optional<sf::FloatRect> computeBounds(Entity& entity) const;
     std::optional<sf::FloatRect> computeMirrorBounds(Entity& entity) const;
     void handleBeamImpact(Entity& owner, Entity& target, float intensity, const sf::Vector2f& hitPoint);
     void applyPuzzleLight(Entity& source, Entity& entity, float intensity);
     sf::Vector2f reflect(const sf::Vector2f& direction, const sf::Vector2f& normal) const;
     void ensureOverlaySize(const sf::RenderTarget& target);
+    void updateBeamMesh();
     void drawBeams(sf::RenderTarget& target) const;
     void drawOverlay(sf::RenderTarget& target) const;
     void drawDebugData(sf::RenderTarget& target) const;
-    void drawLightGlows(sf::RenderTarget& target, std::vector<Entity*>& entities);
+    // Map-tied lights (nodes, beacons) are static; the player's is dynamic
+    enum class GlowSet { All, Static, Dynamic };
+    void drawLightGlows(sf::RenderTarget& target, std::vector<Entity*>& entities, GlowSet set = GlowSet::All);
     void drawLightBeacons(sf::RenderTarget& target, std::vector<Entity*>& entities);
+    bool updateLightmap(std::vector<Entity*>& entities);
+    void drawLightmap(sf::RenderTarget& target) const;
+    bool composeLightLayers(std::vector<Entity*>& entities);
+    void placeStaticRegion();
+    bool staticRegionCovers(const sf::FloatRect& view) const;
+    void collectStaticSignature(std::vector<Entity*>& entities, std::vector<float>& out);
+    void rebuildShadow(LightShadow& shadow, const sf::Vector2f& origin, float radius);
+    std::optional<sf::Vector2f> computeLightCenter(Entity& entity) const;
 
 private:
-    std::vector<BeamSegment> m_beamSegments;
+    BeamStore m_beams;
+
+    // castBeam work queue and coalescing keys, reused across emitters.
+    // Entries before m_rayNext have been traced.
+    std::vector<BeamRay> m_rayQueue;
+    std::vector<std::uint64_t> m_rayKeys;
+    std::size_t m_rayNext = 0;
+
+    // Obstacles for the emitter being cast: box i belongs to entities[i].
+    // Active mirrors are tested through the mirror table instead; they, the
+    // owner and (for non-enemy owners) the player are empty boxes.
+    geometry::BoxBatch m_beamBoxes;
+
+    // Every mirror in the entity list, in entity order. Rebuilt only when
+    // the list changes; a moved, turned or toggled mirror refreshes its row.
+    std::vector<MirrorSegment> m_mirrorTable;
+    EntityListTracker m_mirrorEntities;
+
+    // m_beams' mesh is uploaded to a stream VertexBuffer when the driver
+    // has them, otherwise drawn from the store's array directly
+    sf::VertexBuffer m_beamBuffer{sf::PrimitiveType::Triangles, sf::VertexBuffer::Usage::Stream};
+    std::size_t m_beamBufferCapacity = 0;
+    std::size_t m_beamBufferCount = 0;
+    bool m_beamBufferChecked = false;
+    bool m_beamBufferAvailable = false;
+
+    // Lights with a render component in the entity list, attached to the
+    // packed store; re-synced only when the list changes
+    eol::LightFieldStore m_lightFields;
+    EntityListTracker m_lightFieldEntities;
+    std::vector<std::uint8_t> m_lightFieldSeen;
+    std::vector<sf::Color> m_lightTints;
+
+    // World area under the target's view this frame; lights, shafts and
+    // beams outside it are skipped and the off-screen layers follow it
+    sf::FloatRect m_viewRect{ GameSettings::referenceBounds() };
+    // Area being drawn: the view, or the static layer's region while that
+    // layer is redrawn
+    sf::FloatRect m_cullRect{ GameSettings::referenceBounds() };
+    bool isOnScreen(const sf::FloatRect& bounds) const;
+
     sf::RectangleShape m_darknessOverlay;
     bool m_debugOverlay;
     float m_ambientLight;
     std::vector<sf::FloatRect> m_debugMirrorBounds;
     std::vector<sf::Vector2f> m_debugHitPoints;
     CombatSystem& m_combat;
+
+    // Lightmap: ambient darkness plus one shadowed fan per light, multiplied
+    // over the scene in place of the flat darkness overlay
+    ShadowCaster m_shadowCaster;
+    std::unordered_map<const Entity*, LightShadow> m_shadows;
+    std::vector<sf::Vector2f> m_visibilityScratch;
+    sf::RenderTexture m_lightmap;
+    bool m_lightmapReady = false;
+    bool m_lightmapUnavailable = false;
+    std::uint32_t m_lightFrame = 0;
+
+    // Glows, beacon shafts and beams are built off-screen and added to the
+    // target in one full-screen draw. The static layer covers the view plus
+    // a margin (m_staticRegion) and is only redrawn when its signature
+    // (beacon state and placement, map light glows) changes or the view
+    // leaves that region.
+    sf::RenderTexture m_staticLayer;
+    sf::RenderTexture m_compositeLayer;
+    std::vector<float> m_staticSignature;
+    std::vector<float> m_signatureScratch;
+    bool m_layersReady = false;
+    bool m_layersUnavailable = false;
+    bool m_staticLayerDirty = true;
+    sf::FloatRect m_staticRegion;
+    float m_tileSize = 0.f;
+    sf::Vector2f m_tileOffset{ 0.f, 0.f };
 };
 
 
@@ -0,0 +1,44 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+
+// The window's views, owned by Application.
+//
+// The letterboxed reference view (GameSettings::getScaledView) depends only
+// on the window size, so it is rebuilt on resize or resolution change and
+// handed out by reference every frame. The world view is that view moved to
+// the camera centre; it and the pixel -> world transform used for the mouse
+// aim are only rebuilt when the centre or the window changes.
+class ViewManager
+{
+public:
+    ViewManager();
+
+    // No-op when the size is unchanged
+    void setWindowSize(const sf::Vector2u& size);
+    // No-op when the centre is unchanged
+    void setWorldCenter(const sf::Vector2f& center);
+
+    // Menus, HUD and dialog: reference pixels, never scrolls
+    const sf::View& getScaledView() const noexcept { return scaledView; }
+    // Level layers: the scaled view at the camera centre
+    const sf::View& getWorldView() const noexcept { return worldView; }
+
+    // Same result as RenderTarget::mapPixelToCoords with the world view
+    const sf::Transform& getPixelToWorld() const noexcept { return pixelToWorld; }
+    sf::Vector2f mapPixelToWorld(const sf::Vector2i& pixel) const
+    {
+        return pixelToWorld.transformPoint(sf::Vector2f(pixel));
+    }
+
+private:
+    void updateWorldView();
+
+    sf::Vector2u windowSize{ 0u, 0u };
+    sf::Vector2f worldCenter;
+
+    sf::View scaledView;
+    sf::View worldView;
+    // Pixel -> scaled view; only a step towards pixelToWorld
+    sf::Transform pixelToReference;
+    sf::Transform pixelToWorld;
+};
@@ -0,0 +1,116 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+struct Entity;
+
+// Appends raw field values to a flat byte buffer.
+// Entity pointers are stored as indices into the entity list being saved.
+class SnapshotWriter
+{
+public:
+    SnapshotWriter(std::vector<std::uint8_t>& buffer, const std::vector<Entity*>& entities)
+        : buffer(buffer), entities(entities)
+    {
+    }
+
+    template <typename T>
+    void write(const T& value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "snapshot fields must be plain data");
+        const std::size_t offset = buffer.size();
+        buffer.resize(offset + sizeof(T));
+        std::memcpy(buffer.data() + offset, &value, sizeof(T));
+    }
+
+    void writeString(const std::string& value);
+
+    // Null and entities outside the saved list are both stored as "none"
+    void writeEntity(const Entity* entity);
+
+    // Length-prefixes everything written between the two calls, so a reader
+    // can check or step over the block without knowing what is inside
+    std::size_t beginBlock();
+    void endBlock(std::size_t start);
+
+private:
+    std::vector<std::uint8_t>& buffer;
+    const std::vector<Entity*>& entities;
+};
+
+// Reads back what SnapshotWriter produced, in the same order.
+// Overruns don't throw; they zero the value and mark the reader failed.
+class SnapshotReader
+{
+public:
+    SnapshotReader(const std::vector<std::uint8_t>& buffer, const std::vector<Entity*>& entities)
+        : buffer(buffer), entities(entities)
+    {
+    }
+
+    template <typename T>
+    void read(T& value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "snapshot fields must be plain data");
+        if (failed || buffer.size() - offset < sizeof(T))
+        {
+            failed = true;
+            value = T{};
+            return;
+        }
+        std::memcpy(&value, buffer.data() + offset, sizeof(T));
+        offset += sizeof(T);
+    }
+
+    template <typename T>
+    T read()
+    {
+        T value{};
+        read(value);
+        return value;
+    }
+
+    void readString(std::string& value);
+    Entity* readEntity();
+
+    // Steps over a block written by beginBlock/endBlock
+    void skipBlock();
+    // Reads a block in place: enterBlock returns where it ends, leaveBlock
+    // moves there and returns false if the contents were not read exactly
+    std::size_t enterBlock();
+    bool leaveBlock(std::size_t end);
+
+    bool hasFailed() const noexcept { return failed; }
+    bool atEnd() const noexcept { return offset == buffer.size(); }
+
+private:
+    const std::vector<std::uint8_t>& buffer;
+    const std::vector<Entity*>& entities;
+    std::size_t offset = 0;
+    bool failed = false;
+};
+
+// A saved copy of the world as one contiguous buffer (see Game::saveSnapshot).
+// Keep the object around and re-save into it: the buffer keeps its capacity,
+// so taking snapshots every frame doesn't allocate.
+// Files are raw native-endian memory and are only meant to be read back by
+// the same build.
+class WorldSnapshot
+{
+public:
+    std::vector<std::uint8_t>& getData() noexcept { return data; }
+    const std::vector<std::uint8_t>& getData() const noexcept { return data; }
+
+    bool empty() const noexcept { return data.empty(); }
+    void clear() noexcept { data.clear(); }
+
+    bool saveToFile(const std::string& path) const;
+    bool loadFromFile(const std::string& path);
+
+private:
+    std::vector<std::uint8_t> data;
+};
@@ -1,49 +1,43 @@
 #include "components/Component.h"
+#include "components/AnimationLibrary.h"
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/Rect.hpp>
 #include <string>
-#include <map>
 
 namespace eol {
 
-    // Represents a single animation (e.g., "idle", "walk", "attack")
-    struct Animation {
-        std::string name;
-        const sf::Texture* texture;  // Pointer to the sprite sheet
-        int frameCount;              // Number of frames in this animation
-        int frameWidth;              // Width of each frame in pixels
-        int frameHeight;             // Height of each frame in pixels
-        float frameDuration;         // Time per frame in seconds
-        bool loop;                   // Should the animation loop?
-
-        Animation()
-            : texture(nullptr)
-            , frameCount(0)
-            , frameWidth(0)
-            , frameHeight(0)
-            , frameDuration(0.15f)
-            , loop(true) {
-        }
-    };
+    class AnimationStore;
 
+    // Plays one clip from the AnimationLibrary; only the handle and the
+    // playback position live here. While an AnimationSystem is advancing it,
+    // the playback position lives in its AnimationStore and the accessors
+    // read and write through to that row.
     class AnimationComponent : public Component {
     public:
         AnimationComponent();
+        // Copies are never attached to a store
+        AnimationComponent(const AnimationComponent& other);
+        AnimationComponent& operator=(const AnimationComponent&) = delete;
+        ~AnimationComponent() override;
 
-        // Add an animation to this component
-        void addAnimation(const std::string& name, const Animation& anim);
+        ComponentPtr clone() const override;
 
-        // Set the current animation (e.g., "idle" -> "walk")
-        void setAnimation(const std::string& name);
+        void saveState(SnapshotWriter& out) const override;
+        void loadState(SnapshotReader& in) override;
+
+        // Switch clips (e.g. idle -> walk); playing the current clip again is a no-op
+        void setClip(ClipHandle clip) noexcept;
+        ClipHandle getClip() const noexcept;
 
-        // Get current animation name
-        const std::string& getCurrentAnimationName() const noexcept;
+        // Looks the clip up by name; for setup code, not per-frame use
+        void setAnimation(const std::string& name);
 
-        // Update animation (called by AnimationSystem each frame)
-        void update(float deltaTime);
+        int getCurrentFrame() const noexcept;
+        float getElapsedTime() const noexcept;
 
-        // Get the current frame's texture rectangle
-        sf::IntRect getCurrentFrameRect() const;
+        // Texture rectangle of the current frame, kept up to date whenever
+        // the clip or frame changes so the renderer only copies it
+        const sf::IntRect& getCurrentFrameRect() const noexcept;
 
         // Get current animation's texture
         const sf::Texture* getCurrentTexture() const;
@@ -55,12 +49,19 @@ namespace eol {
         void reset();
 
     private:
-        std::map<std::string, Animation> m_animations;
-        std::string m_currentAnimation;
+        friend class AnimationStore;
+
+        void setPlayback(int frame, float elapsed, bool finished) noexcept;
+        void refreshFrameRect() noexcept;
 
+        ClipHandle m_clip{ InvalidClip };
         int m_currentFrame{ 0 };
         float m_elapsedTime{ 0.f };
         bool m_finished{ false };
+        sf::IntRect m_frameRect;
+
+        AnimationStore* m_store{ nullptr };
+        std::uint32_t m_storeSlot{ 0 };
     };
 
-} // namespace eol
\ No newline at end of file
+} // namespace eol
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <SFML/Graphics/Texture.hpp>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace eol {
+
+    // Represents a single animation (e.g., "idle", "walk", "attack")
+    struct Animation {
+        std::string name;
+        const sf::Texture* texture;  // Pointer to the sprite sheet
+        int frameCount;              // Number of frames in this animation
+        int frameWidth;              // Width of each frame in pixels
+        int frameHeight;             // Height of each frame in pixels
+        float frameDuration;         // Time per frame in seconds
+        bool loop;                   // Should the animation loop?
+
+        Animation()
+            : texture(nullptr)
+            , frameCount(0)
+            , frameWidth(0)
+            , frameHeight(0)
+            , frameDuration(0.15f)
+            , loop(true) {
+        }
+    };
+
+    using ClipHandle = std::uint16_t;
+    constexpr ClipHandle InvalidClip = 0xFFFF;
+
+    // Process-wide table of animation clips. Clips are defined once (at
+    // resource load) and referenced by small integer handles, so every entity
+    // playing a clip shares its data and switching clips is an integer store.
+    // Handles stay valid for the life of the process; re-adding a clip under
+    // an existing name replaces its data and keeps its handle.
+    class AnimationLibrary {
+    public:
+        static AnimationLibrary& instance();
+
+        ClipHandle add(const Animation& clip);
+
+        // InvalidClip if no clip has that name
+        ClipHandle find(const std::string& name) const;
+
+        // nullptr for InvalidClip or an unknown handle
+        const Animation* get(ClipHandle handle) const noexcept {
+            return handle < m_clips.size() ? &m_clips[handle] : nullptr;
+        }
+
+        std::size_t size() const noexcept { return m_clips.size(); }
+
+    private:
+        AnimationLibrary() = default;
+
+        std::vector<Animation> m_clips;
+        std::unordered_map<std::string, ClipHandle> m_byName;
+    };
+
+} // namespace eol
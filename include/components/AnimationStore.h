@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace eol {
+
+    class AnimationComponent;
+
+    // Playback state of the animations an AnimationSystem is advancing,
+    // next to their clips' timing, kept in packed columns from frame to
+    // frame. While an animation is attached its frame, elapsed time and
+    // finished flag live in its row: the component keeps the row index and
+    // reads and writes through to it. Clip timing is copied in when the
+    // animation is attached or switches clip. Detaching, destroying the
+    // component or destroying the store copies the playback state back.
+    class AnimationStore {
+    public:
+        AnimationStore() = default;
+        ~AnimationStore();
+
+        AnimationStore(const AnimationStore&) = delete;
+        AnimationStore& operator=(const AnimationStore&) = delete;
+
+        void attach(AnimationComponent& animation);
+        // The last row moves into the freed one
+        void detach(AnimationComponent& animation);
+        void clear();
+
+        std::size_t size() const noexcept { return animations.size(); }
+        bool holds(const AnimationComponent& animation) const noexcept;
+        // Row of an attached animation
+        std::size_t slotOf(const AnimationComponent& animation) const noexcept;
+
+        // Re-reads the clip timing of a row after its clip changed
+        void loadClip(std::size_t slot);
+        // Rebuilds the frame rects of the rows whose frame has moved on
+        void refreshFrameRects();
+
+        std::vector<AnimationComponent*> animations;
+        std::vector<int> frame;
+        std::vector<float> elapsed;
+        std::vector<std::uint8_t> finished;
+        std::vector<int> shownFrame;            // frame the component's rect is for
+        std::vector<int> frameCount;
+        std::vector<float> frameDuration;
+        std::vector<std::uint8_t> loop;
+        std::vector<std::uint8_t> running;      // 0: no playable clip, left as is
+    };
+
+} // namespace eol
@@ -10,6 +10,11 @@ class CollisionComponent : public Component {
 public:
     CollisionComponent();
 
+    ComponentPtr clone() const override;
+
+    void saveState(SnapshotWriter& out) const override;
+    void loadState(SnapshotReader& in) override;
+
     void setBoundingBox(const sf::Vector2f& size) noexcept;
     const sf::Vector2f& getBoundingBox() const noexcept;
 
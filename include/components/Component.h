@@ -1,8 +1,12 @@
 #pragma once
 
+#include <cstddef>
 #include <memory>
 #include <string>
 
+class SnapshotWriter;
+class SnapshotReader;
+
 namespace eol {
 
 class Component {
@@ -10,10 +14,22 @@ public:
     explicit Component(std::string name);
     virtual ~Component() = default;
 
+    // Components live in ComponentPool (see ComponentPool.h)
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr, std::size_t size) noexcept;
+
+    // Deep copy of the concrete component; used by PrefabLibrary
+    virtual std::unique_ptr<Component> clone() const = 0;
+
     const std::string& getName() const noexcept;
     bool isEnabled() const noexcept;
     void setEnabled(bool enabled) noexcept;
 
+    // World snapshots (see WorldSnapshot.h). Overrides call the base first
+    // and then write/read their own fields in a fixed order.
+    virtual void saveState(SnapshotWriter& out) const;
+    virtual void loadState(SnapshotReader& in);
+
 private:
     std::string m_name;
     bool m_enabled{true};
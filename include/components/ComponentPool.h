@@ -0,0 +1,51 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace eol {
+
+// Size-class free-list allocator behind Component::operator new.
+// Components are small and are created in bursts (level builds, spawns,
+// prefab instancing), so they are carved out of large blocks instead of
+// taking one heap allocation each. Freed slots are reused by the next
+// component of the same size class; blocks are kept until exit.
+class ComponentPool {
+public:
+    static ComponentPool& instance();
+
+    void* allocate(std::size_t size);
+    void deallocate(void* ptr, std::size_t size) noexcept;
+
+    std::size_t getBlockCount() const;
+
+    // Components freed so far; caches of component pointers compare it to
+    // know whether any of them may have gone away
+    std::uint64_t getReleaseCount() const noexcept { return m_releases.load(std::memory_order_relaxed); }
+
+private:
+    ComponentPool() = default;
+
+    static constexpr std::size_t kGranularity = 16;
+    static constexpr std::size_t kMaxPooledSize = 1024;
+    static constexpr std::size_t kClassCount = kMaxPooledSize / kGranularity;
+    static constexpr std::size_t kBlockSize = 64 * 1024;
+
+    struct FreeNode {
+        FreeNode* next;
+    };
+
+    std::array<FreeNode*, kClassCount> m_freeLists{};
+    std::vector<std::unique_ptr<unsigned char[]>> m_blocks;
+    unsigned char* m_cursor{nullptr};
+    std::size_t m_remaining{0};
+    mutable std::mutex m_mutex;
+    std::atomic<std::uint64_t> m_releases{0};
+};
+
+} // namespace eol
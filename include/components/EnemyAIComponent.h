@@ -17,6 +17,11 @@ public:
 
     EnemyAIComponent();
 
+    ComponentPtr clone() const override;
+
+    void saveState(SnapshotWriter& out) const override;
+    void loadState(SnapshotReader& in) override;
+
     void setPatrolPoints(std::vector<sf::Vector2f> points);
     const std::vector<sf::Vector2f>& getPatrolPoints() const noexcept;
     std::size_t getCurrentPatrolIndex() const noexcept;
@@ -31,6 +36,10 @@ public:
     void setMoveSpeed(float speed) noexcept;
     float getMoveSpeed() const noexcept;
 
+    // Last steering velocity, read by neighbours for crowd alignment
+    void setVelocity(const sf::Vector2f& velocity) noexcept;
+    const sf::Vector2f& getVelocity() const noexcept;
+
     void setState(BehaviorState state) noexcept;
     BehaviorState getState() const noexcept;
     void setActive(bool active) noexcept;
@@ -42,6 +51,7 @@ private:
     float m_detectionRange{220.f};
     float m_attackRange{60.f};
     float m_moveSpeed{85.f};
+    sf::Vector2f m_velocity{};
     BehaviorState m_state{BehaviorState::Patrol};
     bool m_active{true};
 };
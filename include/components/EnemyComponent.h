@@ -8,6 +8,11 @@ class EnemyComponent : public Component {
 public:
     EnemyComponent();
 
+    ComponentPtr clone() const override;
+
+    void saveState(SnapshotWriter& out) const override;
+    void loadState(SnapshotReader& in) override;
+
     float getResistance() const noexcept;
     void setResistance(float resistance) noexcept;
 
@@ -10,6 +10,11 @@ class HitboxComponent : public Component {
 public:
     HitboxComponent();
 
+    ComponentPtr clone() const override;
+
+    void saveState(SnapshotWriter& out) const override;
+    void loadState(SnapshotReader& in) override;
+
     void setSize(const sf::Vector2f& size) noexcept;
     const sf::Vector2f& getSize() const noexcept;
 
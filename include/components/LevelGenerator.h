@@ -0,0 +1,32 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class Map;
+
+// Knobs for one generated level. Counts are capped by the floor space left
+// after walls are placed.
+struct LevelGenSettings {
+    int width = 64;
+    int height = 36;
+    std::uint32_t seed = 1;
+    float wallDensity = 0.18f;   // share of interior tiles turned into wall
+    int beacons = 2;             // BEACON_1 .. BEACON_n, at most 4
+    int lightSources = 4;
+    int mirrors = 8;
+    int spawners = 2;
+};
+
+// Seeded level generator for stress content. Emits rows in the tile
+// alphabet Map::loadFromFile reads. Every level is walled in and has one
+// start, placed in the largest open area, and one exit on the floor tile
+// furthest from it. Pockets cut off from the start are filled in, so every
+// object is reachable. The same settings give the same level everywhere.
+class LevelGenerator {
+public:
+    static std::vector<std::string> generate(const LevelGenSettings& settings);
+    static void generate(const LevelGenSettings& settings, Map& out);
+
+    static bool writeToFile(const std::vector<std::string>& rows, const std::string& filename);
+};
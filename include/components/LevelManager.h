@@ -19,6 +19,9 @@ public:
 
     bool loadLevel(const std::string& levelName);
     bool loadCurrentLevel();
+    // Switches to the level at idx; the current level and index are left
+    // untouched if it cannot be loaded
+    bool loadLevelAt(int idx);
     void nextLevel();
 
     bool isLevelComplete() const;
@@ -2,11 +2,28 @@
 
 #include "components/Component.h"
 
+#include <cstdint>
+#include <vector>
+
 namespace eol {
 
+class LightFieldStore;
+
+// While a LightSystem is updating the light, intensity, decay settings and
+// boost timer live in its LightFieldStore; the accessors read and write
+// through to that row.
 class LightComponent : public Component {
 public:
     LightComponent();
+    // Copies are never attached to a store
+    LightComponent(const LightComponent& other);
+    LightComponent& operator=(const LightComponent&) = delete;
+    ~LightComponent() override;
+
+    ComponentPtr clone() const override;
+
+    void saveState(SnapshotWriter& out) const override;
+    void loadState(SnapshotReader& in) override;
 
     void setRadius(float radius) noexcept;
     float getRadius() const noexcept;
@@ -31,6 +48,12 @@ public:
     bool isWeaponized() const noexcept;
 
 private:
+    friend class LightFieldStore;
+
+    // The store's column when attached, otherwise the member
+    float& field(float& own, std::vector<float> LightFieldStore::*column) noexcept;
+    float field(float own, std::vector<float> LightFieldStore::*column) const noexcept;
+
     float m_radius{160.f};
     float m_intensity{1.f};
     float m_baseIntensity{1.f};
@@ -38,6 +61,9 @@ private:
     float m_decayDelay{0.35f};
     float m_timeSinceBoost{10.f};
     bool m_weaponized{false};
+
+    LightFieldStore* m_fields{nullptr};
+    std::uint32_t m_fieldSlot{0};
 };
 
 } // namespace eol
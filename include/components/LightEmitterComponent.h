@@ -11,6 +11,11 @@ class LightEmitterComponent : public Component {
 public:
     LightEmitterComponent();
 
+    ComponentPtr clone() const override;
+
+    void saveState(SnapshotWriter& out) const override;
+    void loadState(SnapshotReader& in) override;
+
     void setDirection(const sf::Vector2f& direction) noexcept;
     const sf::Vector2f& getDirection() const noexcept;
 
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <SFML/Graphics/Color.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace eol {
+
+class LightComponent;
+class RenderComponent;
+
+// Light-field state (intensity, decay settings, boost timer) of the lights a
+// LightSystem is updating, kept in packed columns from frame to frame so the
+// decay and tint passes run straight over them. While a light is attached
+// its fields live in its row: the component keeps the row index and reads
+// and writes through to it. Detaching, destroying the component or
+// destroying the store copies the fields back, so rows only come and go
+// when lights are attached or detached.
+class LightFieldStore {
+public:
+    LightFieldStore() = default;
+    ~LightFieldStore();
+
+    LightFieldStore(const LightFieldStore&) = delete;
+    LightFieldStore& operator=(const LightFieldStore&) = delete;
+
+    void attach(LightComponent& light, RenderComponent& render);
+    // The last row moves into the freed one
+    void detach(LightComponent& light);
+    void clear();
+
+    std::size_t size() const noexcept { return lights.size(); }
+    bool holds(const LightComponent& light) const noexcept;
+    // Row of an attached light
+    std::size_t slotOf(const LightComponent& light) const noexcept;
+
+    std::vector<LightComponent*> lights;
+    std::vector<RenderComponent*> renders;
+    std::vector<float> intensity;
+    std::vector<float> base;
+    std::vector<float> decayRate;
+    std::vector<float> delay;
+    std::vector<float> timer;           // seconds since the last boost
+};
+
+} // namespace eol
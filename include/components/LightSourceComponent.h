@@ -8,6 +8,11 @@ class LightSourceComponent : public Component {
 public:
     LightSourceComponent();
 
+    ComponentPtr clone() const override;
+
+    void saveState(SnapshotWriter& out) const override;
+    void loadState(SnapshotReader& in) override;
+
     bool isMovable() const noexcept;
     void setMovable(bool movable) noexcept;
 
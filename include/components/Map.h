@@ -21,6 +21,8 @@ class Map {
 public:
     Map() = default;
     bool loadFromFile(const std::string& filename);
+    // Same text format, one string per row (e.g. from LevelGenerator)
+    void loadFromLines(const std::vector<std::string>& lines);
     TileType getTile(int x, int y) const;
     int getWidth() const { return width; }
     int getHeight() const { return height; }
@@ -33,10 +35,22 @@ public:
         const sf::Texture& startTex,
         const sf::Texture& endTex,
         const sf::Texture& emptyTex);
+    // Draws the tiles that fall inside the window's current view
     void draw(sf::RenderWindow& window, float tileSize, sf::Vector2f offset = { 0.f, 0.f }) const;
 
     void setWallTexture(const sf::Texture& tex) { wallTexture = &tex; }
 
+    // Wall tiles greedily merged into non-overlapping rectangles (in tiles):
+    // each rect takes the longest free run in its row, then grows down while
+    // the rows below are wall across the same span
+    std::vector<sf::IntRect> buildWallRects() const;
+    // Same, limited to an area of the map; no rect crosses its edge
+    std::vector<sf::IntRect> buildWallRects(const sf::IntRect& area) const;
+
+    // Texture drawn for a tile type, or nullptr with the colour to fill
+    // the tile with instead
+    const sf::Texture* getTileTexture(TileType tile, sf::Color& fallbackColor) const;
+
     // Collision helpers
     bool isWalkableTile(TileType t) const;
     bool isWalkableTileCoord(int tx, int ty) const;
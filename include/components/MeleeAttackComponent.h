@@ -8,6 +8,11 @@ class MeleeAttackComponent : public Component {
 public:
     MeleeAttackComponent();
 
+    ComponentPtr clone() const override;
+
+    void saveState(SnapshotWriter& out) const override;
+    void loadState(SnapshotReader& in) override;
+
     void setDamage(float damage) noexcept;
     float getDamage() const noexcept;
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <SFML/Graphics.hpp>
+#include <cstdint>
 
 #include "components/Component.h"
 
@@ -16,6 +17,11 @@ public:
 
     MirrorComponent();
 
+    ComponentPtr clone() const override;
+
+    void saveState(SnapshotWriter& out) const override;
+    void loadState(SnapshotReader& in) override;
+
     void setNormal(const sf::Vector2f& normal) noexcept;
     const sf::Vector2f& getNormal() const noexcept;
 
@@ -34,6 +40,9 @@ public:
     void setPickable(bool pickable) noexcept;
     bool isPickable() const noexcept;
 
+    // Bumped whenever the shape, type, loss or active state changes
+    std::uint32_t getVersion() const noexcept;
+
 private:
     sf::Vector2f m_normal;
     sf::Vector2f m_size;
@@ -42,6 +51,7 @@ private:
     bool m_active;
 
     bool m_pickable{ true };
+    std::uint32_t m_version{ 0 };
 };
 
 } // namespace eol
@@ -12,6 +12,11 @@ class PlayerComponent : public Component {
 public:
     PlayerComponent();
 
+    ComponentPtr clone() const override;
+
+    void saveState(SnapshotWriter& out) const override;
+    void loadState(SnapshotReader& in) override;
+
     float getMovementSpeed() const noexcept;
     void setMovementSpeed(float speed) noexcept;
 
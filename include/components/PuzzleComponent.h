@@ -18,6 +18,11 @@ public:
 
     PuzzleComponent();
 
+    ComponentPtr clone() const override;
+
+    void saveState(SnapshotWriter& out) const override;
+    void loadState(SnapshotReader& in) override;
+
     unsigned int getRequiredLight() const noexcept;
     void setRequiredLight(unsigned int requiredLight) noexcept;
 
@@ -14,6 +14,16 @@ class RenderComponent : public Component {
 public:
     RenderComponent();
 
+    // Copies keep the source's texture binding, except that a sprite still on
+    // the source's placeholder is rebound to this component's own placeholder
+    RenderComponent(const RenderComponent& other);
+    RenderComponent& operator=(const RenderComponent&) = delete;
+
+    ComponentPtr clone() const override;
+
+    void saveState(SnapshotWriter& out) const override;
+    void loadState(SnapshotReader& in) override;
+
     void setTextureId(std::string textureId);
     const std::string& getTextureId() const noexcept;
 
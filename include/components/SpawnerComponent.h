@@ -9,6 +9,11 @@ namespace eol {
     public:
         SpawnerComponent();
 
+        ComponentPtr clone() const override;
+
+        void saveState(SnapshotWriter& out) const override;
+        void loadState(SnapshotReader& in) override;
+
         // Spawn interval in seconds
         void setSpawnInterval(float interval) noexcept;
         float getSpawnInterval() const noexcept;
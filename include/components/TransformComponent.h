@@ -3,12 +3,18 @@
 #include "components/Component.h"
 
 #include <SFML/System/Vector2.hpp>
+#include <cstdint>
 
 namespace eol {
 
 class TransformComponent : public Component {
 public:
     TransformComponent();
+
+    ComponentPtr clone() const override;
+
+    void saveState(SnapshotWriter& out) const override;
+    void loadState(SnapshotReader& in) override;
     TransformComponent(const sf::Vector2f& position,
                        const sf::Vector2f& scale,
                        float rotation);
@@ -22,10 +28,14 @@ public:
     float getRotation() const noexcept;
     void setRotation(float rotation) noexcept;
 
+    // Bumped by every setter, so caches can tell the transform has moved
+    std::uint32_t getVersion() const noexcept;
+
 private:
     sf::Vector2f m_position{};
     sf::Vector2f m_scale{1.f, 1.f};
     float m_rotation{0.f};
+    std::uint32_t m_version{0};
 };
 
 } // namespace eol
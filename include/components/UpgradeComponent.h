@@ -11,6 +11,11 @@ class UpgradeComponent : public Component {
 public:
     UpgradeComponent();
 
+    ComponentPtr clone() const override;
+
+    void saveState(SnapshotWriter& out) const override;
+    void loadState(SnapshotReader& in) override;
+
     void setAvailableUpgrades(std::vector<std::string> upgrades);
     const std::vector<std::string>& getAvailableUpgrades() const noexcept;
 
@@ -4,6 +4,8 @@
 #include "Application.h"
 #include "Game.h"   
 #include "GameSettings.h"
+#include "InputRecording.h"
+#include "ReplaySession.h"
 
 
 
@@ -12,9 +14,16 @@ class GameplayScene : public Scene
 public:
     GameplayScene(Application& app);
 
+    // Plays back a recording instead of reading live input
+    GameplayScene(Application& app, std::shared_ptr<ReplaySession> replay);
+
+    // Background resource loading, driven by a LoadingScene
+    void queueResources(ResourceLoader& loader) { game.queueResources(loader); }
+    bool finishResources(const ResourceLoader& loader) { return game.finishResources(loader); }
+
     // Lifecycle
     void onEnter() override;
-    void onExit() override {}
+    void onExit() override;
 
     // Scene interface
     void handleEvent(const sf::Event& event) override;
@@ -25,6 +34,10 @@ public:
     bool blocksUpdate() const override { return true; }
     bool isTransparent() const override { return false; }
 
+private:
+    // F5 quick save, F9 quick load, F4 restart level
+    void handleSnapshotKey(sf::Keyboard::Key key);
+
 private:
     Application& app;
 
@@ -32,4 +45,14 @@ private:
     Game game;
 
     bool initialized = false;
+
+    // Capture of this session when a record path was given on the command line
+    InputRecorder recorder;
+
+    // Last quick save (also written to disk)
+    WorldSnapshot quickSave;
+
+    // Windowed replay (null when playing live)
+    std::shared_ptr<ReplaySession> replay;
+    bool replayReported = false;
 };
@@ -0,0 +1,41 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include "Scene.h"
+#include "Application.h"
+#include "ResourceLoader.h"
+
+class GameplayScene;
+
+// Shown while a gameplay scene's textures and font load in the background.
+// Decoding runs on the loader's workers; each frame this scene uploads a
+// few finished images and draws a progress bar, then swaps itself for the
+// gameplay scene once everything is in.
+class LoadingScene : public Scene
+{
+public:
+    LoadingScene(Application& app, std::shared_ptr<GameplayScene> next);
+
+    // Lifecycle
+    void onEnter() override;
+    void onExit() override {}
+
+    // Scene interface
+    void handleEvent(const sf::Event& event) override;
+    void update(float dt) override;
+    void render(sf::RenderWindow& window) override;
+
+    bool blocksUpdate() const override { return true; }
+    bool isTransparent() const override { return false; }
+
+private:
+    Application& app;
+
+    // Declared before the loader so the loader's workers are joined first
+    std::shared_ptr<GameplayScene> next;
+    ResourceLoader loader;
+
+    sf::Clock clock;
+    float shownProgress = 0.f;
+    bool handedOver = false;
+};
@@ -3,6 +3,7 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <optional>
 #include "Scene.h"
 #include "Application.h" 
 #include "GameSettings.h"
@@ -13,7 +14,8 @@ public:
     MainMenuScene(Application& app);
 
     // Lifecycle
-    void onEnter() override {}
+    void preload(SceneResources& resources) override;
+    void onEnter() override;
     void onExit() override {}
 
     // Scene interface
@@ -31,7 +33,8 @@ private:
 
 private:
     Application& app;
-    sf::Font font;
+    // Built in preload from the shared UI font
+    std::optional<sf::Text> title;
     std::vector<sf::Text> buttons;
     int selectedIndex = 0;
 };
@@ -14,7 +14,8 @@ public:
     OptionsMenuScene(Application& app);
 
     // Lifecycle
-    void onEnter() override {}
+    void preload(SceneResources& resources) override;
+    void onEnter() override;
     void onExit() override {}
 
     // Scene interface
@@ -34,7 +35,8 @@ private:
 private:
     Application& app;
 
-    sf::Font font;
+    // Built in preload from the shared UI font. The instance is cached, so
+    // the chosen resolution and framerate survive leaving the menu.
     std::vector<sf::Text> buttons;
 
     int selectedIndex = 0;
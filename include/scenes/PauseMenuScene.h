@@ -2,6 +2,7 @@
 #include <SFML/Graphics.hpp>
 #include <vector>
 #include <memory>
+#include <optional>
 #include "Scene.h"
 #include "Application.h"
 #include "GameSettings.h"
@@ -12,7 +13,8 @@ public:
     PauseMenuScene(Application& app);
 
     // Lifecycle
-    void onEnter() override {}
+    void preload(SceneResources& resources) override;
+    void onEnter() override;
     void onExit() override {}
 
     // Scene interface
@@ -32,7 +34,9 @@ private:
 private:
     Application& app;
 
-    sf::Font font;
+    // Built in preload, so pausing allocates nothing and reads no files
+    std::optional<sf::Text> title;
     std::vector<sf::Text> buttons;
+    sf::RectangleShape overlay;
     int selectedIndex = 0;
 };
@@ -1,10 +1,16 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 
+class SceneResources;
+
 class Scene
 {
 public:
     virtual ~Scene() = default;
+    // Builds what the scene draws (fonts from the shared resources, text).
+    // Runs once per instance, before its first onEnter, or earlier when it
+    // was queued with SceneStack::queuePreload
+    virtual void preload(SceneResources& /*resources*/) {}
     // Called when first on stack
     virtual void onEnter() {}
     // Called when removed
@@ -16,4 +22,8 @@ public:
     //Block game when paused
     virtual bool blocksUpdate() const { return true; }
     virtual bool isTransparent() const { return false; }
+
+private:
+    friend class SceneStack;
+    bool preloaded = false;
 };
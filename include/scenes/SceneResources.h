@@ -0,0 +1,22 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+// Assets shared by all scenes (the menu font and the like), owned by the
+// SceneStack. Each file is read once, the first time any scene asks for
+// it; references stay valid for the life of the stack.
+class SceneResources
+{
+public:
+    static constexpr const char* kUiFontPath = "resources/fonts/ScienceGothic.ttf";
+
+    // Loads on first use; a missing file is logged once and yields an
+    // empty font rather than failing the scene
+    const sf::Font& getFont(const std::string& path);
+    const sf::Font& getUiFont() { return getFont(kUiFontPath); }
+
+private:
+    std::unordered_map<std::string, std::unique_ptr<sf::Font>> fonts;
+};
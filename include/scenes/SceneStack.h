@@ -1,7 +1,11 @@
 ﻿#pragma once
 #include <vector>
 #include <memory>
+#include <typeindex>
+#include <unordered_map>
 #include "Scene.h"
+#include "SceneResources.h"
+#include "InputActionMap.h"
 
 class SceneStack
 {
@@ -25,6 +29,29 @@ public:
     std::shared_ptr<Scene> getTopScene() const;
 
     bool empty() const { return scenes.empty(); }
+    bool contains(const std::shared_ptr<Scene>& scene) const;
+
+    // One reusable instance per scene type, created by create() on first
+    // request. Menus pushed again and again (pause, options) come back
+    // with their text already built instead of being rebuilt per push.
+    template <typename T, typename Factory>
+    std::shared_ptr<T> getCachedScene(Factory&& create)
+    {
+        std::shared_ptr<Scene>& slot = cache[std::type_index(typeid(T))];
+        if (!slot)
+            slot = create();
+        return std::static_pointer_cast<T>(slot);
+    }
+
+    // Runs the scene's preload during a later update, one scene per frame,
+    // so its first push does no loading
+    void queuePreload(std::shared_ptr<Scene> scene);
+
+    SceneResources& getResources() { return resources; }
+
+    // Action state built from the events routed through handleEvent
+    InputActionMap& getInput() { return input; }
+    const InputActionMap& getInput() const { return input; }
 
 private:
     std::vector<std::shared_ptr<Scene>> scenes;
@@ -40,7 +67,14 @@ private:
 
     std::vector<PendingAction> pending;
 
-   
+    InputActionMap input;
+
+    SceneResources resources;
+    std::unordered_map<std::type_index, std::shared_ptr<Scene>> cache;
+    std::vector<std::shared_ptr<Scene>> preloadQueue;
+
     void applyPendingActions();
+    void enter(const std::shared_ptr<Scene>& scene);
+    void ensurePreloaded(Scene& scene);
 };
 
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// Live beam segments in structure-of-arrays form, bucketed by expiry time.
+// The buckets form a ring of kBucketSeconds slices: ageing is one float
+// subtract per segment, and expiry clears whole buckets without compacting
+// the segment arrays.
+//
+// Each segment's quad is written once, on insert, into a persistent mesh;
+// advance() only rewrites the fading alpha. A segment that expires or is
+// evicted has the mesh's last quad moved into its place, so the mesh stays
+// packed and only the vacated ranges are touched. Quads are therefore in no
+// particular order, which suits the additive blend beams are drawn with.
+//
+// Segments are dropped from the bucket covering their expiry time, so a
+// beam can linger up to one bucket (fully faded) past ttl == 0. TTLs longer
+// than the ring are clamped to its last bucket.
+class BeamStore {
+public:
+    struct Segment {
+        sf::Vector2f start;
+        sf::Vector2f end;
+        sf::Color color;
+        float width;
+        float ttl;
+        float lifetime;
+        float intensity;
+    };
+
+    static constexpr float kBucketSeconds = 1.f / 60.f;
+    static constexpr std::size_t kBucketCount = 256;
+    static constexpr std::size_t kDefaultMaxSegments = 8192;
+
+    explicit BeamStore(std::size_t maxSegments = kDefaultMaxSegments);
+
+    // At the cap, the oldest bucket's oldest segment makes room
+    void add(const Segment& segment);
+    void advance(float deltaTime);
+    void clear();
+
+    std::size_t size() const noexcept { return m_size; }
+    std::size_t getMaxSegments() const noexcept { return m_maxSegments; }
+    std::uint64_t getEvictedCount() const noexcept { return m_evicted; }
+
+    // Calls fn(const Segment&) for every live segment, soonest expiry first
+    template<typename Fn>
+    void forEach(Fn&& fn) const;
+
+    // Six vertices per live segment, faded to the current ttl
+    const std::vector<sf::Vertex>& getMesh() const noexcept { return m_mesh; }
+
+private:
+    struct Bucket {
+        std::size_t head = 0;               // evicted segments before this index
+        std::vector<sf::Vector2f> start;
+        std::vector<sf::Vector2f> end;
+        std::vector<sf::Color> color;
+        std::vector<float> width;
+        std::vector<float> ttl;
+        std::vector<float> lifetime;
+        std::vector<float> invLifetime;
+        std::vector<float> intensity;
+        std::vector<float> peakAlpha;       // colour alpha scaled by intensity
+        std::vector<std::uint32_t> quad;    // segment's quad in the mesh
+
+        std::size_t live() const noexcept { return ttl.size() - head; }
+        void clear();
+    };
+
+    std::int64_t tickFor(double time) const;
+    Bucket& bucketFor(std::int64_t tick);
+    void evictOldest();
+    void releaseQuad(std::uint32_t quad);
+
+    std::array<Bucket, kBucketCount> m_buckets;
+    double m_clock = 0.0;
+    std::int64_t m_currentTick = 0;
+    std::size_t m_size = 0;
+    std::size_t m_maxSegments;
+    std::uint64_t m_evicted = 0;
+
+    // Which bucket and slot each mesh quad belongs to, for moving the last
+    // quad into a released one
+    struct QuadOwner {
+        std::uint32_t bucket;
+        std::uint32_t index;
+    };
+    std::vector<sf::Vertex> m_mesh;
+    std::vector<QuadOwner> m_quadOwners;
+};
+
+template<typename Fn>
+void BeamStore::forEach(Fn&& fn) const {
+    for (std::size_t offset = 0; offset < kBucketCount; ++offset) {
+        const Bucket& bucket = m_buckets[(m_currentTick + offset) % kBucketCount];
+        for (std::size_t i = bucket.head; i < bucket.ttl.size(); ++i) {
+            fn(Segment{ bucket.start[i], bucket.end[i], bucket.color[i], bucket.width[i],
+                        bucket.ttl[i], bucket.lifetime[i], bucket.intensity[i] });
+        }
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/View.hpp>
+#include <SFML/System/Vector2.hpp>
+
+// Scrolling view over a world that may be larger than the reference
+// resolution. The camera eases towards its target and never shows anything
+// outside the world bounds; along an axis where the world fits on screen it
+// stays centred on the world, so single-screen levels do not scroll at all.
+class Camera {
+public:
+    Camera();
+
+    void setWorldBounds(const sf::FloatRect& bounds);
+    const sf::FloatRect& getWorldBounds() const noexcept;
+
+    // Eases the centre towards target; higher rates follow more tightly
+    void follow(const sf::Vector2f& target, float deltaTime);
+    // Jumps straight to target (level load, snapshot restore)
+    void snapTo(const sf::Vector2f& target);
+
+    void setFollowRate(float rate) noexcept;
+
+    sf::Vector2f getCenter() const noexcept;
+
+    // Area of the world on screen, in world coordinates. The view itself
+    // is ViewManager::getWorldView at getCenter().
+    sf::FloatRect getViewRect() const;
+
+private:
+    sf::Vector2f clampCenter(const sf::Vector2f& center) const;
+
+    sf::FloatRect m_worldBounds;
+    sf::Vector2f m_viewSize;
+    sf::Vector2f m_center;
+    float m_followRate = 8.f;
+};
+
+// Area a view shows, in world coordinates (ignores rotation)
+sf::FloatRect viewBounds(const sf::View& view);
@@ -6,6 +6,12 @@
 #include <map>
 #include <memory>
 
+#include "InputActionMap.h"
+#include "systems/TextLayout.h"
+
+class SnapshotWriter;
+class SnapshotReader;
+
 // Represents a single line of dialog
 struct DialogLine {
     std::string speaker;    // Name of the speaker (e.g., "King", "Hero")
@@ -43,7 +49,7 @@ public:
     void clear();
     
     // Update typewriter effect and handle input
-    void update(float deltaTime);
+    void update(float deltaTime, const InputFrame& input);
     
     // Render the dialog box
     void render(sf::RenderWindow& window);
@@ -60,12 +66,17 @@ public:
     // Register a speaker with custom colors
     void registerSpeaker(const std::string& name, const SpeakerStyle& style);
     
+    // Queue and typewriter progress for world snapshots
+    void saveState(SnapshotWriter& out) const;
+    void loadState(SnapshotReader& in);
+    
     // Settings
     void setTypewriterSpeed(float charsPerSecond) noexcept;
     void setBoxOpacity(float opacity) noexcept;
     
 private:
     void advanceToNextLine();
+    void showLine(const DialogLine& line);
     void setupBoxGeometry();
     const SpeakerStyle& getSpeakerStyle(const std::string& speaker) const;
     
@@ -80,7 +91,6 @@ private:
     
     // Typewriter effect
     std::string m_fullText;           // Complete text of current line
-    std::string m_displayedText;      // Text shown so far
     float m_typewriterTimer;
     float m_charsPerSecond;
     std::size_t m_currentCharIndex;
@@ -96,15 +106,17 @@ private:
     // Text objects need font at construction, so we use unique_ptr
     // These are created in initialize() once we have the font
     std::unique_ptr<sf::Text> m_nameText;
-    std::unique_ptr<sf::Text> m_dialogText;
     std::unique_ptr<sf::Text> m_continueIndicator;
     
+    // Current line laid out once when it starts; the typewriter only
+    // changes how many of its characters are drawn
+    TextLayout m_dialogLayout;
+    unsigned int m_dialogTextSize;
+    float m_dialogWrapWidth;
+    
     // Settings
     float m_boxOpacity;
     
-    // Input tracking
-    bool m_advanceKeyWasPressed;
-    
     // Animation for continue indicator
     float m_indicatorTimer;
 };
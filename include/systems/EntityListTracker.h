@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+struct Entity;
+
+// Lets a system keep per-entity state between updates and only rebuild it
+// when the entity list it is handed has changed. The list counts as changed
+// when any pointer differs (entities added, removed, woken or put to sleep)
+// or when a component has been destroyed since the last call, which also
+// covers a new entity landing at a freed address.
+class EntityListTracker {
+public:
+    // Compares against the list seen last time and remembers this one
+    bool changed(const std::vector<Entity*>& entities);
+    // The next changed() call reports a change
+    void reset() noexcept;
+
+private:
+    std::vector<Entity*> m_entities;
+    std::uint64_t m_releaseCount = 0;
+    bool m_valid = false;
+};
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <vector>
+
+// Shared ray / segment / box tests used by the light, AI and collision systems.
+namespace geometry {
+
+// Axis-aligned boxes stored as separate min/max arrays, padded with empty
+// boxes to a multiple of kLanes so the batch kernels never need a tail loop.
+// Indices are stable: set() replaces a box in place, setEmpty() disables it.
+class BoxBatch {
+public:
+    static constexpr std::size_t kLanes = 8;
+
+    void clear();
+    void reserve(std::size_t count);
+
+    std::size_t add(const sf::FloatRect& box);
+    std::size_t addEmpty();
+    void set(std::size_t index, const sf::FloatRect& box);
+    void setEmpty(std::size_t index);
+    sf::FloatRect get(std::size_t index) const;
+
+    std::size_t size() const noexcept { return m_count; }
+    std::size_t paddedSize() const noexcept { return m_minX.size(); }
+
+    const float* minX() const noexcept { return m_minX.data(); }
+    const float* minY() const noexcept { return m_minY.data(); }
+    const float* maxX() const noexcept { return m_maxX.data(); }
+    const float* maxY() const noexcept { return m_maxY.data(); }
+
+private:
+    void grow();
+
+    std::vector<float> m_minX;
+    std::vector<float> m_minY;
+    std::vector<float> m_maxX;
+    std::vector<float> m_maxY;
+    std::size_t m_count = 0;
+};
+
+struct RayHit {
+    std::size_t index = 0;
+    float distance = 0.f;
+    sf::Vector2f normal{0.f, 0.f};   // face normal; nearest face if the ray starts inside
+};
+
+// Nearest box hit by origin + t * direction for t in [0, maxDistance].
+// Tests 8 boxes per step with AVX, 4 with SSE, otherwise one at a time.
+bool intersectRayBoxes(const sf::Vector2f& origin,
+                       const sf::Vector2f& direction,
+                       float maxDistance,
+                       const BoxBatch& boxes,
+                       RayHit& outHit);
+
+// Same result, always the scalar loop (reference for tests and benchmarks)
+bool intersectRayBoxesScalar(const sf::Vector2f& origin,
+                             const sf::Vector2f& direction,
+                             float maxDistance,
+                             const BoxBatch& boxes,
+                             RayHit& outHit);
+
+// Single-box variant of the above
+bool intersectRayBox(const sf::Vector2f& origin,
+                     const sf::Vector2f& direction,
+                     float maxDistance,
+                     const sf::FloatRect& box,
+                     float& outDistance,
+                     sf::Vector2f& outNormal);
+
+// Does the segment a-b touch the box (inclusive of edges)?
+bool segmentIntersectsBox(const sf::Vector2f& a, const sf::Vector2f& b, const sf::FloatRect& box);
+
+bool boxesOverlap(const sf::FloatRect& a, const sf::FloatRect& b);
+
+// Name of the batch kernel compiled in ("avx", "sse" or "scalar")
+const char* batchKernelName();
+
+} // namespace geometry
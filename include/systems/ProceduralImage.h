@@ -0,0 +1,86 @@
+#pragma once
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Procedural textures (glows, gradients, noise) generated straight into a
+// flat RGBA buffer. Each generator fills one row of parameters into float
+// scratch arrays and then converts the row to bytes, so both passes are
+// plain loops over contiguous data the compiler can vectorise. Safe to call
+// from loader worker threads.
+namespace procedural {
+
+// Row-major RGBA8 pixels, four bytes per pixel
+struct PixelBuffer {
+    sf::Vector2u size{ 0u, 0u };
+    std::vector<std::uint8_t> rgba;
+
+    void resize(const sf::Vector2u& newSize);
+    sf::Image toImage() const;
+};
+
+// Square glow: center colour fading linearly to edge colour at the
+// inscribed circle, transparent outside it
+struct RadialFalloff {
+    unsigned int size = 64;
+    sf::Color center = sf::Color::White;
+    sf::Color edge = sf::Color::Transparent;
+};
+
+struct LinearGradient {
+    sf::Vector2u size{ 64u, 64u };
+    sf::Color from = sf::Color::Black;
+    sf::Color to = sf::Color::White;
+    bool vertical = true;           // false: left to right
+};
+
+// Smoothed value noise on a square lattice, blended between two colours
+struct ValueNoise {
+    sf::Vector2u size{ 64u, 64u };
+    float cellSize = 16.f;          // lattice spacing in pixels
+    std::uint32_t seed = 1;
+    sf::Color low = sf::Color::Black;
+    sf::Color high = sf::Color::White;
+};
+
+void generate(const RadialFalloff& params, PixelBuffer& out);
+void generate(const LinearGradient& params, PixelBuffer& out);
+void generate(const ValueNoise& params, PixelBuffer& out);
+
+// File-safe name covering every parameter, used as the disk cache key
+std::string cacheKey(const RadialFalloff& params);
+std::string cacheKey(const LinearGradient& params);
+std::string cacheKey(const ValueNoise& params);
+
+// Generated images kept on disk between runs as raw pixels with a small
+// header, so a large texture costs one file read instead of a regeneration.
+// Files from an older generator version are ignored and rewritten. A cache
+// that cannot be written only costs the regeneration next time.
+class ImageCache {
+public:
+    explicit ImageCache(std::string directory = "cache/textures");
+
+    template <typename Params>
+    void get(const Params& params, PixelBuffer& out) const {
+        const std::string key = cacheKey(params);
+        if (load(key, out)) {
+            return;
+        }
+        generate(params, out);
+        store(key, out);
+    }
+
+    bool load(const std::string& key, PixelBuffer& out) const;
+    void store(const std::string& key, const PixelBuffer& pixels) const;
+
+private:
+    std::string pathFor(const std::string& key) const;
+
+    std::string m_directory;
+};
+
+} // namespace procedural
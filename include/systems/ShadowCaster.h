@@ -0,0 +1,48 @@
+#pragma once
+
+#include "systems/SpatialGrid.h"
+
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <vector>
+
+class Map;
+
+// Wall outline as straight segments, extracted once per level, plus 2D
+// visibility polygons against it. A polygon is found by an angular sweep:
+// rays towards every nearby segment endpoint (and just either side of it),
+// towards the points where segments cross the light circle, plus a fixed
+// ring of rays, each clipped to the closest segment.
+class ShadowCaster {
+public:
+    struct Segment {
+        sf::Vector2f a;
+        sf::Vector2f b;
+    };
+
+    ShadowCaster();
+
+    // Edges between wall and open tiles, with collinear neighbours joined.
+    // Bumps the version so cached polygons know to rebuild.
+    void build(const Map& map, float tileSize, const sf::Vector2f& offset);
+    void clear();
+
+    const std::vector<Segment>& getSegments() const noexcept { return m_segments; }
+    std::uint32_t getVersion() const noexcept { return m_version; }
+
+    // Perimeter of the area visible from origin within radius, ordered by
+    // angle; draw as a fan around origin
+    void computeVisibility(const sf::Vector2f& origin,
+                           float radius,
+                           std::vector<sf::Vector2f>& outPolygon) const;
+
+private:
+    std::vector<Segment> m_segments;
+    std::vector<sf::FloatRect> m_segmentBounds;
+    SpatialGrid m_grid;
+    std::uint32_t m_version = 0;
+
+    // Scratch for computeVisibility, kept to avoid reallocating
+    mutable std::vector<std::uint32_t> m_nearby;
+    mutable std::vector<float> m_angles;
+};
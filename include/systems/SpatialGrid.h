@@ -0,0 +1,75 @@
+#pragma once
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// Uniform bucket grid rebuilt from scratch every frame.
+// Items are plain indices into a caller-owned array, so the grid never
+// touches entities or components. build() is a counting sort over the
+// covered cells: one pass to count, one prefix sum, one pass to fill.
+class SpatialGrid {
+public:
+    explicit SpatialGrid(float cellSize = 64.f);
+
+    void setCellSize(float cellSize) noexcept;
+    float getCellSize() const noexcept;
+
+    // Rebuild the grid from item bounds (index i refers to bounds[i])
+    void build(const std::vector<sf::FloatRect>& bounds);
+
+    // Calls fn(index) once for every item whose cells overlap the area
+    template<typename Fn>
+    void query(const sf::FloatRect& area, Fn&& fn) const;
+
+    std::size_t getItemCount() const noexcept { return m_itemCount; }
+
+private:
+    bool cellRange(const sf::FloatRect& area, int& x0, int& y0, int& x1, int& y1) const;
+
+private:
+    float m_cellSize;
+    float m_activeCellSize;                   // grown if the area would need too many cells
+    sf::Vector2f m_origin{ 0.f, 0.f };
+    int m_columns = 0;
+    int m_rows = 0;
+    std::size_t m_itemCount = 0;
+
+    std::vector<std::uint32_t> m_cellStart;   // size = cells + 1
+    std::vector<std::uint32_t> m_cellItems;   // item indices grouped by cell
+    std::vector<std::uint32_t> m_fillCursor;  // scratch for build(), kept to avoid reallocating
+
+    // Per-item stamp so items spanning several cells are reported once
+    mutable std::vector<std::uint32_t> m_visitStamp;
+    mutable std::uint32_t m_currentStamp = 0;
+};
+
+template<typename Fn>
+void SpatialGrid::query(const sf::FloatRect& area, Fn&& fn) const {
+    int x0, y0, x1, y1;
+    if (!cellRange(area, x0, y0, x1, y1)) {
+        return;
+    }
+
+    if (++m_currentStamp == 0) {
+        // Stamp wrapped around - start over so stale stamps cannot match
+        std::fill(m_visitStamp.begin(), m_visitStamp.end(), 0u);
+        m_currentStamp = 1;
+    }
+
+    for (int cy = y0; cy <= y1; ++cy) {
+        for (int cx = x0; cx <= x1; ++cx) {
+            const std::size_t cell = static_cast<std::size_t>(cy) * m_columns + cx;
+            for (std::uint32_t i = m_cellStart[cell]; i < m_cellStart[cell + 1]; ++i) {
+                const std::uint32_t item = m_cellItems[i];
+                if (m_visitStamp[item] == m_currentStamp) {
+                    continue;
+                }
+                m_visitStamp[item] = m_currentStamp;
+                fn(static_cast<std::size_t>(item));
+            }
+        }
+    }
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// One block of text laid out once into glyph quads, with word wrapping.
+// Drawing a prefix of the characters is a single draw call over the front
+// of the vertex array, so revealing text a character at a time costs no
+// allocation or re-layout. Quads match sf::Text's regular style.
+class TextLayout {
+public:
+    // maxWidth <= 0 disables wrapping; explicit '\n' always breaks
+    void build(const sf::Font& font,
+               const std::string& text,
+               unsigned int characterSize,
+               float maxWidth,
+               sf::Color color);
+    void clear();
+
+    void setColor(sf::Color color);
+    void setPosition(const sf::Vector2f& position) noexcept { m_position = position; }
+
+    std::size_t getCharacterCount() const noexcept { return m_vertexEnd.empty() ? 0 : m_vertexEnd.size() - 1; }
+
+    // Draws the first `characters` characters of the text
+    void draw(sf::RenderTarget& target, std::size_t characters, sf::RenderStates states = sf::RenderStates::Default) const;
+
+private:
+    float measureWord(const std::string& text, std::size_t first) const;
+
+    const sf::Font* m_font = nullptr;
+    unsigned int m_characterSize = 0;
+    sf::Vector2f m_position;
+    std::vector<sf::Vertex> m_vertices;     // six per visible glyph
+    std::vector<std::size_t> m_vertexEnd;   // [i] = vertices covering the first i characters
+};
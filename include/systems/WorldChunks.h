@@ -0,0 +1,99 @@
+#pragma once
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+class Map;
+struct Entity;
+
+// The level split into square chunks of kChunkTiles x kChunkTiles tiles.
+// Every entity belongs to the chunk its position falls in. Chunks within one
+// chunk of the focus area (the camera view) are awake; the rest sleep. Only
+// entities of awake chunks make the active list that the simulation systems
+// are fed, and only awake chunks hold a baked tile mesh, so per-frame work
+// and mesh memory follow the view rather than the map size.
+//
+// Sleeping entities cannot move, so only awake ones are re-binned each
+// update. The active list is kept in entity order (the order the entities
+// were assigned or added in), whatever the wake/sleep history, so replays
+// and snapshot restores see the same update order.
+class WorldChunks {
+public:
+    static constexpr int kChunkTiles = 32;
+
+    void build(const Map& map, float tileSize, const sf::Vector2f& offset);
+    void clear();
+
+    std::size_t getChunkCount() const noexcept { return m_chunks.size(); }
+    // Tile area of a chunk (clipped to the map), e.g. for per-chunk wall merging
+    const sf::IntRect& getChunkTiles(std::size_t chunk) const { return m_chunks[chunk].tiles; }
+
+    // Bins every entity by position; call after (re)creating or restoring
+    // the level. Entities without a transform are always active.
+    void assign(const std::vector<Entity*>& entities);
+    // Entity created mid-level (spawned enemy); it is ordered after the rest
+    void add(Entity* entity);
+
+    // Wakes the chunks around focus, puts the others to sleep, re-bins the
+    // awake entities that moved and rebuilds the active list
+    void update(const sf::FloatRect& focus);
+
+    // Handed to the systems' update/render calls; valid until the next update
+    std::vector<Entity*>& getActiveEntities() noexcept { return m_active; }
+    std::size_t getAwakeChunkCount() const noexcept { return m_awake.size(); }
+
+    // Tile meshes of the awake chunks under the target's view
+    void drawMap(sf::RenderTarget& target) const;
+
+private:
+    struct MeshLayer {
+        const sf::Texture* texture = nullptr;   // nullptr: untextured fallback colours
+        std::vector<sf::Vertex> vertices;       // two triangles per tile
+    };
+
+    // An entity and its place in entity order
+    struct Resident {
+        std::uint32_t order;
+        Entity* entity;
+    };
+
+    struct Chunk {
+        sf::IntRect tiles;
+        sf::FloatRect bounds;
+        std::vector<Resident> residents;
+        std::vector<MeshLayer> mesh;            // empty while asleep
+        bool awake = false;
+    };
+
+    static constexpr std::uint32_t kNoChunk = 0xFFFFFFFFu;
+
+    std::uint32_t chunkAt(const sf::Vector2f& position) const;
+    std::uint32_t chunkOf(Entity& entity) const;
+    void wake(std::size_t chunk);
+    void sleep(std::size_t chunk);
+    void bakeMesh(Chunk& chunk) const;
+
+    const Map* m_map = nullptr;
+    float m_tileSize = 0.f;
+    sf::Vector2f m_offset{ 0.f, 0.f };
+    int m_columns = 0;
+    int m_rows = 0;
+
+    std::vector<Chunk> m_chunks;
+    std::vector<std::size_t> m_awake;
+    std::vector<Resident> m_unplaced;           // no transform: always active
+    std::uint32_t m_nextOrder = 0;
+
+    std::vector<Entity*> m_active;
+
+    // Scratch for update(), kept to avoid reallocating
+    std::vector<std::size_t> m_wakeScratch;
+    std::vector<std::pair<Resident, std::uint32_t>> m_moves;
+    std::vector<Resident> m_activeScratch;
+};
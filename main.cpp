@@ -1,22 +1,79 @@
-#include <iostream>
+#include <string>
 #include "Application.h"
+#include "ReplaySession.h"
+#include "scenes/GameplayScene.h"
+#include "scenes/LoadingScene.h"
 #include "scenes/MainMenuScene.h"
+#include "Log.h"
 
-int main()
+namespace
 {
+    void printUsage(const char* exe)
+    {
+        EOL_LOG_INFO << "Usage: " << exe << " [--record <file>] [--replay <file> [--headless [--rollback]]]\n"
+                  << "  --record <file>   record the first gameplay session's input\n"
+                  << "  --replay <file>   play a recording back and verify its state checkpoints\n"
+                  << "  --headless        replay without opening a window (benchmark mode)\n"
+                  << "  --rollback        also snapshot/restore the world at every checkpoint";
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    std::string recordPath;
+    std::string replayPath;
+    bool headless = false;
+    bool rollback = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--record" && i + 1 < argc)
+            recordPath = argv[++i];
+        else if (arg == "--replay" && i + 1 < argc)
+            replayPath = argv[++i];
+        else if (arg == "--headless")
+            headless = true;
+        else if (arg == "--rollback")
+            rollback = true;
+        else
+        {
+            printUsage(argv[0]);
+            return arg == "--help" ? 0 : -1;
+        }
+    }
+
     try
     {
+        if (!replayPath.empty() && headless)
+            return runHeadlessReplay(replayPath, rollback);
+
         Application app;
 
-        // Start at the main menu
-        app.pushScene(std::make_shared<MainMenuScene>(app));
+        if (!replayPath.empty())
+        {
+            InputReplay replay;
+            if (!replay.load(replayPath))
+                return -1;
+
+            // Straight into gameplay, driven by the recording
+            app.pushScene(std::make_shared<LoadingScene>(app, std::make_shared<GameplayScene>(
+                app, std::make_shared<ReplaySession>(std::move(replay)))));
+        }
+        else
+        {
+            app.setRecordPath(recordPath);
+
+            // Start at the main menu
+            app.pushScene(app.getScene<MainMenuScene>());
+        }
 
         // Run the application loop
         app.run();
     }
     catch (const std::exception& ex)
     {
-        std::cerr << "Fatal error: " << ex.what() << "\n";
+        EOL_LOG_ERROR << "Fatal error: " << ex.what();
         return -1;
     }
 
@@ -1,5 +1,5 @@
 #include "Application.h"
-#include <iostream>
+#include "Log.h"
 
 Application::Application()
 {
@@ -16,8 +16,8 @@ Application::Application()
     setFramerateLimit(currentFramerate);
 
     // Apply scaled reference view
-    scaledView = GameSettings::getScaledView(window.getSize());
-    window.setView(scaledView);
+    views.setWindowSize(window.getSize());
+    window.setView(views.getScaledView());
 }
 
 void Application::run()
@@ -72,12 +72,12 @@ void Application::setResolution(unsigned int index)
     );
 
     // Recalculate scaling
-    scaledView = GameSettings::getScaledView(window.getSize());
-    window.setView(scaledView);
+    views.setWindowSize(window.getSize());
+    window.setView(views.getScaledView());
 
     setFramerateLimit(currentFramerate);
 
-    std::cout << "Resolution changed to: " << res.label << "\n";
+    EOL_LOG_INFO << "Resolution changed to: " << res.label;
 }
 
 void Application::setFramerateLimit(unsigned int limit)
@@ -86,9 +86,9 @@ void Application::setFramerateLimit(unsigned int limit)
     window.setFramerateLimit(limit);
 
     if (limit == 0)
-        std::cout << "Framerate: Unlimited\n";
+        EOL_LOG_INFO << "Framerate: Unlimited";
     else
-        std::cout << "Framerate set to: " << limit << "\n";
+        EOL_LOG_INFO << "Framerate set to: " << limit;
 }
 
 // --------------------------------------------------------
@@ -106,6 +106,9 @@ void Application::processEvents()
             return;
         }
 
+        if (const auto* resized = event->getIf<sf::Event::Resized>())
+            views.setWindowSize(resized->size);
+
         // Forward to current scene
         sceneStack.handleEvent(*event);
     }
@@ -120,7 +123,7 @@ void Application::render()
 {
     window.clear(sf::Color(20, 20, 30));
 
-    window.setView(scaledView);
+    window.setView(views.getScaledView());
     sceneStack.render(window);
 
     window.display();
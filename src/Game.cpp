@@ -2,7 +2,6 @@
 #include <algorithm>
 #include <cmath>
 #include <filesystem>
-#include <iostream>
 #include <memory>
 #include "components/AnimationComponent.h"
 #include "components/CollisionComponent.h"
@@ -22,6 +21,9 @@
 #include "components/LevelManager.h"
 #include "components/SpawnerComponent.h"
 #include "GameSettings.h"
+#include "InputRecording.h"
+#include "Log.h"
+#include "systems/ProceduralImage.h"
 
 
 // =============================================================
@@ -35,45 +37,11 @@ namespace {
         return img;
     }
 
-    sf::Image createCircularFalloffImage(unsigned int size,
-        sf::Color centerColor,
-        sf::Color edgeColor)
-    {
-        sf::Image img(sf::Vector2u(size, size), sf::Color::Transparent);
-
-        const float half = static_cast<float>(size) * 0.5f;
-
-        for (unsigned int y = 0; y < size; ++y)
-        {
-            for (unsigned int x = 0; x < size; ++x)
-            {
-                float dx = static_cast<float>(x) - half + 0.5f;
-                float dy = static_cast<float>(y) - half + 0.5f;
-                float dist = std::sqrt(dx * dx + dy * dy);
-                float norm = dist / half;
-
-                if (norm <= 1.f)
-                {
-                    float t = std::clamp(norm, 0.f, 1.f);
-
-                    auto mix = [t](uint8_t a, uint8_t b)
-                        {
-                            return static_cast<uint8_t>(a * (1.f - t) + b * t);
-                        };
-
-                    sf::Color c;
-                    c.r = mix(centerColor.r, edgeColor.r);
-                    c.g = mix(centerColor.g, edgeColor.g);
-                    c.b = mix(centerColor.b, edgeColor.b);
-                    c.a = mix(centerColor.a, edgeColor.a);
-
-                    img.setPixel({ x, y }, c);
-                }
-            }
-        }
+    // Edge of the generated light node glow, in pixels
+    constexpr unsigned int kLightNodeTextureSize = 64;
 
-        return img;
-    }
+    // Smallest tile edge in reference pixels; larger maps scroll instead
+    constexpr float kMinTileSize = 48.f;
 
 } // namespace
 
@@ -97,23 +65,33 @@ Game::Game()
 {
 }
 
+Game::Game(int startLevel)
+    : Game()
+{
+    startLevelIndex_ = std::max(0, startLevel);
+}
+
 // =============================================================
 //   Initialization
 // =============================================================
 bool Game::initialize()
 {
-    std::cout << "=== ECHOES OF LIGHT (Gameplay Initializing) ===\n";
+    EOL_LOG_INFO << "=== ECHOES OF LIGHT (Gameplay Initializing) ===";
 
-    if (!loadResources())
+    // Usually already done in the background by a LoadingScene
+    if (!resourcesLoaded_ && !loadResources())
         return false;
 
+    registerAnimationClips();
+    buildPrefabs();
+
     // Load starting level
     levels_.setCurrentIndex(startLevelIndex_);
     if (!levels_.loadCurrentLevel()) {
-        std::cerr << "ERROR: Failed to load starting level\n";
+        EOL_LOG_ERROR << "Failed to load starting level";
         return false;
     }
-    std::cout << "Loaded first level successfully.\n";
+    EOL_LOG_INFO << "Loaded first level successfully.";
 
     // Calculate tile size for this level
     recalculateTileSize();
@@ -122,7 +100,7 @@ bool Game::initialize()
     
     // Initialize dialog system
     if (!dialogSystem_.initialize(gameFont_)) {
-        std::cerr << "ERROR: Failed to initialize dialog system\n";
+        EOL_LOG_ERROR << "Failed to initialize dialog system";
         return false;
     }
 
@@ -152,6 +130,7 @@ bool Game::initialize()
         });
 
     createEntities();
+    saveSnapshot(levelStartSnapshot_);
 
     initialized_ = true;
     return true;
@@ -160,77 +139,66 @@ bool Game::initialize()
 // =============================================================
 //   Resource Loading
 // =============================================================
-bool Game::loadResources()
+void Game::queueResources(ResourceLoader& loader)
 {
-    std::string idlePath = findResourcePath("resources/sprites/Character_Idle.png");
-    std::string movePath = findResourcePath("resources/sprites/Character_Move.png");
-    
-
-    if (!idleTexture_.loadFromFile(idlePath))
-    {
-        std::cerr << "ERROR: Failed to load idle sprite\n";
-        return false;
-    }
-
-    if (!moveTexture_.loadFromFile(movePath))
-    {
-        std::cerr << "ERROR: Failed to load movement sprite\n";
-        return false;
-    }
-
-    if (!debugWhiteTexture_.loadFromImage(createSolidImage(2, sf::Color::White)))
-    {
-        std::cerr << "ERROR: Failed to create debug texture\n";
-        return false;
-    }
+    loader.addTexture(idleTexture_, findResourcePath("resources/sprites/Character_Idle.png"));
+    loader.addTexture(moveTexture_, findResourcePath("resources/sprites/Character_Move.png"));
 
-    sf::Color center(255, 255, 230, 255);
-    sf::Color edge(255, 255, 230, 80);
+    loader.addGeneratedTexture(debugWhiteTexture_, "debug white", [](sf::Image& image) {
+        image = createSolidImage(2, sf::Color::White);
+        return true;
+        });
 
-    if (!lightNodeTexture_.loadFromImage(createCircularFalloffImage(64, center, edge)))
-    {
-        std::cerr << "ERROR: Failed to create light node texture\n";
-        return false;
-    }
+    // Generated once, then read back from the disk cache on later runs
+    loader.addGeneratedTexture(lightNodeTexture_, "light node falloff", [](sf::Image& image) {
+        procedural::RadialFalloff glow;
+        glow.size = kLightNodeTextureSize;
+        glow.center = sf::Color(255, 255, 230, 255);
+        glow.edge = sf::Color(255, 255, 230, 80);
 
-    
-    // Load wall textures for each era
-    std::string wallPastPath = findResourcePath("resources/sprites/PastWall.png");
-    if (!wallTexturePast_.loadFromFile(wallPastPath)) {
-        std::cerr << "WARNING: Failed to load past wall texture\n";
-        if (!wallTexturePast_.loadFromImage(createSolidImage(16, sf::Color(80, 80, 100)))) {
-            std::cerr << "ERROR: Failed to create fallback past wall texture\n";
-        }
-    }
+        procedural::PixelBuffer pixels;
+        procedural::ImageCache().get(glow, pixels);
+        image = pixels.toImage();
+        return true;
+        });
 
-    std::string wallPresentPath = findResourcePath("resources/sprites/PresentWall.png");
-    if (!wallTexturePresent_.loadFromFile(wallPresentPath)) {
-        std::cerr << "WARNING: Failed to load present wall texture\n";
-        if (!wallTexturePresent_.loadFromImage(createSolidImage(16, sf::Color(100, 80, 80)))) {
-            std::cerr << "ERROR: Failed to create fallback present wall texture\n";
-        }
-    }
+    // Wall textures for each era; a flat colour stands in for a missing file
+    auto solid = [](sf::Color color) {
+        return [color](sf::Image& image) {
+            image = createSolidImage(16, color);
+            return true;
+            };
+        };
+    loader.addTexture(wallTexturePast_, findResourcePath("resources/sprites/PastWall.png"), solid(sf::Color(80, 80, 100)));
+    loader.addTexture(wallTexturePresent_, findResourcePath("resources/sprites/PresentWall.png"), solid(sf::Color(100, 80, 80)));
+    loader.addTexture(wallTextureFuture_, findResourcePath("resources/sprites/FutureWall.png"), solid(sf::Color(80, 100, 100)));
 
-    std::string wallFuturePath = findResourcePath("resources/sprites/FutureWall.png");
-    if (!wallTextureFuture_.loadFromFile(wallFuturePath)) {
-        std::cerr << "WARNING: Failed to load future wall texture\n";
-        if (!wallTextureFuture_.loadFromImage(createSolidImage(16, sf::Color(80, 100, 100)))) {
-            std::cerr << "ERROR: Failed to create fallback future wall texture\n";
-        }
-    }
+    // Font for the dialog system
+    loader.addFont(gameFont_, findResourcePath("resources/fonts/ScienceGothic.ttf"));
+}
 
-    // Load font for dialog system
-    std::string fontPath = findResourcePath("resources/fonts/ScienceGothic.ttf");
-    if (!gameFont_.openFromFile(fontPath)) {
-        std::cerr << "ERROR: Failed to load game font\n";
+bool Game::finishResources(const ResourceLoader& loader)
+{
+    if (!loader.isDone() || loader.hasFailed())
+    {
+        EOL_LOG_ERROR << "Failed to load game resources";
         return false;
     }
 
-    std::cout << "Textures loaded OK.\n";
-    std::cout << "Font loaded OK.\n";
+    resourcesLoaded_ = true;
+    EOL_LOG_INFO << "Textures loaded OK.";
+    EOL_LOG_INFO << "Font loaded OK.";
     return true;
 }
 
+bool Game::loadResources()
+{
+    ResourceLoader loader;
+    queueResources(loader);
+    loader.finish();
+    return finishResources(loader);
+}
+
 // =============================================================
 //   Create ALL Gameplay Entities (Original Logic Restored)
 // =============================================================
@@ -243,6 +211,7 @@ void Game::createEntities()
 
     const Map& map = levels_.getCurrentMap();
     sf::Vector2f playerStartPos = GameSettings::center(); // Default fallback
+    chunks_.build(map, tileSize_, mapOffset_);
 
     auto addWorld = [&](Entity&& e)
         {
@@ -252,15 +221,43 @@ void Game::createEntities()
             worldObjects_.push_back(std::move(ptr));
         };
 
-    // Scan through the map and create entities for each tile
+    auto addBeacon = [&](Entity&& e)
+        {
+            auto ptr = std::make_unique<Entity>(std::move(e));
+            beacons_.push_back(ptr.get());
+            entities_.push_back(ptr.get());
+            worldObjects_.push_back(std::move(ptr));
+        };
+
+    const sf::Vector2f mirrorSize = GameSettings::relativeSize(0.052f, 0.015f);
+
+    // Walls go in as merged blocks rather than one entity per tile, so
+    // collision and beam tests see a few rectangles per wall run. Blocks
+    // are merged per chunk so each one sleeps and wakes with its chunk.
+    std::size_t wallBlockCount = 0;
+    for (std::size_t chunk = 0; chunk < chunks_.getChunkCount(); ++chunk) {
+        for (const sf::IntRect& rect : map.buildWallRects(chunks_.getChunkTiles(chunk))) {
+            PrefabOverrides block;
+            block.size = sf::Vector2f(rect.size.x * tileSize_, rect.size.y * tileSize_);
+            block.position = mapOffset_ + sf::Vector2f(rect.position.x * tileSize_, rect.position.y * tileSize_)
+                + *block.size * 0.5f;
+            addWorld(prefabs_.instantiate(wallPrefab_, block));
+            ++wallBlockCount;
+        }
+    }
+
+    // Scan through the map and instantiate a prefab for each other tile
     for (int y = 0; y < map.getHeight(); ++y) {
         for (int x = 0; x < map.getWidth(); ++x) {
             TileType tile = map.getTile(x, y);
             sf::Vector2f worldPos = tileToWorld(x, y);
 
+            PrefabOverrides at;
+            at.position = worldPos;
+
             switch (tile) {
             case TileType::WALL:
-                addWorld(createWallEntity(worldPos, sf::Vector2f(tileSize_, tileSize_)));
+                // Already added as part of a merged block
                 break;
 
             case TileType::START:
@@ -273,66 +270,35 @@ void Game::createEntities()
                 break;
 
             case TileType::LIGHT_SOURCE:
-                addWorld(createLightSourceNode("Light_" + std::to_string(x) + "_" + std::to_string(y),
-                    worldPos, true));
+                at.name = "Light_" + std::to_string(x) + "_" + std::to_string(y);
+                addWorld(prefabs_.instantiate(lightNodePrefab_, at));
                 break;
 
             case TileType::BEACON_1:
-            {
-                auto beacon = createLightBeaconEntity(worldPos, 1);
-                auto ptr = std::make_unique<Entity>();
-                *ptr = std::move(beacon);
-                beacons_.push_back(ptr.get());
-                entities_.push_back(ptr.get());
-                worldObjects_.push_back(std::move(ptr));
+                at.requiredSources = 1;
+                addBeacon(prefabs_.instantiate(beaconPrefab_, at));
                 break;
-            }
             case TileType::BEACON_2:
-            {
-                auto beacon = createLightBeaconEntity(worldPos, 2);
-                auto ptr = std::make_unique<Entity>();
-                *ptr = std::move(beacon);
-                beacons_.push_back(ptr.get());
-                entities_.push_back(ptr.get());
-                worldObjects_.push_back(std::move(ptr));
+                at.requiredSources = 2;
+                addBeacon(prefabs_.instantiate(beaconPrefab_, at));
                 break;
-            }
-            case TileType::BEACON_3:  
-            {
-                auto beacon = createLightBeaconEntity(worldPos, 3);
-                auto ptr = std::make_unique<Entity>();
-                *ptr = std::move(beacon);
-                beacons_.push_back(ptr.get());
-                entities_.push_back(ptr.get());
-                worldObjects_.push_back(std::move(ptr));
+            case TileType::BEACON_3:
+                at.requiredSources = 3;
+                addBeacon(prefabs_.instantiate(beaconPrefab_, at));
                 break;
-            }
-            case TileType::BEACON_4:  
-            {
-                auto beacon = createLightBeaconEntity(worldPos, 4);
-                auto ptr = std::make_unique<Entity>();
-                *ptr = std::move(beacon);
-                beacons_.push_back(ptr.get());
-                entities_.push_back(ptr.get());
-                worldObjects_.push_back(std::move(ptr));
+            case TileType::BEACON_4:
+                at.requiredSources = 4;
+                addBeacon(prefabs_.instantiate(beaconPrefab_, at));
                 break;
-            }
-
 
             case TileType::MIRROR:
-                addWorld(createMirrorEntity(
-                    worldPos,
-                    { 1, 1 },
-                    GameSettings::relativeSize(0.052f, 0.015f),
-                    eol::MirrorComponent::MirrorType::Flat));
+                // Mirrors are centred on the tile corner plus half their size
+                at.position = worldPos + mirrorSize * 0.5f;
+                addWorld(prefabs_.instantiate(mirrorPrefab_, at));
                 break;
 
             case TileType::SPAWNER:
-                addWorld(createSpawnerEntity(
-                    worldPos,
-                    5.f,    // Spawn every 5 seconds
-                    5       // Max 5 enemies per spawner
-                ));
+                addWorld(prefabs_.instantiate(spawnerPrefab_, at));
                 break;
 
             case TileType::EMPTY:
@@ -352,10 +318,86 @@ void Game::createEntities()
 
     // Create light beacon (could place this as a tile from map )
     // Create enemy (you could add an 'X' tile type for enemies)
-    enemy_ = createEnemyEntity();
+    enemy_ = prefabs_.instantiate(enemyPrefab_);
     entities_.push_back(&enemy_);
 
-    std::cout << "Created " << entities_.size() << " entities from map.\n";
+    lightSystem_.setOccluders(map, tileSize_, mapOffset_);
+    camera_.snapTo(playerStartPos);
+    chunks_.assign(entities_);
+    chunks_.update(camera_.getViewRect());
+
+    levelEntityCount_ = entities_.size();
+    EOL_LOG_INFO << "Created " << entities_.size() << " entities from map ("
+        << wallBlockCount << " merged wall blocks, " << chunks_.getChunkCount() << " chunks).";
+}
+
+// =============================================================
+//   Animation clips
+// =============================================================
+void Game::registerAnimationClips()
+{
+    auto& clips = eol::AnimationLibrary::instance();
+
+    eol::Animation idle;
+    idle.name = "player.idle";
+    idle.texture = &idleTexture_;
+    idle.frameCount = 4;
+    idle.frameWidth = 128;
+    idle.frameHeight = 128;
+    idle.frameDuration = 0.15f;
+    idle.loop = true;
+    clips.add(idle);
+
+    eol::Animation walk;
+    walk.name = "player.walk";
+    walk.texture = &moveTexture_;
+    walk.frameCount = 6;
+    walk.frameWidth = 128;
+    walk.frameHeight = 128;
+    walk.frameDuration = 0.1f;
+    walk.loop = true;
+    clips.add(walk);
+}
+
+// =============================================================
+//   Prefabs
+// =============================================================
+void Game::buildPrefabs()
+{
+    prefabs_.clear();
+
+    definePrefabs(prefabs_, debugWhiteTexture_, lightNodeTexture_);
+    wallPrefab_ = prefabs_.find("Wall");
+    lightNodePrefab_ = prefabs_.find("LightNode");
+    beaconPrefab_ = prefabs_.find("LightBeacon");
+    mirrorPrefab_ = prefabs_.find("Mirror");
+    spawnerPrefab_ = prefabs_.find("Spawner");
+    enemyPrefab_ = prefabs_.find("Enemy");
+
+    prefabs_.setTextureResolver([this](const std::string& id) -> const sf::Texture* {
+        if (id == "debugWhite") return &debugWhiteTexture_;
+        if (id == "lightNode")  return &lightNodeTexture_;
+        if (id == "idle")       return &idleTexture_;
+        if (id == "move")       return &moveTexture_;
+        return nullptr;
+        });
+
+    prefabs_.loadFromFile(findResourcePath("resources/prefabs/prefabs.txt"));
+}
+
+void Game::definePrefabs(PrefabLibrary& prefabs, const sf::Texture& debugWhite, const sf::Texture& lightNode)
+{
+    // Positions, sizes and beacon numbers are per-instance overrides
+    prefabs.define("Wall", createWallEntity(debugWhite, { 0.f, 0.f }, { 1.f, 1.f }));
+    prefabs.define("LightNode", createLightSourceNode(lightNode, "LightNode", { 0.f, 0.f }, true));
+    prefabs.define("LightBeacon", createLightBeaconEntity({ 0.f, 0.f }, 1));
+    prefabs.define("Mirror", createMirrorEntity(debugWhite, { 0.f, 0.f }, { 1, 1 },
+        GameSettings::relativeSize(0.052f, 0.015f), eol::MirrorComponent::MirrorType::Flat));
+    prefabs.define("Spawner", createSpawnerEntity({ 0.f, 0.f },
+        5.f,    // Spawn every 5 seconds
+        5       // Max 5 enemies per spawner
+    ));
+    prefabs.define("Enemy", createEnemyEntity(debugWhite));
 }
 
 // =============================================================
@@ -380,28 +422,7 @@ Entity Game::createPlayerEntity()
     e.components.emplace_back(std::move(collision));
 
     auto anim = std::make_unique<eol::AnimationComponent>();
-
-    eol::Animation idle;
-    idle.name = "idle";
-    idle.texture = &idleTexture_;
-    idle.frameCount = 4;
-    idle.frameWidth = 128;
-    idle.frameHeight = 128;
-    idle.frameDuration = 0.15f;
-    idle.loop = true;
-    anim->addAnimation("idle", idle);
-
-    eol::Animation walk;
-    walk.name = "walk";
-    walk.texture = &moveTexture_;
-    walk.frameCount = 6;
-    walk.frameWidth = 128;
-    walk.frameHeight = 128;
-    walk.frameDuration = 0.1f;
-    walk.loop = true;
-    anim->addAnimation("walk", walk);
-
-    anim->setAnimation("idle");
+    anim->setAnimation("player.idle");
     e.components.emplace_back(std::move(anim));
 
     e.components.emplace_back(std::make_unique<eol::LightComponent>());
@@ -467,7 +488,7 @@ Entity Game::createLightBeaconEntity(const sf::Vector2f& worldPosition, int beac
     return e;
 }
 
-Entity Game::createEnemyEntity()
+Entity Game::createEnemyEntity(const sf::Texture& debugWhite)
 {
     Entity e;
     e.name = "Enemy";
@@ -485,7 +506,7 @@ Entity Game::createEnemyEntity()
 
     auto render = std::make_unique<eol::RenderComponent>();
     auto& sprite = render->getSprite();
-    sprite.setTexture(debugWhiteTexture_);
+    sprite.setTexture(debugWhite);
     sprite.setTextureRect({ {0,0}, {1,1} });
     sprite.setOrigin({ 0.5f, 0.5f });
     sprite.setScale(GameSettings::relativeSize(0.022f, 0.05f));
@@ -509,7 +530,8 @@ Entity Game::createEnemyEntity()
     return e;
 }
 
-Entity Game::createMirrorEntity(const sf::Vector2f& position,
+Entity Game::createMirrorEntity(const sf::Texture& debugWhite,
+    const sf::Vector2f& position,
     const sf::Vector2f& normal,
     const sf::Vector2f& size,
     eol::MirrorComponent::MirrorType type)
@@ -541,7 +563,7 @@ Entity Game::createMirrorEntity(const sf::Vector2f& position,
 
     auto render = std::make_unique<eol::RenderComponent>();
     auto& sprite = render->getSprite();
-    sprite.setTexture(debugWhiteTexture_);
+    sprite.setTexture(debugWhite);
     sprite.setTextureRect({ {0,0}, {1,1} });
     sprite.setOrigin({ 0.5f, 0.5f });
     render->setTint(sf::Color(160, 210, 255, 220));
@@ -551,6 +573,7 @@ Entity Game::createMirrorEntity(const sf::Vector2f& position,
 }
 
 Entity Game::createLightSourceNode(
+    const sf::Texture& lightNode,
     const std::string& name,
     const sf::Vector2f& position,
     bool movable)
@@ -574,8 +597,8 @@ Entity Game::createLightSourceNode(
 
     auto render = std::make_unique<eol::RenderComponent>();
     auto& sprite = render->getSprite();
-    sprite.setTexture(lightNodeTexture_);
-    sf::Vector2u tex = lightNodeTexture_.getSize();
+    sprite.setTexture(lightNode);
+    sf::Vector2u tex = lightNode.getSize();
     sprite.setTextureRect({ {0,0}, sf::Vector2i(tex) });
     sprite.setOrigin({ tex.x * 0.5f, tex.y * 0.5f });
     render->setTint(movable ? sf::Color(255, 255, 200)
@@ -585,7 +608,7 @@ Entity Game::createLightSourceNode(
     return e;
 }
 
-Entity Game::createWallEntity(const sf::Vector2f& pos, const sf::Vector2f& size)
+Entity Game::createWallEntity(const sf::Texture& debugWhite, const sf::Vector2f& pos, const sf::Vector2f& size)
 {
     Entity e;
     e.name = "Wall";
@@ -602,7 +625,7 @@ Entity Game::createWallEntity(const sf::Vector2f& pos, const sf::Vector2f& size)
 
     auto render = std::make_unique<eol::RenderComponent>();
     auto& sprite = render->getSprite();
-    sprite.setTexture(debugWhiteTexture_);
+    sprite.setTexture(debugWhite);
     sprite.setTextureRect({ {0, 0}, {2, 2} });
     sprite.setOrigin({ 1.f, 1.f });
     sprite.setScale(sf::Vector2f(size.x * 0.5f, size.y * 0.5f));
@@ -634,13 +657,15 @@ Entity Game::createSpawnerEntity(const sf::Vector2f& position, float interval, i
 
 Entity Game::createEnemyAtPosition(const sf::Vector2f& position)
 {
-    // Create a standard enemy using existing function
-    Entity e = createEnemyEntity();
+    return instantiateEnemy(prefabs_, enemyPrefab_, position);
+}
 
-    // Override the position
-    if (auto* transform = e.getComponent<eol::TransformComponent>()) {
-        transform->setPosition(position);
-    }
+Entity Game::instantiateEnemy(const PrefabLibrary& prefabs, PrefabLibrary::PrefabId enemy,
+    const sf::Vector2f& position)
+{
+    PrefabOverrides at;
+    at.position = position;
+    Entity e = prefabs.instantiate(enemy, at);
 
     // Update patrol points to be around the spawn position
     if (auto* ai = e.getComponent<eol::EnemyAIComponent>()) {
@@ -657,28 +682,38 @@ Entity Game::createEnemyAtPosition(const sf::Vector2f& position)
 // =============================================================
 //   UPDATE (Scene system calls this)
 // =============================================================
-void Game::update(float dt, sf::RenderWindow& window)
+void Game::update(float dt, const InputFrame& input)
 {
+    // Trails the player by a frame; the camera only affects drawing
+    if (auto* transform = player_.getComponent<eol::TransformComponent>()) {
+        camera_.follow(transform->getPosition(), dt);
+    }
+
+    // Systems below only see entities in the chunks around the view
+    chunks_.update(camera_.getViewRect());
+    std::vector<Entity*>& active = chunks_.getActiveEntities();
+
     // Update dialog system first
-    dialogSystem_.update(dt);
+    dialogSystem_.update(dt, input);
 
     // Update interactive tutorial (checks for player actions)
     if (tutorialStep_ != TutorialStep::None && tutorialStep_ != TutorialStep::Complete) {
-        updateTutorial();
+        updateTutorial(input);
     }
 
     // Only update gameplay if dialog is not active (pauses game during dialog)
     if (!dialogSystem_.isActive()) {
-        inputSystem_.updateWithCollision(player_, dt, window, entities_);
-        animationSystem_.update(entities_, dt);
-        enemyAISystem_.update(entities_, dt, player_);
-        combatSystem_.updateMeleeAttacks(entities_, dt);
+        inputSystem_.updateWithCollision(player_, dt, input, active);
+        animationSystem_.update(active, dt);
+        enemyAISystem_.update(active, dt, player_);
+        combatSystem_.updateMeleeAttacks(active, dt);
 
         // Update spawners and add new enemies
-        std::vector<Entity> newEnemies = spawnerSystem_.update(entities_, dt);
+        std::vector<Entity> newEnemies = spawnerSystem_.update(active, dt);
         for (auto& enemy : newEnemies) {
             auto ptr = std::make_unique<Entity>(std::move(enemy));
             entities_.push_back(ptr.get());
+            chunks_.add(ptr.get());
             worldObjects_.push_back(std::move(ptr));
         }
 
@@ -750,7 +785,7 @@ void Game::update(float dt, sf::RenderWindow& window)
                         });
                 }
 
-                lightSystem_.update(entities_, dt, window);
+                lightSystem_.update(active, dt);
                 return;
             }
         }
@@ -762,7 +797,7 @@ void Game::update(float dt, sf::RenderWindow& window)
                 {"Guide", "The beacons shine bright! The path forward is open."},
                 {"Guide", "Make your way to the EXIT."}
                 });
-            lightSystem_.update(entities_, dt, window);
+            lightSystem_.update(active, dt);
             return;
         }
 
@@ -787,6 +822,7 @@ void Game::update(float dt, sf::RenderWindow& window)
                 beaconsPreviouslySolved_ = false; // Reset for new level
                 tutorialStep_ = TutorialStep::None;
                 lastBeaconHintShown_ = 0;  // Reset hints for new level
+                saveSnapshot(levelStartSnapshot_);
 
                 // Show era-specific transition dialog
                 int newLevel = levels_.getCurrentIndex();
@@ -830,24 +866,29 @@ void Game::update(float dt, sf::RenderWindow& window)
         }
     }
         // Light system updates regardless (for visual effects)
-        lightSystem_.update(entities_, dt, window);
+        lightSystem_.update(active, dt);
     }
 
 
 // =============================================================
 //   RENDER (Scene system calls this)
 // =============================================================
-void Game::render(sf::RenderWindow& window)
+void Game::render(sf::RenderWindow& window, ViewManager& views)
 {
-   
-    // Draw the map first (background layer)
-    const Map& map = levels_.getCurrentMap();
-    if (map.getWidth() > 0 && map.getHeight() > 0) {
-        map.draw(window, tileSize_, mapOffset_);
-    }
+    // World layers are drawn through the camera and culled to its view
+    views.setWorldCenter(camera_.getCenter());
+    window.setView(views.getWorldView());
+
+    // Draw the map first (background layer), from the awake chunks' meshes
+    chunks_.drawMap(window);
 
-    renderSystem_.render(window, entities_);
-    lightSystem_.render(window, entities_);
+    std::vector<Entity*>& active = chunks_.getActiveEntities();
+    renderSystem_.render(window, active);
+    lightSystem_.render(window, active);
+
+    // HUD and dialog are laid out in reference pixels and do not scroll
+    window.setView(views.getScaledView());
+    renderSystem_.renderHud(window, player_);
 
     // Render dialog on top of everything
     dialogSystem_.render(window);
@@ -866,6 +907,273 @@ unsigned int Game::getFramerateLimit() const
     return currentFramerate;
 }
 
+// =============================================================
+//   World snapshots
+// =============================================================
+void Game::saveSnapshot(WorldSnapshot& snapshot) const
+{
+    std::vector<std::uint8_t>& data = snapshot.getData();
+    data.clear();
+    SnapshotWriter out(data, entities_);
+
+    out.write(static_cast<std::int32_t>(levels_.getCurrentIndex()));
+    out.write(gameComplete_);
+    out.write(beaconsPreviouslySolved_);
+    out.write(static_cast<std::int32_t>(lastBeaconHintShown_));
+    out.write(tutorialStep_);
+    out.write(tutorialActionDetected_);
+
+    // Component and system state go in blocks so readSnapshotLayout can
+    // check the whole buffer without decoding them
+    out.write(static_cast<std::uint32_t>(entities_.size()));
+    for (const Entity* entity : entities_) {
+        out.writeString(entity->name);
+        out.write(static_cast<std::uint32_t>(entity->components.size()));
+        const std::size_t block = out.beginBlock();
+        for (const auto& component : entity->components) {
+            component->saveState(out);
+        }
+        out.endBlock(block);
+    }
+
+    std::size_t block = out.beginBlock();
+    lightSystem_.saveState(out);
+    out.endBlock(block);
+    block = out.beginBlock();
+    dialogSystem_.saveState(out);
+    out.endBlock(block);
+}
+
+bool Game::readSnapshotLayout(const WorldSnapshot& snapshot, SnapshotLayout& layout)
+{
+    // Nothing read here is an entity reference, so no entity list is needed
+    const std::vector<Entity*> noEntities;
+    SnapshotReader in(snapshot.getData(), noEntities);
+
+    layout.level = in.read<std::int32_t>();
+    in.read<bool>();                    // gameComplete_
+    in.read<bool>();                    // beaconsPreviouslySolved_
+    in.read<std::int32_t>();            // lastBeaconHintShown_
+    in.read<TutorialStep>();
+    in.read<bool>();                    // tutorialActionDetected_
+
+    const std::uint32_t entityCount = in.read<std::uint32_t>();
+    layout.componentCounts.clear();
+    std::string name;
+    for (std::uint32_t i = 0; i < entityCount && !in.hasFailed(); ++i) {
+        in.readString(name);
+        layout.componentCounts.push_back(in.read<std::uint32_t>());
+        in.skipBlock();
+    }
+
+    in.skipBlock();                     // light system
+    in.skipBlock();                     // dialog
+    return !in.hasFailed() && in.atEnd();
+}
+
+bool Game::snapshotFitsWorld(const SnapshotLayout& layout) const
+{
+    const std::size_t count = layout.componentCounts.size();
+    if (count < levelEntityCount_) {
+        return false;
+    }
+
+    // Entities the snapshot doesn't have must be spawned enemies, which
+    // matchEntityCount drops from the back of both lists
+    const std::size_t dropped = entities_.size() > count ? entities_.size() - count : 0;
+    if (dropped > worldObjects_.size()) {
+        return false;
+    }
+    for (std::size_t i = 1; i <= dropped; ++i) {
+        if (entities_[entities_.size() - i] != worldObjects_[worldObjects_.size() - i].get()) {
+            return false;
+        }
+    }
+
+    // Entities it has beyond ours are spawned as enemies
+    const Entity* enemy = prefabs_.getPrototype(enemyPrefab_);
+    const std::size_t enemyComponents = enemy ? enemy->components.size() : 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::size_t expected = i < entities_.size() ? entities_[i]->components.size() : enemyComponents;
+        if (layout.componentCounts[i] != expected) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Game::switchToLevel(int level)
+{
+    if (!levels_.loadLevelAt(level)) {
+        return false;
+    }
+    recalculateTileSize();
+    applyWallTextureForCurrentLevel();
+    createEntities();
+    return true;
+}
+
+bool Game::restoreSnapshot(const WorldSnapshot& snapshot)
+{
+    // Everything is checked before the world changes, so a refused
+    // snapshot leaves the game as it was
+    SnapshotLayout layout;
+    if (snapshot.empty() || !readSnapshotLayout(snapshot, layout)) {
+        EOL_LOG_ERROR << "Snapshot data is corrupt";
+        return false;
+    }
+
+    if (layout.level == levels_.getCurrentIndex()) {
+        if (!snapshotFitsWorld(layout)) {
+            EOL_LOG_ERROR << "Snapshot does not match the current level layout";
+            return false;
+        }
+        applySnapshot(snapshot, layout);
+        return true;
+    }
+
+    // Another level's entities only exist once it is built, so keep the
+    // current world to go back to in case the snapshot doesn't fit them
+    const int previousLevel = levels_.getCurrentIndex();
+    saveSnapshot(restoreRollback_);
+    if (!switchToLevel(layout.level)) {
+        EOL_LOG_ERROR << "Snapshot refers to level " << layout.level << " which cannot be loaded";
+        return false;
+    }
+
+    if (!snapshotFitsWorld(layout)) {
+        EOL_LOG_ERROR << "Snapshot does not match the layout of level " << layout.level;
+        SnapshotLayout rollback;
+        if (switchToLevel(previousLevel) && readSnapshotLayout(restoreRollback_, rollback)
+            && snapshotFitsWorld(rollback)) {
+            applySnapshot(restoreRollback_, rollback);
+        }
+        else {
+            EOL_LOG_ERROR << "Could not return to level " << previousLevel;
+        }
+        return false;
+    }
+
+    // Restarting now goes back to the start of the restored level
+    saveSnapshot(levelStartSnapshot_);
+    applySnapshot(snapshot, layout);
+    return true;
+}
+
+void Game::applySnapshot(const WorldSnapshot& snapshot, const SnapshotLayout& layout)
+{
+    // The reader resolves entity indices against entities_, so it has to
+    // have the snapshot's size before any component is read
+    matchEntityCount(layout.componentCounts.size());
+    SnapshotReader in(snapshot.getData(), entities_);
+
+    in.read<std::int32_t>();            // level, already switched to
+    in.read(gameComplete_);
+    in.read(beaconsPreviouslySolved_);
+    lastBeaconHintShown_ = in.read<std::int32_t>();
+    in.read(tutorialStep_);
+    in.read(tutorialActionDetected_);
+    in.read<std::uint32_t>();           // entity count, already matched
+
+    for (Entity* entity : entities_) {
+        in.readString(entity->name);
+        in.read<std::uint32_t>();
+        const std::size_t end = in.enterBlock();
+        for (auto& component : entity->components) {
+            component->loadState(in);
+        }
+        if (!in.leaveBlock(end)) {
+            EOL_LOG_WARNING << "Snapshot state of " << entity->name << " was written by a different build";
+        }
+    }
+
+    std::size_t end = in.enterBlock();
+    lightSystem_.loadState(in);
+    in.leaveBlock(end);
+    end = in.enterBlock();
+    dialogSystem_.loadState(in);
+    in.leaveBlock(end);
+
+    if (auto* transform = player_.getComponent<eol::TransformComponent>()) {
+        camera_.snapTo(transform->getPosition());
+    }
+    chunks_.assign(entities_);
+    chunks_.update(camera_.getViewRect());
+}
+
+void Game::matchEntityCount(std::size_t count)
+{
+    // Spawned enemies sit at the back of both lists in the same order
+    // (checked by snapshotFitsWorld)
+    while (entities_.size() > count) {
+        entities_.pop_back();
+        worldObjects_.pop_back();
+    }
+
+    // Their state is overwritten by the snapshot right after
+    while (entities_.size() < count) {
+        auto ptr = std::make_unique<Entity>(createEnemyAtPosition({ 0.f, 0.f }));
+        entities_.push_back(ptr.get());
+        worldObjects_.push_back(std::move(ptr));
+    }
+}
+
+bool Game::restartLevel()
+{
+    return restoreSnapshot(levelStartSnapshot_);
+}
+
+std::uint64_t Game::computeStateHash() const
+{
+    StateHasher hasher;
+    hasher.addInt(levels_.getCurrentIndex());
+    hasher.addBool(gameComplete_);
+    hasher.addInt(static_cast<int>(tutorialStep_));
+    hasher.addBool(dialogSystem_.isActive());
+    hasher.addInt(static_cast<std::int64_t>(entities_.size()));
+
+    // Only state the simulation owns - sprites and animation frames are
+    // presentation and may legitimately differ between builds
+    for (Entity* entity : entities_) {
+        if (!entity) continue;
+        hasher.addString(entity->name);
+
+        if (auto* transform = entity->getComponent<eol::TransformComponent>()) {
+            hasher.addVector(transform->getPosition());
+            hasher.addFloat(transform->getRotation());
+        }
+        if (auto* player = entity->getComponent<eol::PlayerComponent>()) {
+            hasher.addFloat(player->getHealth());
+            hasher.addInt(player->getFragments());
+            hasher.addBool(player->isCarrying());
+        }
+        if (auto* enemy = entity->getComponent<eol::EnemyComponent>()) {
+            hasher.addFloat(enemy->getHealth());
+        }
+        if (auto* ai = entity->getComponent<eol::EnemyAIComponent>()) {
+            hasher.addInt(static_cast<int>(ai->getState()));
+            hasher.addInt(static_cast<std::int64_t>(ai->getCurrentPatrolIndex()));
+            hasher.addVector(ai->getVelocity());
+        }
+        if (auto* emitter = entity->getComponent<eol::LightEmitterComponent>()) {
+            hasher.addVector(emitter->getDirection());
+            hasher.addBool(emitter->isTriggerHeld());
+        }
+        if (auto* mirror = entity->getComponent<eol::MirrorComponent>()) {
+            hasher.addVector(mirror->getNormal());
+        }
+        if (auto* puzzle = entity->getComponent<eol::PuzzleComponent>()) {
+            hasher.addBool(puzzle->isSolved());
+            hasher.addFloat(puzzle->getAccumulatedLight());
+        }
+        if (auto* spawner = entity->getComponent<eol::SpawnerComponent>()) {
+            hasher.addInt(spawner->getCurrentEnemies());
+        }
+    }
+
+    return hasher.getValue();
+}
+
 std::string Game::findResourcePath(const std::string& relative) const
 {
     const std::vector<std::string> paths = {
@@ -943,13 +1251,22 @@ void Game::recalculateTileSize()
     if (map.getWidth() > 0 && map.getHeight() > 0) {
         float tileSizeX = GameSettings::width() / static_cast<float>(map.getWidth());
         float tileSizeY = GameSettings::height() / static_cast<float>(map.getHeight());
-        tileSize_ = std::min(tileSizeX, tileSizeY);
+        tileSize_ = std::max(kMinTileSize, std::min(tileSizeX, tileSizeY));
 
-        // Calculate offset to center the map
+        // Calculate offset to center the map (maps larger than the screen start at 0)
         float mapPixelWidth = map.getWidth() * tileSize_;
         float mapPixelHeight = map.getHeight() * tileSize_;
-        mapOffset_.x = (GameSettings::width() - mapPixelWidth) / 2.f;
-        mapOffset_.y = (GameSettings::height() - mapPixelHeight) / 2.f;
+        mapOffset_.x = std::max(0.f, (GameSettings::width() - mapPixelWidth) / 2.f);
+        mapOffset_.y = std::max(0.f, (GameSettings::height() - mapPixelHeight) / 2.f);
+
+        // The screen, grown to the map along any axis the map overflows
+        const sf::FloatRect world(
+            sf::Vector2f{ 0.f, 0.f },
+            sf::Vector2f{ std::max(GameSettings::width(), mapOffset_.x + mapPixelWidth),
+                          std::max(GameSettings::height(), mapOffset_.y + mapPixelHeight) });
+        camera_.setWorldBounds(world);
+        inputSystem_.setWorldBounds(world);
+        enemyAISystem_.setWorldBounds(world);
     }
 }
 
@@ -993,7 +1310,7 @@ bool Game::allBeaconsJustSolved() {
     return false;
 }
 
-void Game::updateTutorial() {
+void Game::updateTutorial(const InputFrame& input) {
     // Don't check while dialog is showing - let player read first
     if (dialogSystem_.isActive()) {
         return;
@@ -1004,31 +1321,28 @@ void Game::updateTutorial() {
     switch (tutorialStep_) {
     case TutorialStep::WaitForMove:
         // Check if player pressed any movement key
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::W) ||
-            sf::Keyboard::isKeyPressed(sf::Keyboard::Key::A) ||
-            sf::Keyboard::isKeyPressed(sf::Keyboard::Key::S) ||
-            sf::Keyboard::isKeyPressed(sf::Keyboard::Key::D)) {
+    {
+        const bool moving =
+            input.isActive(InputAction::MoveUp) ||
+            input.isActive(InputAction::MoveLeft) ||
+            input.isActive(InputAction::MoveDown) ||
+            input.isActive(InputAction::MoveRight);
+        if (moving) {
             tutorialActionDetected_ = true;
         }
         // Only advance after key is released (confirms they actually tried it)
-        if (tutorialActionDetected_ &&
-            !sf::Keyboard::isKeyPressed(sf::Keyboard::Key::W) &&
-            !sf::Keyboard::isKeyPressed(sf::Keyboard::Key::A) &&
-            !sf::Keyboard::isKeyPressed(sf::Keyboard::Key::S) &&
-            !sf::Keyboard::isKeyPressed(sf::Keyboard::Key::D)) {
+        if (tutorialActionDetected_ && !moving) {
             actionPerformed = true;
         }
-        break;
+    }
+    break;
 
     case TutorialStep::WaitForShoot:
         // Check if player shot light
-        if (sf::Mouse::isButtonPressed(sf::Mouse::Button::Left) ||
-            sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Space)) {
+        if (input.isActive(InputAction::Fire)) {
             tutorialActionDetected_ = true;
         }
-        if (tutorialActionDetected_ &&
-            !sf::Mouse::isButtonPressed(sf::Mouse::Button::Left) &&
-            !sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Space)) {
+        if (tutorialActionDetected_ && !input.isActive(InputAction::Fire)) {
             actionPerformed = true;
         }
         break;
@@ -1060,7 +1374,7 @@ void Game::updateTutorial() {
 
     case TutorialStep::WaitForMirrorRotate:
         // Check if R key was pressed while carrying mirror
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::R)) {
+        if (input.isActive(InputAction::Rotate)) {
             auto* playerComp = player_.getComponent<eol::PlayerComponent>();
             if (playerComp && playerComp->isCarrying()) {
                 Entity* carried = playerComp->getCarriedEntity();
@@ -1069,7 +1383,7 @@ void Game::updateTutorial() {
                 }
             }
         }
-        if (tutorialActionDetected_ && !sf::Keyboard::isKeyPressed(sf::Keyboard::Key::R)) {
+        if (tutorialActionDetected_ && !input.isActive(InputAction::Rotate)) {
             actionPerformed = true;
         }
         break;
@@ -1099,7 +1413,7 @@ void Game::updateTutorial() {
 
     case TutorialStep::WaitForBeaconRotate:
         // Check if R key was pressed while carrying beacon
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::R)) {
+        if (input.isActive(InputAction::Rotate)) {
             auto* playerComp = player_.getComponent<eol::PlayerComponent>();
             if (playerComp && playerComp->isCarrying()) {
                 Entity* carried = playerComp->getCarriedEntity();
@@ -1108,7 +1422,7 @@ void Game::updateTutorial() {
                 }
             }
         }
-        if (tutorialActionDetected_ && !sf::Keyboard::isKeyPressed(sf::Keyboard::Key::R)) {
+        if (tutorialActionDetected_ && !input.isActive(InputAction::Rotate)) {
             actionPerformed = true;
         }
         break;
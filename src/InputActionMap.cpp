@@ -0,0 +1,157 @@
+#include "InputActionMap.h"
+#include <algorithm>
+
+InputActionMap::InputActionMap()
+{
+    resetToDefaults();
+}
+
+void InputActionMap::resetToDefaults()
+{
+    keyBindings.clear();
+    mouseBindings.clear();
+
+    bindKey(InputAction::MoveUp, sf::Keyboard::Key::W);
+    bindKey(InputAction::MoveDown, sf::Keyboard::Key::S);
+    bindKey(InputAction::MoveLeft, sf::Keyboard::Key::A);
+    bindKey(InputAction::MoveRight, sf::Keyboard::Key::D);
+    bindKey(InputAction::Fire, sf::Keyboard::Key::Space);
+    bindMouseButton(InputAction::Fire, sf::Mouse::Button::Left);
+    bindKey(InputAction::Interact, sf::Keyboard::Key::E);
+    bindKey(InputAction::Rotate, sf::Keyboard::Key::R);
+    bindKey(InputAction::Advance, sf::Keyboard::Key::Enter);
+}
+
+void InputActionMap::bindKey(InputAction action, sf::Keyboard::Key key)
+{
+    if (key == sf::Keyboard::Key::Unknown)
+        return;
+
+    keyBindings.push_back({ key, action });
+    refreshAction(action);
+}
+
+void InputActionMap::bindMouseButton(InputAction action, sf::Mouse::Button button)
+{
+    mouseBindings.push_back({ button, action });
+    refreshAction(action);
+}
+
+void InputActionMap::clearBindings(InputAction action)
+{
+    keyBindings.erase(
+        std::remove_if(keyBindings.begin(), keyBindings.end(),
+            [action](const KeyBinding& b) { return b.action == action; }),
+        keyBindings.end());
+
+    mouseBindings.erase(
+        std::remove_if(mouseBindings.begin(), mouseBindings.end(),
+            [action](const MouseBinding& b) { return b.action == action; }),
+        mouseBindings.end());
+
+    refreshAction(action);
+}
+
+void InputActionMap::handleEvent(const sf::Event& event)
+{
+    if (const auto* key = event.getIf<sf::Event::KeyPressed>())
+    {
+        setKeyState(key->code, true);
+    }
+    else if (const auto* key = event.getIf<sf::Event::KeyReleased>())
+    {
+        setKeyState(key->code, false);
+    }
+    else if (const auto* button = event.getIf<sf::Event::MouseButtonPressed>())
+    {
+        frame.cursor = button->position;
+        setMouseState(button->button, true);
+    }
+    else if (const auto* button = event.getIf<sf::Event::MouseButtonReleased>())
+    {
+        frame.cursor = button->position;
+        setMouseState(button->button, false);
+    }
+    else if (const auto* moved = event.getIf<sf::Event::MouseMoved>())
+    {
+        frame.cursor = moved->position;
+    }
+    else if (event.is<sf::Event::FocusLost>())
+    {
+        // Key-up events are not delivered while unfocused
+        releaseAll();
+    }
+}
+
+void InputActionMap::endFrame() noexcept
+{
+    frame.pressed = 0;
+    frame.released = 0;
+}
+
+void InputActionMap::releaseAll() noexcept
+{
+    keyDown.fill(false);
+    mouseDown.fill(false);
+
+    frame.released |= frame.held;
+    frame.held = 0;
+}
+
+void InputActionMap::setKeyState(sf::Keyboard::Key key, bool down)
+{
+    const int index = static_cast<int>(key);
+    if (index < 0 || index >= static_cast<int>(keyDown.size()))
+        return;
+
+    // Key repeat sends KeyPressed again while held - ignore it
+    if (keyDown[index] == down)
+        return;
+
+    keyDown[index] = down;
+    for (const KeyBinding& b : keyBindings)
+        if (b.key == key)
+            refreshAction(b.action);
+}
+
+void InputActionMap::setMouseState(sf::Mouse::Button button, bool down)
+{
+    const int index = static_cast<int>(button);
+    if (index < 0 || index >= static_cast<int>(mouseDown.size()))
+        return;
+
+    if (mouseDown[index] == down)
+        return;
+
+    mouseDown[index] = down;
+    for (const MouseBinding& b : mouseBindings)
+        if (b.button == button)
+            refreshAction(b.action);
+}
+
+void InputActionMap::refreshAction(InputAction action)
+{
+    // An action stays held while any of its bindings is down
+    bool down = false;
+    for (const KeyBinding& b : keyBindings)
+        if (b.action == action && keyDown[static_cast<int>(b.key)])
+            down = true;
+
+    for (const MouseBinding& b : mouseBindings)
+        if (b.action == action && mouseDown[static_cast<int>(b.button)])
+            down = true;
+
+    const std::uint16_t bit = InputFrame::bit(action);
+    const bool wasDown = (frame.held & bit) != 0;
+
+    if (down && !wasDown)
+    {
+        frame.held |= bit;
+        frame.pressed |= bit;
+    }
+    else if (!down && wasDown)
+    {
+        frame.held &= static_cast<std::uint16_t>(~bit);
+        frame.released |= bit;
+    }
+}
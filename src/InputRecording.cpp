@@ -0,0 +1,315 @@
+#include "InputRecording.h"
+#include "Log.h"
+#include <cstring>
+#include <iterator>
+
+namespace
+{
+    const char kMagic[4] = { 'E', 'O', 'L', 'R' };
+    constexpr std::uint16_t kVersion = 1;
+
+    constexpr std::uint8_t kFrameDt = 0x01;
+    constexpr std::uint8_t kFrameHeld = 0x02;
+    constexpr std::uint8_t kFramePressed = 0x04;
+    constexpr std::uint8_t kFrameReleased = 0x08;
+    constexpr std::uint8_t kFrameAim = 0x10;
+
+    constexpr std::uint8_t kTagCheckpoint = 0x80;
+    constexpr std::uint8_t kTagEnd = 0xFF;
+
+    // Fixed little-endian encoding so files move between machines
+    template <typename T>
+    void writeUnsigned(std::ostream& out, T value)
+    {
+        char bytes[sizeof(T)];
+        for (std::size_t i = 0; i < sizeof(T); ++i)
+            bytes[i] = static_cast<char>((static_cast<std::uint64_t>(value) >> (8 * i)) & 0xFF);
+        out.write(bytes, sizeof(T));
+    }
+
+    void writeFloat(std::ostream& out, float value)
+    {
+        std::uint32_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(bits));
+        writeUnsigned(out, bits);
+    }
+
+    // Bounds-checked reader over the loaded file
+    class ByteReader
+    {
+    public:
+        explicit ByteReader(const std::vector<char>& data) : data(data) {}
+
+        bool atEnd() const { return offset >= data.size(); }
+
+        template <typename T>
+        bool readUnsigned(T& value)
+        {
+            if (data.size() - offset < sizeof(T))
+                return false;
+
+            std::uint64_t result = 0;
+            for (std::size_t i = 0; i < sizeof(T); ++i)
+                result |= static_cast<std::uint64_t>(static_cast<unsigned char>(data[offset + i])) << (8 * i);
+
+            value = static_cast<T>(result);
+            offset += sizeof(T);
+            return true;
+        }
+
+        bool readFloat(float& value)
+        {
+            std::uint32_t bits = 0;
+            if (!readUnsigned(bits))
+                return false;
+            std::memcpy(&value, &bits, sizeof(value));
+            return true;
+        }
+
+    private:
+        const std::vector<char>& data;
+        std::size_t offset = 0;
+    };
+
+    bool sameBits(float a, float b)
+    {
+        return std::memcmp(&a, &b, sizeof(float)) == 0;
+    }
+}
+
+// --------------------------------------------------------
+// StateHasher
+// --------------------------------------------------------
+
+void StateHasher::addBytes(const void* data, std::size_t size)
+{
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        value ^= bytes[i];
+        value *= 1099511628211ull;
+    }
+}
+
+void StateHasher::addFloat(float value)
+{
+    std::uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    addBytes(&bits, sizeof(bits));
+}
+
+void StateHasher::addInt(std::int64_t value)
+{
+    addBytes(&value, sizeof(value));
+}
+
+void StateHasher::addString(const std::string& value)
+{
+    addInt(static_cast<std::int64_t>(value.size()));
+    addBytes(value.data(), value.size());
+}
+
+// --------------------------------------------------------
+// InputRecorder
+// --------------------------------------------------------
+
+InputRecorder::~InputRecorder()
+{
+    close();
+}
+
+bool InputRecorder::open(const std::string& path, int startLevel, std::uint32_t interval)
+{
+    close();
+
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+        EOL_LOG_ERROR << "Could not open recording file " << path;
+        return false;
+    }
+
+    previous = ReplayFrame{};
+    frameCount = 0;
+    checkpointInterval = interval;
+
+    file.write(kMagic, sizeof(kMagic));
+    writeUnsigned<std::uint16_t>(file, kVersion);
+    writeUnsigned<std::uint16_t>(file, 0);
+    writeUnsigned<std::uint32_t>(file, static_cast<std::uint32_t>(startLevel));
+    writeUnsigned<std::uint32_t>(file, checkpointInterval);
+
+    EOL_LOG_INFO << "Recording input to " << path;
+    return true;
+}
+
+void InputRecorder::recordFrame(float dt, const InputFrame& input)
+{
+    if (!file.is_open())
+        return;
+
+    // Most frames only differ in dt, so unchanged fields are left out
+    std::uint8_t tag = 0;
+    if (frameCount == 0 || !sameBits(dt, previous.dt))
+        tag |= kFrameDt;
+    if (input.held != previous.input.held)
+        tag |= kFrameHeld;
+    if (input.pressed != previous.input.pressed)
+        tag |= kFramePressed;
+    if (input.released != previous.input.released)
+        tag |= kFrameReleased;
+    if (!sameBits(input.aim.x, previous.input.aim.x) || !sameBits(input.aim.y, previous.input.aim.y))
+        tag |= kFrameAim;
+
+    writeUnsigned(file, tag);
+    if (tag & kFrameDt)
+        writeFloat(file, dt);
+    if (tag & kFrameHeld)
+        writeUnsigned(file, input.held);
+    if (tag & kFramePressed)
+        writeUnsigned(file, input.pressed);
+    if (tag & kFrameReleased)
+        writeUnsigned(file, input.released);
+    if (tag & kFrameAim)
+    {
+        writeFloat(file, input.aim.x);
+        writeFloat(file, input.aim.y);
+    }
+
+    previous.dt = dt;
+    previous.input = input;
+    ++frameCount;
+}
+
+bool InputRecorder::isCheckpointDue() const noexcept
+{
+    return file.is_open()
+        && checkpointInterval > 0
+        && frameCount > 0
+        && frameCount % checkpointInterval == 0;
+}
+
+void InputRecorder::recordCheckpoint(std::uint64_t hash)
+{
+    if (!file.is_open())
+        return;
+
+    writeUnsigned(file, kTagCheckpoint);
+    writeUnsigned(file, hash);
+}
+
+void InputRecorder::close()
+{
+    if (!file.is_open())
+        return;
+
+    writeUnsigned(file, kTagEnd);
+    writeUnsigned(file, frameCount);
+    file.close();
+
+    EOL_LOG_INFO << "Recording finished: " << frameCount << " frames";
+}
+
+// --------------------------------------------------------
+// InputReplay
+// --------------------------------------------------------
+
+bool InputReplay::load(const std::string& path)
+{
+    frames.clear();
+    checkpoints.clear();
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        EOL_LOG_ERROR << "Could not open replay file " << path;
+        return false;
+    }
+
+    const std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    ByteReader reader(data);
+
+    if (data.size() < sizeof(kMagic) || std::memcmp(data.data(), kMagic, sizeof(kMagic)) != 0)
+    {
+        EOL_LOG_ERROR << path << " is not an input recording";
+        return false;
+    }
+
+    std::uint32_t magic = 0;
+    std::uint16_t version = 0;
+    std::uint16_t reserved = 0;
+    std::uint32_t level = 0;
+    if (!reader.readUnsigned(magic) || !reader.readUnsigned(version) || !reader.readUnsigned(reserved) ||
+        !reader.readUnsigned(level) || !reader.readUnsigned(checkpointInterval))
+    {
+        EOL_LOG_ERROR << "Truncated replay header in " << path;
+        return false;
+    }
+
+    if (version != kVersion)
+    {
+        EOL_LOG_ERROR << "Unsupported replay version " << version << " in " << path;
+        return false;
+    }
+    startLevel = static_cast<int>(level);
+
+    ReplayFrame current;
+    bool ended = false;
+    bool valid = true;
+    bool corrupt = false;
+    while (valid && !ended && !reader.atEnd())
+    {
+        std::uint8_t tag = 0;
+        reader.readUnsigned(tag);
+
+        if (tag == kTagCheckpoint)
+        {
+            ReplayCheckpoint checkpoint;
+            checkpoint.frame = static_cast<std::uint32_t>(frames.size());
+            valid = reader.readUnsigned(checkpoint.hash);
+            if (valid)
+                checkpoints.push_back(checkpoint);
+        }
+        else if (tag == kTagEnd)
+        {
+            std::uint32_t count = 0;
+            valid = reader.readUnsigned(count) && count == frames.size();
+            ended = true;
+        }
+        else if (tag < kTagCheckpoint)
+        {
+            if (tag & kFrameDt)
+                valid = valid && reader.readFloat(current.dt);
+            if (tag & kFrameHeld)
+                valid = valid && reader.readUnsigned(current.input.held);
+            if (tag & kFramePressed)
+                valid = valid && reader.readUnsigned(current.input.pressed);
+            if (tag & kFrameReleased)
+                valid = valid && reader.readUnsigned(current.input.released);
+            if (tag & kFrameAim)
+                valid = valid && reader.readFloat(current.input.aim.x) && reader.readFloat(current.input.aim.y);
+            if (valid)
+                frames.push_back(current);
+        }
+        else
+        {
+            valid = false;
+            corrupt = true;
+        }
+    }
+
+    if (corrupt || (ended && !valid))
+    {
+        EOL_LOG_ERROR << "Corrupt replay data in " << path << " after " << frames.size() << " frames";
+        return false;
+    }
+
+    // No end marker (or a cut-off last record) means the session was killed;
+    // keep every complete frame that made it to disk
+    if (!ended)
+        EOL_LOG_WARNING << "Replay " << path << " is truncated (" << frames.size() << " frames)";
+
+    EOL_LOG_INFO << "Loaded replay " << path << ": " << frames.size() << " frames, "
+              << checkpoints.size() << " checkpoints";
+    return true;
+}
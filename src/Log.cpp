@@ -0,0 +1,195 @@
+#include "Log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+namespace
+{
+    constexpr std::size_t kMask = Logger::kCapacity - 1;
+    static_assert((Logger::kCapacity & kMask) == 0, "Logger capacity must be a power of two");
+
+    constexpr auto kIdleSleep = std::chrono::milliseconds(2);
+
+    const char* levelPrefix(LogLevel level)
+    {
+        switch (level)
+        {
+        case LogLevel::Debug:   return "DEBUG: ";
+        case LogLevel::Warning: return "WARNING: ";
+        case LogLevel::Error:   return "ERROR: ";
+        case LogLevel::Info:
+        default:                return "";
+        }
+    }
+
+    void appendLine(std::string& out, LogLevel level, const char* text, std::size_t length)
+    {
+        out += levelPrefix(level);
+        out.append(text, length);
+        out += '\n';
+    }
+}
+
+Logger& Logger::instance()
+{
+    // Never destroyed: statics may still log while the process exits
+    static Logger* logger = []()
+        {
+            auto* created = new Logger();
+            std::atexit([]() { Logger::instance().shutdown(); });
+            return created;
+        }();
+    return *logger;
+}
+
+Logger::Logger()
+{
+    for (std::size_t i = 0; i < kCapacity; ++i)
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+
+    running.store(true, std::memory_order_release);
+    writer = std::thread([this]() { run(); });
+}
+
+void Logger::setMinLevel(LogLevel level) noexcept
+{
+    minLevel.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+void Logger::write(LogLevel level, const std::string& message)
+{
+    if (!isEnabled(level))
+        return;
+
+    if (!running.load(std::memory_order_acquire))
+    {
+        std::string out;
+        appendLine(out, level, message.data(), message.size());
+        std::ostream& stream = level >= LogLevel::Warning ? std::cerr : std::cout;
+        stream << out;
+        stream.flush();
+        return;
+    }
+
+    // One slot per line; a trailing newline does not add an empty line
+    std::size_t start = 0;
+    for (;;)
+    {
+        std::size_t end = message.find('\n', start);
+        if (end == std::string::npos)
+            end = message.size();
+
+        pushLine(level, message.data() + start, end - start);
+        start = end + 1;
+        if (start >= message.size())
+            break;
+    }
+}
+
+void Logger::pushLine(LogLevel level, const char* text, std::size_t length)
+{
+    // Bounded MPMC ring (Vyukov): each slot's sequence says whose turn it is
+    std::size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+    for (;;)
+    {
+        slot = &slots[pos & kMask];
+        const std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+        if (diff == 0)
+        {
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (diff < 0)
+        {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        else
+        {
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    const std::size_t kept = std::min(length, kMaxLineLength);
+    std::memcpy(slot->text, text, kept);
+    slot->length = static_cast<std::uint16_t>(kept);
+    slot->level = level;
+    slot->sequence.store(pos + 1, std::memory_order_release);
+}
+
+// Writer side only. Returns false when there was nothing to write.
+bool Logger::drain()
+{
+    std::string out;
+    std::string err;
+
+    std::size_t pos = dequeuePos.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        Slot& slot = slots[pos & kMask];
+        if (slot.sequence.load(std::memory_order_acquire) != pos + 1)
+            break;
+
+        appendLine(slot.level >= LogLevel::Warning ? err : out, slot.level, slot.text, slot.length);
+        slot.sequence.store(pos + kCapacity, std::memory_order_release);
+        ++pos;
+        dequeuePos.store(pos, std::memory_order_release);
+    }
+
+    const std::uint64_t droppedNow = dropped.load(std::memory_order_relaxed);
+    if (droppedNow != droppedReported)
+    {
+        const std::string note = std::to_string(droppedNow - droppedReported) + " log lines dropped (queue full)";
+        appendLine(err, LogLevel::Warning, note.data(), note.size());
+        droppedReported = droppedNow;
+    }
+
+    if (!out.empty())
+    {
+        std::cout << out;
+        std::cout.flush();
+    }
+    if (!err.empty())
+    {
+        std::cerr << err;
+        std::cerr.flush();
+    }
+    return !out.empty() || !err.empty();
+}
+
+void Logger::run()
+{
+    while (running.load(std::memory_order_acquire))
+    {
+        if (!drain())
+            std::this_thread::sleep_for(kIdleSleep);
+    }
+}
+
+void Logger::flush()
+{
+    if (!running.load(std::memory_order_acquire))
+        return;
+
+    const std::size_t target = enqueuePos.load(std::memory_order_acquire);
+    while (dequeuePos.load(std::memory_order_acquire) < target &&
+           running.load(std::memory_order_acquire))
+    {
+        std::this_thread::yield();
+    }
+}
+
+void Logger::shutdown()
+{
+    if (!running.exchange(false, std::memory_order_acq_rel))
+        return;
+
+    if (writer.joinable())
+        writer.join();
+    drain();
+}
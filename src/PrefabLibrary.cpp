@@ -0,0 +1,471 @@
+#include "PrefabLibrary.h"
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include "components/AnimationComponent.h"
+#include "components/CollisionComponent.h"
+#include "components/EnemyAIComponent.h"
+#include "components/EnemyComponent.h"
+#include "components/HitboxComponent.h"
+#include "components/LightComponent.h"
+#include "components/LightEmitterComponent.h"
+#include "components/LightSourceComponent.h"
+#include "components/MeleeAttackComponent.h"
+#include "components/MirrorComponent.h"
+#include "components/PlayerComponent.h"
+#include "components/PuzzleComponent.h"
+#include "components/RenderComponent.h"
+#include "components/SpawnerComponent.h"
+#include "components/TransformComponent.h"
+#include "components/UpgradeComponent.h"
+#include "Log.h"
+
+namespace
+{
+    // --------------------------------------------------------
+    // Value parsing
+    // --------------------------------------------------------
+
+    // Comma separated floats; the count must fall within [minCount, maxCount]
+    bool parseFloats(const std::string& text, float* out, std::size_t minCount, std::size_t maxCount)
+    {
+        std::size_t count = 0;
+        const char* cursor = text.c_str();
+        while (*cursor)
+        {
+            if (count == maxCount)
+                return false;
+
+            char* end = nullptr;
+            out[count] = std::strtof(cursor, &end);
+            if (end == cursor)
+                return false;
+            ++count;
+
+            cursor = end;
+            if (*cursor == ',')
+                ++cursor;
+            else if (*cursor)
+                return false;
+        }
+        return count >= minCount;
+    }
+
+    bool parseFloat(const std::string& text, float& value)
+    {
+        return parseFloats(text, &value, 1, 1);
+    }
+
+    bool parseVector(const std::string& text, sf::Vector2f& value)
+    {
+        float v[2];
+        if (!parseFloats(text, v, 2, 2))
+            return false;
+        value = { v[0], v[1] };
+        return true;
+    }
+
+    bool parseUnsigned(const std::string& text, unsigned int& value)
+    {
+        float v = 0.f;
+        if (!parseFloat(text, v) || v < 0.f)
+            return false;
+        value = static_cast<unsigned int>(v);
+        return true;
+    }
+
+    bool parseBool(const std::string& text, bool& value)
+    {
+        if (text == "true" || text == "1")
+            value = true;
+        else if (text == "false" || text == "0")
+            value = false;
+        else
+            return false;
+        return true;
+    }
+
+    bool parseColor(const std::string& text, sf::Color& value)
+    {
+        float v[4] = { 0.f, 0.f, 0.f, 255.f };
+        if (!parseFloats(text, v, 3, 4))
+            return false;
+        value = sf::Color(static_cast<std::uint8_t>(v[0]), static_cast<std::uint8_t>(v[1]),
+            static_cast<std::uint8_t>(v[2]), static_cast<std::uint8_t>(v[3]));
+        return true;
+    }
+
+    bool parseRect(const std::string& text, sf::IntRect& value)
+    {
+        float v[4];
+        if (!parseFloats(text, v, 4, 4))
+            return false;
+        value = sf::IntRect({ static_cast<int>(v[0]), static_cast<int>(v[1]) },
+            { static_cast<int>(v[2]), static_cast<int>(v[3]) });
+        return true;
+    }
+
+    // --------------------------------------------------------
+    // Components by name
+    // --------------------------------------------------------
+
+    eol::ComponentPtr createComponent(const std::string& name)
+    {
+        if (name == "Transform")    return std::make_unique<eol::TransformComponent>();
+        if (name == "Render")       return std::make_unique<eol::RenderComponent>();
+        if (name == "Animation")    return std::make_unique<eol::AnimationComponent>();
+        if (name == "Collision")    return std::make_unique<eol::CollisionComponent>();
+        if (name == "Hitbox")       return std::make_unique<eol::HitboxComponent>();
+        if (name == "Player")       return std::make_unique<eol::PlayerComponent>();
+        if (name == "Upgrade")      return std::make_unique<eol::UpgradeComponent>();
+        if (name == "Enemy")        return std::make_unique<eol::EnemyComponent>();
+        if (name == "EnemyAI")      return std::make_unique<eol::EnemyAIComponent>();
+        if (name == "MeleeAttack")  return std::make_unique<eol::MeleeAttackComponent>();
+        if (name == "Light")        return std::make_unique<eol::LightComponent>();
+        if (name == "LightEmitter") return std::make_unique<eol::LightEmitterComponent>();
+        if (name == "LightSource")  return std::make_unique<eol::LightSourceComponent>();
+        if (name == "Mirror")       return std::make_unique<eol::MirrorComponent>();
+        if (name == "Puzzle")       return std::make_unique<eol::PuzzleComponent>();
+        if (name == "Spawner")      return std::make_unique<eol::SpawnerComponent>();
+        return nullptr;
+    }
+
+    // Returns false for unknown keys and unparsable values
+    bool applyProperty(eol::Component& component, const std::string& key, const std::string& value,
+        const PrefabLibrary::TextureResolver& resolveTexture)
+    {
+        float f = 0.f;
+        unsigned int u = 0;
+        bool b = false;
+        sf::Vector2f v;
+        sf::Color c;
+
+        if (key == "enabled" && parseBool(value, b))
+        {
+            component.setEnabled(b);
+            return true;
+        }
+
+        if (auto* t = dynamic_cast<eol::TransformComponent*>(&component))
+        {
+            if (key == "position" && parseVector(value, v)) { t->setPosition(v); return true; }
+            if (key == "scale" && parseVector(value, v))    { t->setScale(v); return true; }
+            if (key == "rotation" && parseFloat(value, f))  { t->setRotation(f); return true; }
+        }
+        else if (auto* r = dynamic_cast<eol::RenderComponent*>(&component))
+        {
+            sf::Sprite& sprite = r->getSprite();
+            sf::IntRect rect;
+            if (key == "texture")
+            {
+                const sf::Texture* texture = resolveTexture ? resolveTexture(value) : nullptr;
+                if (!texture)
+                    return false;
+                sprite.setTexture(*texture, true);
+                r->setTextureId(value);
+                return true;
+            }
+            if (key == "tint" && parseColor(value, c))  { r->setTint(c); return true; }
+            if (key == "rect" && parseRect(value, rect)) { sprite.setTextureRect(rect); return true; }
+            if (key == "origin" && parseVector(value, v)) { sprite.setOrigin(v); return true; }
+            if (key == "scale" && parseVector(value, v))  { sprite.setScale(v); return true; }
+        }
+        else if (auto* col = dynamic_cast<eol::CollisionComponent*>(&component))
+        {
+            if (key == "size" && parseVector(value, v)) { col->setBoundingBox(v); return true; }
+            if (key == "solid" && parseBool(value, b))  { col->setSolid(b); return true; }
+        }
+        else if (auto* h = dynamic_cast<eol::HitboxComponent*>(&component))
+        {
+            if (key == "size" && parseVector(value, v)) { h->setSize(v); return true; }
+        }
+        else if (auto* e = dynamic_cast<eol::EnemyComponent*>(&component))
+        {
+            if (key == "health" && parseFloat(value, f))      { e->setHealth(f); return true; }
+            if (key == "maxHealth" && parseFloat(value, f))   { e->setMaxHealth(f); return true; }
+            if (key == "resistance" && parseFloat(value, f))  { e->setResistance(f); return true; }
+            if (key == "awareness" && parseFloat(value, f))   { e->setAwarenessRadius(f); return true; }
+            if (key == "blocksLight" && parseBool(value, b))  { e->setBlocksLight(b); return true; }
+        }
+        else if (auto* ai = dynamic_cast<eol::EnemyAIComponent*>(&component))
+        {
+            if (key == "detectionRange" && parseFloat(value, f)) { ai->setDetectionRange(f); return true; }
+            if (key == "attackRange" && parseFloat(value, f))    { ai->setAttackRange(f); return true; }
+            if (key == "moveSpeed" && parseFloat(value, f))      { ai->setMoveSpeed(f); return true; }
+            if (key == "active" && parseBool(value, b))          { ai->setActive(b); return true; }
+        }
+        else if (auto* m = dynamic_cast<eol::MeleeAttackComponent*>(&component))
+        {
+            if (key == "damage" && parseFloat(value, f))   { m->setDamage(f); return true; }
+            if (key == "range" && parseFloat(value, f))    { m->setRange(f); return true; }
+            if (key == "cooldown" && parseFloat(value, f)) { m->setCooldown(f); return true; }
+        }
+        else if (auto* l = dynamic_cast<eol::LightComponent*>(&component))
+        {
+            if (key == "radius" && parseFloat(value, f))        { l->setRadius(f); return true; }
+            if (key == "intensity" && parseFloat(value, f))     { l->setIntensity(f); return true; }
+            if (key == "baseIntensity" && parseFloat(value, f)) { l->setBaseIntensity(f); return true; }
+            if (key == "decayRate" && parseFloat(value, f))     { l->setDecayRate(f); return true; }
+            if (key == "decayDelay" && parseFloat(value, f))    { l->setDecayDelay(f); return true; }
+            if (key == "weaponized" && parseBool(value, b))     { l->setWeaponized(b); return true; }
+        }
+        else if (auto* em = dynamic_cast<eol::LightEmitterComponent*>(&component))
+        {
+            if (key == "direction" && parseVector(value, v))     { em->setDirection(v); return true; }
+            if (key == "beamLength" && parseFloat(value, f))     { em->setBeamLength(f); return true; }
+            if (key == "beamWidth" && parseFloat(value, f))      { em->setBeamWidth(f); return true; }
+            if (key == "damage" && parseFloat(value, f))         { em->setDamage(f); return true; }
+            if (key == "cooldown" && parseFloat(value, f))       { em->setCooldown(f); return true; }
+            if (key == "beamDuration" && parseFloat(value, f))   { em->setBeamDuration(f); return true; }
+            if (key == "energyCost" && parseFloat(value, f))     { em->setEnergyCost(f); return true; }
+            if (key == "maxReflections" && parseUnsigned(value, u)) { em->setMaxReflections(u); return true; }
+            if (key == "continuous" && parseBool(value, b))      { em->setContinuousFire(b); return true; }
+            if (key == "color" && parseColor(value, c))          { em->setBeamColor(c); return true; }
+        }
+        else if (auto* src = dynamic_cast<eol::LightSourceComponent*>(&component))
+        {
+            if (key == "movable" && parseBool(value, b)) { src->setMovable(b); return true; }
+            if (key == "active" && parseBool(value, b))  { src->setActive(b); return true; }
+            if (key == "fuel" && parseFloat(value, f))   { src->setFuel(f); return true; }
+        }
+        else if (auto* mir = dynamic_cast<eol::MirrorComponent*>(&component))
+        {
+            using MirrorType = eol::MirrorComponent::MirrorType;
+            if (key == "normal" && parseVector(value, v))         { mir->setNormal(v); return true; }
+            if (key == "size" && parseVector(value, v))           { mir->setSize(v); return true; }
+            if (key == "reflectionLoss" && parseFloat(value, f))  { mir->setReflectionLoss(f); return true; }
+            if (key == "pickable" && parseBool(value, b))         { mir->setPickable(b); return true; }
+            if (key == "active" && parseBool(value, b))           { mir->setActive(b); return true; }
+            if (key == "type")
+            {
+                if (value == "Flat")          mir->setType(MirrorType::Flat);
+                else if (value == "Splitter") mir->setType(MirrorType::Splitter);
+                else if (value == "Prism")    mir->setType(MirrorType::Prism);
+                else return false;
+                return true;
+            }
+        }
+        else if (auto* p = dynamic_cast<eol::PuzzleComponent*>(&component))
+        {
+            using Requirement = eol::PuzzleComponent::LightRequirement;
+            if (key == "requiredLight" && parseUnsigned(value, u))   { p->setRequiredLight(u); return true; }
+            if (key == "requiredSources" && parseUnsigned(value, u)) { p->setRequiredUniqueSources(u); return true; }
+            if (key == "requirement")
+            {
+                if (value == "Any")             p->setLightRequirement(Requirement::Any);
+                else if (value == "PlayerOnly") p->setLightRequirement(Requirement::PlayerOnly);
+                else if (value == "BeaconOnly") p->setLightRequirement(Requirement::BeaconOnly);
+                else return false;
+                return true;
+            }
+        }
+        else if (auto* s = dynamic_cast<eol::SpawnerComponent*>(&component))
+        {
+            if (key == "interval" && parseFloat(value, f))      { s->setSpawnInterval(f); return true; }
+            if (key == "maxEnemies" && parseUnsigned(value, u)) { s->setMaxEnemies(static_cast<int>(u)); return true; }
+            if (key == "active" && parseBool(value, b))         { s->setActive(b); return true; }
+        }
+
+        return false;
+    }
+
+}
+
+// --------------------------------------------------------
+// Definition and lookup
+// --------------------------------------------------------
+
+PrefabLibrary::PrefabId PrefabLibrary::define(const std::string& name, Entity prototype)
+{
+    const auto it = ids.find(name);
+    if (it != ids.end())
+    {
+        prototypes[it->second] = std::move(prototype);
+        return it->second;
+    }
+
+    const PrefabId id = prototypes.size();
+    prototypes.push_back(std::move(prototype));
+    ids.emplace(name, id);
+    return id;
+}
+
+PrefabLibrary::PrefabId PrefabLibrary::find(const std::string& name) const
+{
+    const auto it = ids.find(name);
+    return it != ids.end() ? it->second : InvalidPrefab;
+}
+
+const Entity* PrefabLibrary::getPrototype(PrefabId id) const
+{
+    return id < prototypes.size() ? &prototypes[id] : nullptr;
+}
+
+void PrefabLibrary::setTextureResolver(TextureResolver resolver)
+{
+    textureResolver = std::move(resolver);
+}
+
+void PrefabLibrary::clear()
+{
+    prototypes.clear();
+    ids.clear();
+}
+
+// --------------------------------------------------------
+// Instancing
+// --------------------------------------------------------
+
+Entity PrefabLibrary::instantiate(PrefabId id, const PrefabOverrides& overrides) const
+{
+    Entity e;
+    const Entity* prototype = getPrototype(id);
+    if (!prototype)
+    {
+        EOL_LOG_ERROR << "Unknown prefab id " << id;
+        return e;
+    }
+
+    e.name = overrides.name ? *overrides.name : prototype->name;
+    e.components.reserve(prototype->components.size());
+    for (const auto& component : prototype->components)
+        e.components.push_back(component->clone());
+
+    if (overrides.position)
+        if (auto* transform = e.getComponent<eol::TransformComponent>())
+            transform->setPosition(*overrides.position);
+
+    if (overrides.size)
+    {
+        const sf::Vector2f size = *overrides.size;
+        if (auto* collision = e.getComponent<eol::CollisionComponent>())
+            collision->setBoundingBox(size);
+
+        // Stretch the sprite so its texture rect covers the new size
+        if (auto* render = e.getComponent<eol::RenderComponent>())
+        {
+            sf::Sprite& sprite = render->getSprite();
+            const sf::IntRect rect = sprite.getTextureRect();
+            if (rect.size.x != 0 && rect.size.y != 0)
+                sprite.setScale({ size.x / rect.size.x, size.y / rect.size.y });
+        }
+    }
+
+    if (overrides.requiredSources)
+        if (auto* puzzle = e.getComponent<eol::PuzzleComponent>())
+            puzzle->setRequiredUniqueSources(*overrides.requiredSources);
+
+    return e;
+}
+
+Entity PrefabLibrary::instantiate(const std::string& name, const PrefabOverrides& overrides) const
+{
+    const PrefabId id = find(name);
+    if (id == InvalidPrefab)
+    {
+        EOL_LOG_ERROR << "Unknown prefab " << name;
+        return Entity{};
+    }
+    return instantiate(id, overrides);
+}
+
+// --------------------------------------------------------
+// Data files
+// --------------------------------------------------------
+
+bool PrefabLibrary::loadFromFile(const std::string& path)
+{
+    std::ifstream file(path);
+    if (!file)
+        return true;
+
+    Entity* current = nullptr;
+    std::string line;
+    int lineNumber = 0;
+    int errors = 0;
+
+    while (std::getline(file, line))
+    {
+        ++lineNumber;
+
+        const std::size_t comment = line.find('#');
+        if (comment != std::string::npos)
+            line.erase(comment);
+
+        std::istringstream tokens(line);
+        std::string head;
+        if (!(tokens >> head))
+            continue;
+
+        if (head == "prefab")
+        {
+            std::string name;
+            tokens >> name;
+            const PrefabId id = find(name);
+            current = id != InvalidPrefab ? &prototypes[id] : nullptr;
+            if (!current)
+            {
+                EOL_LOG_ERROR << path << ":" << lineNumber << ": unknown prefab '" << name << "'";
+                ++errors;
+            }
+            continue;
+        }
+
+        // Lines under an unknown prefab were already reported with it
+        if (!current)
+            continue;
+
+        if (!applyLine(*current, line, path, lineNumber))
+            ++errors;
+    }
+
+    EOL_LOG_INFO << "Loaded prefab data from " << path << (errors ? " with errors" : "");
+    return errors == 0;
+}
+
+bool PrefabLibrary::applyLine(Entity& prototype, const std::string& line, const std::string& path, int lineNumber)
+{
+    std::istringstream tokens(line);
+    std::string componentName;
+    tokens >> componentName;
+
+    eol::Component* component = nullptr;
+    for (auto& existing : prototype.components)
+    {
+        if (existing->getName() == componentName)
+        {
+            component = existing.get();
+            break;
+        }
+    }
+
+    if (!component)
+    {
+        eol::ComponentPtr created = createComponent(componentName);
+        if (!created)
+        {
+            EOL_LOG_ERROR << path << ":" << lineNumber << ": unknown component '" << componentName << "'";
+            return false;
+        }
+        component = created.get();
+        prototype.components.push_back(std::move(created));
+    }
+
+    bool ok = true;
+    std::string pair;
+    while (tokens >> pair)
+    {
+        const std::size_t eq = pair.find('=');
+        const std::string key = pair.substr(0, eq);
+        const std::string value = eq != std::string::npos ? pair.substr(eq + 1) : std::string();
+
+        if (!applyProperty(*component, key, value, textureResolver))
+        {
+            EOL_LOG_ERROR << path << ":" << lineNumber << ": bad property '" << pair
+                << "' for " << componentName;
+            ok = false;
+        }
+    }
+    return ok;
+}
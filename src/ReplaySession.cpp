@@ -0,0 +1,148 @@
+#include "ReplaySession.h"
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+#include <sstream>
+#include <utility>
+#include "Game.h"
+#include "Log.h"
+
+ReplaySession::ReplaySession(InputReplay replay)
+    : replay(std::move(replay))
+{
+    updateTimesMs.reserve(this->replay.getFrames().size());
+}
+
+bool ReplaySession::step(Game& game)
+{
+    // Checkpoints recorded before the first update cover level loading
+    if (nextFrame == 0)
+        verifyCheckpoints(game);
+
+    if (isFinished())
+        return false;
+
+    const ReplayFrame& frame = replay.getFrames()[nextFrame];
+
+    const auto start = std::chrono::steady_clock::now();
+    game.update(frame.dt, frame.input);
+    const auto end = std::chrono::steady_clock::now();
+    updateTimesMs.push_back(std::chrono::duration<float, std::milli>(end - start).count());
+
+    ++nextFrame;
+    verifyCheckpoints(game);
+    return true;
+}
+
+void ReplaySession::verifyCheckpoints(Game& game)
+{
+    const auto& checkpoints = replay.getCheckpoints();
+    while (nextCheckpoint < checkpoints.size() && checkpoints[nextCheckpoint].frame <= nextFrame)
+    {
+        const ReplayCheckpoint& checkpoint = checkpoints[nextCheckpoint++];
+        const std::uint64_t actual = game.computeStateHash();
+        ++verified;
+
+        if (actual != checkpoint.hash)
+        {
+            // Report the first few divergences only, later ones are usually knock-on
+            if (mismatches < 5)
+            {
+                EOL_LOG_ERROR << "Replay desync at frame " << checkpoint.frame
+                          << ": expected " << std::hex << checkpoint.hash
+                          << " got " << actual << std::dec;
+            }
+            ++mismatches;
+        }
+
+        if (rollbackCheck)
+        {
+            const auto saveStart = std::chrono::steady_clock::now();
+            game.saveSnapshot(snapshot);
+            const auto restoreStart = std::chrono::steady_clock::now();
+            const bool restored = game.restoreSnapshot(snapshot);
+            const auto restoreEnd = std::chrono::steady_clock::now();
+
+            snapshotTimesMs.push_back(std::chrono::duration<float, std::milli>(restoreStart - saveStart).count());
+            restoreTimesMs.push_back(std::chrono::duration<float, std::milli>(restoreEnd - restoreStart).count());
+
+            if (!restored || game.computeStateHash() != actual)
+            {
+                if (rollbackFailures < 5)
+                    EOL_LOG_ERROR << "Snapshot round trip changed state at frame " << checkpoint.frame;
+                ++rollbackFailures;
+            }
+        }
+    }
+}
+
+void ReplaySession::printReport(std::ostream& out) const
+{
+    out << "=== Replay report ===\n";
+    out << "Frames played:        " << nextFrame << " / " << replay.getFrames().size() << "\n";
+
+    if (!updateTimesMs.empty())
+    {
+        std::vector<float> sorted = updateTimesMs;
+        std::sort(sorted.begin(), sorted.end());
+
+        const double total = std::accumulate(sorted.begin(), sorted.end(), 0.0);
+        const auto percentile = [&sorted](double p)
+            {
+                const std::size_t index = static_cast<std::size_t>(p * (sorted.size() - 1));
+                return sorted[index];
+            };
+
+        out << "Update avg (ms):      " << total / sorted.size() << "\n";
+        out << "Update p50 (ms):      " << percentile(0.50) << "\n";
+        out << "Update p95 (ms):      " << percentile(0.95) << "\n";
+        out << "Update p99 (ms):      " << percentile(0.99) << "\n";
+        out << "Update max (ms):      " << sorted.back() << "\n";
+        out << "Total update (ms):    " << total << "\n";
+    }
+
+    if (rollbackCheck && !snapshotTimesMs.empty())
+    {
+        const auto average = [](const std::vector<float>& times)
+            {
+                return std::accumulate(times.begin(), times.end(), 0.0) / times.size();
+            };
+
+        out << "Snapshot size (bytes): " << snapshot.getData().size() << "\n";
+        out << "Snapshot avg (ms):    " << average(snapshotTimesMs) << "\n";
+        out << "Restore avg (ms):     " << average(restoreTimesMs) << "\n";
+        out << "Rollback:             " << (rollbackFailures == 0 ? "OK" : "FAILED") << "\n";
+    }
+
+    out << "Checkpoints verified: " << verified << " / " << replay.getCheckpoints().size() << "\n";
+    if (mismatches == 0)
+        out << "Determinism:          OK\n";
+    else
+        out << "Determinism:          FAILED (" << mismatches << " mismatching checkpoints)\n";
+}
+
+int runHeadlessReplay(const std::string& path, bool rollbackCheck)
+{
+    InputReplay replay;
+    if (!replay.load(path))
+        return 1;
+
+    ReplaySession session(std::move(replay));
+    session.setRollbackCheckEnabled(rollbackCheck);
+
+    Game game(session.getStartLevel());
+    if (!game.initialize())
+    {
+        EOL_LOG_ERROR << "Failed to initialize game for replay";
+        return 1;
+    }
+
+    while (session.step(game))
+    {
+    }
+
+    std::ostringstream report;
+    session.printReport(report);
+    EOL_LOG_INFO << report.str();
+    return session.getMismatchCount() == 0 && session.getRollbackFailureCount() == 0 ? 0 : 1;
+}
@@ -0,0 +1,193 @@
+#include "ResourceLoader.h"
+#include "Log.h"
+#include <algorithm>
+
+ResourceLoader::~ResourceLoader()
+{
+    // Workers finish the job in hand and then find nothing left to take
+    cancelled.store(true, std::memory_order_relaxed);
+    for (std::thread& worker : workers)
+    {
+        if (worker.joinable())
+            worker.join();
+    }
+}
+
+void ResourceLoader::addTexture(sf::Texture& target, const std::string& path, ImageSource fallback)
+{
+    if (started)
+    {
+        EOL_LOG_ERROR << "ResourceLoader::addTexture - loader already started: " << path;
+        return;
+    }
+
+    Job job;
+    job.kind = JobKind::FileTexture;
+    job.name = path;
+    job.source = std::move(fallback);
+    job.texture = &target;
+    jobs.push_back(std::move(job));
+}
+
+void ResourceLoader::addGeneratedTexture(sf::Texture& target, const std::string& name, ImageSource source)
+{
+    if (started)
+    {
+        EOL_LOG_ERROR << "ResourceLoader::addGeneratedTexture - loader already started: " << name;
+        return;
+    }
+
+    Job job;
+    job.kind = JobKind::GeneratedTexture;
+    job.name = name;
+    job.source = std::move(source);
+    job.texture = &target;
+    jobs.push_back(std::move(job));
+}
+
+void ResourceLoader::addFont(sf::Font& target, const std::string& path)
+{
+    if (started)
+    {
+        EOL_LOG_ERROR << "ResourceLoader::addFont - loader already started: " << path;
+        return;
+    }
+
+    Job job;
+    job.kind = JobKind::Font;
+    job.name = path;
+    job.font = &target;
+    jobs.push_back(std::move(job));
+}
+
+void ResourceLoader::start(unsigned int workerCount)
+{
+    if (started)
+        return;
+    started = true;
+
+    if (workerCount == 0)
+    {
+        const unsigned int cores = std::thread::hardware_concurrency();
+        workerCount = cores > 1 ? cores - 1 : 1;
+    }
+    workerCount = std::min({ workerCount, kMaxWorkers, static_cast<unsigned int>(jobs.size()) });
+
+    ready.reserve(jobs.size());
+    uploading.reserve(jobs.size());
+    workers.reserve(workerCount);
+    for (unsigned int i = 0; i < workerCount; ++i)
+        workers.emplace_back([this]() { runWorker(); });
+}
+
+void ResourceLoader::runWorker()
+{
+    while (!cancelled.load(std::memory_order_relaxed))
+    {
+        const std::size_t index = nextJob.fetch_add(1, std::memory_order_relaxed);
+        if (index >= jobs.size())
+            return;
+
+        decode(jobs[index]);
+
+        {
+            std::lock_guard<std::mutex> lock(readyMutex);
+            ready.push_back(index);
+        }
+        readyChanged.notify_one();
+    }
+}
+
+// Worker side: everything that does not need the GL context
+void ResourceLoader::decode(Job& job)
+{
+    switch (job.kind)
+    {
+    case JobKind::FileTexture:
+        job.decoded = job.image.loadFromFile(job.name);
+        if (!job.decoded && job.source)
+        {
+            job.decoded = job.source(job.image);
+            job.usedFallback = job.decoded;
+        }
+        break;
+
+    case JobKind::GeneratedTexture:
+        job.decoded = job.source && job.source(job.image);
+        break;
+
+    case JobKind::Font:
+        job.decoded = job.font->openFromFile(job.name);
+        break;
+    }
+}
+
+// Main thread side: upload and bookkeeping
+void ResourceLoader::complete(Job& job)
+{
+    ++completed;
+
+    if (job.usedFallback)
+        EOL_LOG_WARNING << "Failed to load " << job.name << ", using a fallback image";
+
+    bool ok = job.decoded;
+    if (ok && job.texture)
+    {
+        ok = job.texture->loadFromImage(job.image);
+        // The pixels now live on the GPU
+        job.image = sf::Image();
+    }
+
+    if (!ok)
+    {
+        EOL_LOG_ERROR << "Failed to load " << job.name;
+        failed = true;
+    }
+}
+
+std::size_t ResourceLoader::uploadReady(std::size_t maxUploads)
+{
+    if (!started)
+        start();
+
+    std::size_t done = 0;
+    while (done < maxUploads)
+    {
+        std::size_t index = 0;
+        {
+            std::lock_guard<std::mutex> lock(readyMutex);
+            if (ready.empty())
+                break;
+            index = ready.back();
+            ready.pop_back();
+        }
+        complete(jobs[index]);
+        ++done;
+    }
+    return done;
+}
+
+void ResourceLoader::finish()
+{
+    if (!started)
+        start();
+
+    while (!isDone())
+    {
+        {
+            std::unique_lock<std::mutex> lock(readyMutex);
+            readyChanged.wait(lock, [this]() { return !ready.empty(); });
+            uploading.swap(ready);
+        }
+        for (std::size_t index : uploading)
+            complete(jobs[index]);
+        uploading.clear();
+    }
+}
+
+float ResourceLoader::getProgress() const noexcept
+{
+    if (jobs.empty())
+        return 1.f;
+    return static_cast<float>(completed) / static_cast<float>(jobs.size());
+}
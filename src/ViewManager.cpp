@@ -0,0 +1,52 @@
+#include "ViewManager.h"
+#include "GameSettings.h"
+
+ViewManager::ViewManager()
+    : worldCenter(GameSettings::center())
+{
+}
+
+void ViewManager::setWindowSize(const sf::Vector2u& size)
+{
+    if (size == windowSize || size.x == 0 || size.y == 0)
+        return;
+
+    windowSize = size;
+    scaledView = GameSettings::getScaledView(size);
+
+    // Pixel viewport rounded the way RenderTarget::getViewport rounds it,
+    // so the mapping matches mapPixelToCoords exactly
+    const sf::FloatRect& viewport = scaledView.getViewport();
+    const float left = static_cast<float>(static_cast<int>(0.5f + size.x * viewport.position.x));
+    const float top = static_cast<float>(static_cast<int>(0.5f + size.y * viewport.position.y));
+    const float width = static_cast<float>(static_cast<int>(0.5f + size.x * viewport.size.x));
+    const float height = static_cast<float>(static_cast<int>(0.5f + size.y * viewport.size.y));
+
+    const sf::Vector2f viewSize = scaledView.getSize();
+    pixelToReference = sf::Transform();
+    pixelToReference.translate(scaledView.getCenter() - viewSize * 0.5f);
+    pixelToReference.scale({ viewSize.x / width, viewSize.y / height });
+    pixelToReference.translate({ -left, -top });
+
+    updateWorldView();
+}
+
+void ViewManager::setWorldCenter(const sf::Vector2f& center)
+{
+    if (center == worldCenter)
+        return;
+
+    worldCenter = center;
+    updateWorldView();
+}
+
+void ViewManager::updateWorldView()
+{
+    worldView = scaledView;
+    worldView.setCenter(worldCenter);
+
+    // The world view only differs from the scaled one by its centre
+    pixelToWorld = sf::Transform();
+    pixelToWorld.translate(worldCenter - scaledView.getCenter());
+    pixelToWorld.combine(pixelToReference);
+}
@@ -0,0 +1,156 @@
+#include "WorldSnapshot.h"
+#include "Log.h"
+#include <algorithm>
+#include <fstream>
+
+namespace
+{
+    const char kMagic[4] = { 'E', 'O', 'L', 'S' };
+    // 2: entity components and system state are length-prefixed blocks;
+    //    animation clips are saved under their library names ("player.idle",
+    //    "player.walk"), which a version 1 "idle"/"walk" would not resolve to
+    constexpr std::uint32_t kVersion = 2;
+    constexpr std::uint32_t kNoEntity = 0xFFFFFFFFu;
+}
+
+// --------------------------------------------------------
+// SnapshotWriter / SnapshotReader
+// --------------------------------------------------------
+
+void SnapshotWriter::writeString(const std::string& value)
+{
+    write(static_cast<std::uint32_t>(value.size()));
+    buffer.insert(buffer.end(), value.begin(), value.end());
+}
+
+void SnapshotWriter::writeEntity(const Entity* entity)
+{
+    std::uint32_t index = kNoEntity;
+    if (entity)
+    {
+        // References are rare (carried item, puzzle sources), a scan is fine
+        const auto it = std::find(entities.begin(), entities.end(), entity);
+        if (it != entities.end())
+            index = static_cast<std::uint32_t>(it - entities.begin());
+    }
+    write(index);
+}
+
+std::size_t SnapshotWriter::beginBlock()
+{
+    const std::size_t start = buffer.size();
+    write(std::uint32_t{ 0 });
+    return start;
+}
+
+void SnapshotWriter::endBlock(std::size_t start)
+{
+    const std::uint32_t size = static_cast<std::uint32_t>(buffer.size() - start - sizeof(std::uint32_t));
+    std::memcpy(buffer.data() + start, &size, sizeof(size));
+}
+
+void SnapshotReader::readString(std::string& value)
+{
+    const std::uint32_t size = read<std::uint32_t>();
+    if (failed || buffer.size() - offset < size)
+    {
+        failed = true;
+        value.clear();
+        return;
+    }
+    value.assign(reinterpret_cast<const char*>(buffer.data() + offset), size);
+    offset += size;
+}
+
+Entity* SnapshotReader::readEntity()
+{
+    const std::uint32_t index = read<std::uint32_t>();
+    if (index == kNoEntity)
+        return nullptr;
+
+    if (index >= entities.size())
+    {
+        failed = true;
+        return nullptr;
+    }
+    return entities[index];
+}
+
+void SnapshotReader::skipBlock()
+{
+    offset = enterBlock();
+}
+
+std::size_t SnapshotReader::enterBlock()
+{
+    const std::uint32_t size = read<std::uint32_t>();
+    if (failed || buffer.size() - offset < size)
+    {
+        failed = true;
+        return offset;
+    }
+    return offset + size;
+}
+
+bool SnapshotReader::leaveBlock(std::size_t end)
+{
+    if (failed)
+        return false;
+    const bool exact = offset == end;
+    offset = end;
+    return exact;
+}
+
+// --------------------------------------------------------
+// WorldSnapshot
+// --------------------------------------------------------
+
+bool WorldSnapshot::saveToFile(const std::string& path) const
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+        EOL_LOG_ERROR << "Could not write snapshot " << path;
+        return false;
+    }
+
+    const std::uint32_t size = static_cast<std::uint32_t>(data.size());
+    file.write(kMagic, sizeof(kMagic));
+    file.write(reinterpret_cast<const char*>(&kVersion), sizeof(kVersion));
+    file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    file.write(reinterpret_cast<const char*>(data.data()), data.size());
+    return static_cast<bool>(file);
+}
+
+bool WorldSnapshot::loadFromFile(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        EOL_LOG_ERROR << "Could not open snapshot " << path;
+        return false;
+    }
+
+    char magic[4] = {};
+    std::uint32_t version = 0;
+    std::uint32_t size = 0;
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&version), sizeof(version));
+    file.read(reinterpret_cast<char*>(&size), sizeof(size));
+
+    if (!file || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 || version != kVersion)
+    {
+        EOL_LOG_ERROR << path << " is not a compatible snapshot";
+        return false;
+    }
+
+    data.resize(size);
+    file.read(reinterpret_cast<char*>(data.data()), size);
+    if (!file)
+    {
+        EOL_LOG_ERROR << "Truncated snapshot " << path;
+        data.clear();
+        return false;
+    }
+    return true;
+}
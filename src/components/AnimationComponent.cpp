@@ -1,5 +1,7 @@
 #include "components/AnimationComponent.h"
-#include <iostream>
+#include "components/AnimationStore.h"
+#include "Log.h"
+#include "WorldSnapshot.h"
 
 namespace eol {
 
@@ -7,99 +9,133 @@ namespace eol {
         : Component("Animation") {
     }
 
-    void AnimationComponent::addAnimation(const std::string& name, const Animation& anim) {
-        m_animations[name] = anim;
+    AnimationComponent::AnimationComponent(const AnimationComponent& other)
+        : Component(other)
+        , m_clip(other.m_clip)
+        , m_currentFrame(other.getCurrentFrame())
+        , m_elapsedTime(other.getElapsedTime())
+        , m_finished(other.isFinished()) {
+        refreshFrameRect();
+    }
 
-        // Set first animation as current if none set
-        if (m_currentAnimation.empty()) {
-            m_currentAnimation = name;
+    AnimationComponent::~AnimationComponent() {
+        if (m_store) {
+            m_store->detach(*this);
         }
     }
 
-    void AnimationComponent::setAnimation(const std::string& name) {
-        // Don't restart if already playing this animation
-        if (m_currentAnimation == name) {
+    void AnimationComponent::setClip(ClipHandle clip) noexcept {
+        // Don't restart if already playing this clip
+        if (m_clip == clip) {
             return;
         }
 
-        // Check if animation exists
-        if (m_animations.find(name) == m_animations.end()) {
-            std::cerr << "Warning: Animation '" << name << "' not found!" << std::endl;
-            return;
+        m_clip = clip;
+        if (m_store) {
+            m_store->loadClip(m_storeSlot);
         }
-
-        m_currentAnimation = name;
-        m_currentFrame = 0;
-        m_elapsedTime = 0.f;
-        m_finished = false;
+        setPlayback(0, 0.f, false);
+        refreshFrameRect();
     }
 
-    const std::string& AnimationComponent::getCurrentAnimationName() const noexcept {
-        return m_currentAnimation;
+    ClipHandle AnimationComponent::getClip() const noexcept {
+        return m_clip;
     }
 
-    void AnimationComponent::update(float deltaTime) {
-        if (m_currentAnimation.empty() || m_animations.empty()) {
+    void AnimationComponent::setAnimation(const std::string& name) {
+        const ClipHandle clip = AnimationLibrary::instance().find(name);
+        if (clip == InvalidClip) {
+            EOL_LOG_WARNING << "Animation '" << name << "' not found!";
             return;
         }
+        setClip(clip);
+    }
 
-        const Animation& anim = m_animations[m_currentAnimation];
-
-        // Don't update if animation is finished and not looping
-        if (m_finished && !anim.loop) {
+    void AnimationComponent::setPlayback(int frame, float elapsed, bool finished) noexcept {
+        if (m_store) {
+            m_store->frame[m_storeSlot] = frame;
+            m_store->elapsed[m_storeSlot] = elapsed;
+            m_store->finished[m_storeSlot] = finished ? 1 : 0;
             return;
         }
+        m_currentFrame = frame;
+        m_elapsedTime = elapsed;
+        m_finished = finished;
+    }
 
-        m_elapsedTime += deltaTime;
-
-        // Check if we should advance to next frame
-        if (m_elapsedTime >= anim.frameDuration) {
-            m_elapsedTime = 0.f;
-            m_currentFrame++;
-
-            // Check if animation finished
-            if (m_currentFrame >= anim.frameCount) {
-                if (anim.loop) {
-                    m_currentFrame = 0;  // Loop back to start
-                }
-                else {
-                    m_currentFrame = anim.frameCount - 1;  // Stay on last frame
-                    m_finished = true;
-                }
-            }
-        }
+    int AnimationComponent::getCurrentFrame() const noexcept {
+        return m_store ? m_store->frame[m_storeSlot] : m_currentFrame;
+    }
+
+    float AnimationComponent::getElapsedTime() const noexcept {
+        return m_store ? m_store->elapsed[m_storeSlot] : m_elapsedTime;
+    }
+
+    const sf::IntRect& AnimationComponent::getCurrentFrameRect() const noexcept {
+        return m_frameRect;
     }
 
-    sf::IntRect AnimationComponent::getCurrentFrameRect() const {
-        if (m_currentAnimation.empty() || m_animations.empty()) {
-            return sf::IntRect(sf::Vector2i(0, 0), sf::Vector2i(0, 0));
+    void AnimationComponent::refreshFrameRect() noexcept {
+        const int frame = getCurrentFrame();
+        if (m_store) {
+            m_store->shownFrame[m_storeSlot] = frame;
         }
 
-        const Animation& anim = m_animations.at(m_currentAnimation);
+        const Animation* anim = AnimationLibrary::instance().get(m_clip);
+        if (!anim) {
+            m_frameRect = sf::IntRect(sf::Vector2i(0, 0), sf::Vector2i(0, 0));
+            return;
+        }
 
         // Frames are arranged horizontally in the sprite sheet
-        return sf::IntRect(
-            sf::Vector2i(m_currentFrame * anim.frameWidth, 0),
-            sf::Vector2i(anim.frameWidth, anim.frameHeight)
+        m_frameRect = sf::IntRect(
+            sf::Vector2i(frame * anim->frameWidth, 0),
+            sf::Vector2i(anim->frameWidth, anim->frameHeight)
         );
     }
 
     const sf::Texture* AnimationComponent::getCurrentTexture() const {
-        if (m_currentAnimation.empty() || m_animations.empty()) {
-            return nullptr;
-        }
-
-        return m_animations.at(m_currentAnimation).texture;
+        const Animation* anim = AnimationLibrary::instance().get(m_clip);
+        return anim ? anim->texture : nullptr;
     }
 
     bool AnimationComponent::isFinished() const noexcept {
-        return m_finished;
+        return m_store ? m_store->finished[m_storeSlot] != 0 : m_finished;
     }
 
     void AnimationComponent::reset() {
-        m_currentFrame = 0;
-        m_elapsedTime = 0.f;
-        m_finished = false;
+        setPlayback(0, 0.f, false);
+        refreshFrameRect();
+    }
+
+    ComponentPtr AnimationComponent::clone() const {
+        return std::make_unique<AnimationComponent>(*this);
+    }
+
+    void AnimationComponent::saveState(SnapshotWriter& out) const {
+        Component::saveState(out);
+        // Stored by name: handles depend on registration order
+        const Animation* anim = AnimationLibrary::instance().get(m_clip);
+        out.writeString(anim ? anim->name : std::string());
+        out.write(getCurrentFrame());
+        out.write(getElapsedTime());
+        out.write(isFinished());
+    }
+
+    void AnimationComponent::loadState(SnapshotReader& in) {
+        Component::loadState(in);
+        std::string clipName;
+        in.readString(clipName);
+        m_clip = clipName.empty() ? InvalidClip : AnimationLibrary::instance().find(clipName);
+        if (m_store) {
+            m_store->loadClip(m_storeSlot);
+        }
+
+        const int frame = in.read<int>();
+        const float elapsed = in.read<float>();
+        const bool finished = in.read<bool>();
+        setPlayback(frame, elapsed, finished);
+        refreshFrameRect();
     }
 
-} // namespace eol
\ No newline at end of file
+} // namespace eol
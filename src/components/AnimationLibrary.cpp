@@ -0,0 +1,34 @@
+#include "components/AnimationLibrary.h"
+#include "Log.h"
+
+namespace eol {
+
+    AnimationLibrary& AnimationLibrary::instance() {
+        static AnimationLibrary library;
+        return library;
+    }
+
+    ClipHandle AnimationLibrary::add(const Animation& clip) {
+        auto found = m_byName.find(clip.name);
+        if (found != m_byName.end()) {
+            m_clips[found->second] = clip;
+            return found->second;
+        }
+
+        if (m_clips.size() >= InvalidClip) {
+            EOL_LOG_ERROR << "Animation library is full, cannot add '" << clip.name << "'";
+            return InvalidClip;
+        }
+
+        const auto handle = static_cast<ClipHandle>(m_clips.size());
+        m_clips.push_back(clip);
+        m_byName.emplace(clip.name, handle);
+        return handle;
+    }
+
+    ClipHandle AnimationLibrary::find(const std::string& name) const {
+        auto found = m_byName.find(name);
+        return found != m_byName.end() ? found->second : InvalidClip;
+    }
+
+} // namespace eol
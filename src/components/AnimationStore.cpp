@@ -0,0 +1,107 @@
+#include "components/AnimationStore.h"
+#include "components/AnimationComponent.h"
+#include "components/AnimationLibrary.h"
+
+#include <algorithm>
+
+namespace eol {
+
+    namespace {
+        // Shortest frame the system accepts; keeps the step count finite
+        constexpr float kMinFrameDuration = 0.0001f;
+    }
+
+    AnimationStore::~AnimationStore() {
+        clear();
+    }
+
+    void AnimationStore::attach(AnimationComponent& animation) {
+        if (animation.m_store) {
+            animation.m_store->detach(animation);
+        }
+
+        animations.push_back(&animation);
+        frame.push_back(animation.m_currentFrame);
+        elapsed.push_back(animation.m_elapsedTime);
+        finished.push_back(animation.m_finished ? 1 : 0);
+        shownFrame.push_back(animation.m_currentFrame);
+        frameCount.push_back(1);
+        frameDuration.push_back(kMinFrameDuration);
+        loop.push_back(0);
+        running.push_back(0);
+
+        animation.m_store = this;
+        animation.m_storeSlot = static_cast<std::uint32_t>(animations.size() - 1);
+        loadClip(animations.size() - 1);
+    }
+
+    void AnimationStore::detach(AnimationComponent& animation) {
+        if (animation.m_store != this) {
+            return;
+        }
+
+        const std::size_t slot = animation.m_storeSlot;
+        animation.m_currentFrame = frame[slot];
+        animation.m_elapsedTime = elapsed[slot];
+        animation.m_finished = finished[slot] != 0;
+        animation.m_store = nullptr;
+        if (shownFrame[slot] != frame[slot]) {
+            animation.refreshFrameRect();
+        }
+
+        const std::size_t last = animations.size() - 1;
+        if (slot != last) {
+            animations[slot] = animations[last];
+            frame[slot] = frame[last];
+            elapsed[slot] = elapsed[last];
+            finished[slot] = finished[last];
+            shownFrame[slot] = shownFrame[last];
+            frameCount[slot] = frameCount[last];
+            frameDuration[slot] = frameDuration[last];
+            loop[slot] = loop[last];
+            running[slot] = running[last];
+            animations[slot]->m_storeSlot = static_cast<std::uint32_t>(slot);
+        }
+        animations.pop_back();
+        frame.pop_back();
+        elapsed.pop_back();
+        finished.pop_back();
+        shownFrame.pop_back();
+        frameCount.pop_back();
+        frameDuration.pop_back();
+        loop.pop_back();
+        running.pop_back();
+    }
+
+    void AnimationStore::clear() {
+        while (!animations.empty()) {
+            detach(*animations.back());
+        }
+    }
+
+    bool AnimationStore::holds(const AnimationComponent& animation) const noexcept {
+        return animation.m_store == this;
+    }
+
+    std::size_t AnimationStore::slotOf(const AnimationComponent& animation) const noexcept {
+        return animation.m_storeSlot;
+    }
+
+    void AnimationStore::loadClip(std::size_t slot) {
+        const Animation* clip = AnimationLibrary::instance().get(animations[slot]->getClip());
+        const bool playable = clip && clip->frameCount > 0;
+        frameCount[slot] = playable ? clip->frameCount : 1;
+        frameDuration[slot] = playable ? std::max(kMinFrameDuration, clip->frameDuration) : kMinFrameDuration;
+        loop[slot] = playable && clip->loop ? 1 : 0;
+        running[slot] = playable ? 1 : 0;
+    }
+
+    void AnimationStore::refreshFrameRects() {
+        for (std::size_t i = 0; i < animations.size(); ++i) {
+            if (shownFrame[i] != frame[i]) {
+                animations[i]->refreshFrameRect();
+            }
+        }
+    }
+
+} // namespace eol
@@ -1,4 +1,5 @@
 #include "components/CollisionComponent.h"
+#include "WorldSnapshot.h"
 
 namespace eol {
 
@@ -21,4 +22,20 @@ bool CollisionComponent::isSolid() const noexcept {
     return m_solid;
 }
 
+ComponentPtr CollisionComponent::clone() const {
+    return std::make_unique<CollisionComponent>(*this);
+}
+
+void CollisionComponent::saveState(SnapshotWriter& out) const {
+    Component::saveState(out);
+    out.write(m_boundingBox);
+    out.write(m_solid);
+}
+
+void CollisionComponent::loadState(SnapshotReader& in) {
+    Component::loadState(in);
+    in.read(m_boundingBox);
+    in.read(m_solid);
+}
+
 } // namespace eol
@@ -1,4 +1,6 @@
 #include "components/Component.h"
+#include "components/ComponentPool.h"
+#include "WorldSnapshot.h"
 
 #include <utility>
 
@@ -7,6 +9,14 @@ namespace eol {
 Component::Component(std::string name)
     : m_name(std::move(name)) {}
 
+void* Component::operator new(std::size_t size) {
+    return ComponentPool::instance().allocate(size);
+}
+
+void Component::operator delete(void* ptr, std::size_t size) noexcept {
+    ComponentPool::instance().deallocate(ptr, size);
+}
+
 const std::string& Component::getName() const noexcept {
     return m_name;
 }
@@ -19,5 +29,13 @@ void Component::setEnabled(bool enabled) noexcept {
     m_enabled = enabled;
 }
 
+void Component::saveState(SnapshotWriter& out) const {
+    out.write(m_enabled);
+}
+
+void Component::loadState(SnapshotReader& in) {
+    in.read(m_enabled);
+}
+
 } // namespace eol
 
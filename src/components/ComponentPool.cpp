@@ -0,0 +1,66 @@
+#include "components/ComponentPool.h"
+
+#include <new>
+
+namespace eol {
+
+ComponentPool& ComponentPool::instance() {
+    // Never destroyed: components may outlive static destruction order
+    static ComponentPool* pool = new ComponentPool();
+    return *pool;
+}
+
+void* ComponentPool::allocate(std::size_t size) {
+    if (size == 0 || size > kMaxPooledSize) {
+        return ::operator new(size);
+    }
+
+    const std::size_t sizeClass = (size - 1) / kGranularity;
+    const std::size_t slotSize = (sizeClass + 1) * kGranularity;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (FreeNode* node = m_freeLists[sizeClass]) {
+        m_freeLists[sizeClass] = node->next;
+        return node;
+    }
+
+    if (m_remaining < slotSize) {
+        // Whatever is left of the old block is too small for this slot; it is
+        // simply abandoned (at most kMaxPooledSize bytes per block)
+        m_blocks.emplace_back(new unsigned char[kBlockSize]);
+        m_cursor = m_blocks.back().get();
+        m_remaining = kBlockSize;
+    }
+
+    void* slot = m_cursor;
+    m_cursor += slotSize;
+    m_remaining -= slotSize;
+    return slot;
+}
+
+void ComponentPool::deallocate(void* ptr, std::size_t size) noexcept {
+    if (!ptr) {
+        return;
+    }
+    m_releases.fetch_add(1, std::memory_order_relaxed);
+
+    if (size == 0 || size > kMaxPooledSize) {
+        ::operator delete(ptr);
+        return;
+    }
+
+    const std::size_t sizeClass = (size - 1) / kGranularity;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto* node = static_cast<FreeNode*>(ptr);
+    node->next = m_freeLists[sizeClass];
+    m_freeLists[sizeClass] = node;
+}
+
+std::size_t ComponentPool::getBlockCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_blocks.size();
+}
+
+} // namespace eol
@@ -1,4 +1,5 @@
 #include "components/EnemyAIComponent.h"
+#include "WorldSnapshot.h"
 
 #include <algorithm>
 
@@ -56,6 +57,14 @@ float EnemyAIComponent::getMoveSpeed() const noexcept {
     return m_moveSpeed;
 }
 
+void EnemyAIComponent::setVelocity(const sf::Vector2f& velocity) noexcept {
+    m_velocity = velocity;
+}
+
+const sf::Vector2f& EnemyAIComponent::getVelocity() const noexcept {
+    return m_velocity;
+}
+
 void EnemyAIComponent::setState(BehaviorState state) noexcept {
     m_state = state;
 }
@@ -72,6 +81,41 @@ bool EnemyAIComponent::isActive() const noexcept {
     return m_active;
 }
 
+ComponentPtr EnemyAIComponent::clone() const {
+    return std::make_unique<EnemyAIComponent>(*this);
+}
+
+void EnemyAIComponent::saveState(SnapshotWriter& out) const {
+    Component::saveState(out);
+    out.write(static_cast<std::uint32_t>(m_patrolPoints.size()));
+    for (const sf::Vector2f& point : m_patrolPoints) {
+        out.write(point);
+    }
+    out.write(static_cast<std::uint32_t>(m_currentPatrolIndex));
+    out.write(m_detectionRange);
+    out.write(m_attackRange);
+    out.write(m_moveSpeed);
+    out.write(m_velocity);
+    out.write(m_state);
+    out.write(m_active);
+}
+
+void EnemyAIComponent::loadState(SnapshotReader& in) {
+    Component::loadState(in);
+    const std::uint32_t pointCount = in.read<std::uint32_t>();
+    m_patrolPoints.clear();
+    for (std::uint32_t i = 0; i < pointCount && !in.hasFailed(); ++i) {
+        m_patrolPoints.push_back(in.read<sf::Vector2f>());
+    }
+    m_currentPatrolIndex = in.read<std::uint32_t>();
+    in.read(m_detectionRange);
+    in.read(m_attackRange);
+    in.read(m_moveSpeed);
+    in.read(m_velocity);
+    in.read(m_state);
+    in.read(m_active);
+}
+
 } // namespace eol
 
 
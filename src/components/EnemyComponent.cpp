@@ -1,4 +1,5 @@
 #include "components/EnemyComponent.h"
+#include "WorldSnapshot.h"
 
 #include <algorithm>
 
@@ -59,5 +60,27 @@ void EnemyComponent::setBlocksLight(bool blocksLight) noexcept {
     m_blocksLight = blocksLight;
 }
 
+ComponentPtr EnemyComponent::clone() const {
+    return std::make_unique<EnemyComponent>(*this);
+}
+
+void EnemyComponent::saveState(SnapshotWriter& out) const {
+    Component::saveState(out);
+    out.write(m_resistance);
+    out.write(m_health);
+    out.write(m_maxHealth);
+    out.write(m_awarenessRadius);
+    out.write(m_blocksLight);
+}
+
+void EnemyComponent::loadState(SnapshotReader& in) {
+    Component::loadState(in);
+    in.read(m_resistance);
+    in.read(m_health);
+    in.read(m_maxHealth);
+    in.read(m_awarenessRadius);
+    in.read(m_blocksLight);
+}
+
 } // namespace eol
 
@@ -1,4 +1,5 @@
 #include "components/HitboxComponent.h"
+#include "WorldSnapshot.h"
 
 namespace eol {
 
@@ -13,6 +14,20 @@ const sf::Vector2f& HitboxComponent::getSize() const noexcept {
     return m_size;
 }
 
+ComponentPtr HitboxComponent::clone() const {
+    return std::make_unique<HitboxComponent>(*this);
+}
+
+void HitboxComponent::saveState(SnapshotWriter& out) const {
+    Component::saveState(out);
+    out.write(m_size);
+}
+
+void HitboxComponent::loadState(SnapshotReader& in) {
+    Component::loadState(in);
+    in.read(m_size);
+}
+
 } // namespace eol
 
 
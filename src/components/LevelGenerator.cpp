@@ -0,0 +1,227 @@
+#include "components/LevelGenerator.h"
+#include "components/Map.h"
+#include "Log.h"
+#include <algorithm>
+#include <fstream>
+#include <queue>
+
+namespace {
+    // splitmix64: tiny, and unlike the <random> distributions it produces the
+    // same sequence with every standard library
+    class SeededRandom {
+    public:
+        explicit SeededRandom(std::uint64_t seed) : state(seed) {}
+
+        std::uint64_t next() {
+            std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            return z ^ (z >> 31);
+        }
+
+        // Uniform in [low, high]
+        int range(int low, int high) {
+            if (high <= low) return low;
+            return low + static_cast<int>(next() % static_cast<std::uint64_t>(high - low + 1));
+        }
+
+    private:
+        std::uint64_t state;
+    };
+
+    constexpr char kWall = '#';
+    constexpr char kFloor = '.';
+    constexpr int kMinSize = 5;
+    constexpr int kMaxAttempts = 8;
+    constexpr int kMaxWallRun = 8;      // longer runs seal off large pockets
+
+    struct Cell { int x; int y; };
+
+    // Breadth-first distances from start over floor; -1 where unreachable
+    std::vector<int> floorDistances(const std::vector<std::string>& rows, Cell start) {
+        const int width = static_cast<int>(rows[0].size());
+        const int height = static_cast<int>(rows.size());
+        std::vector<int> distance(static_cast<std::size_t>(width) * height, -1);
+
+        std::queue<Cell> open;
+        distance[static_cast<std::size_t>(start.y) * width + start.x] = 0;
+        open.push(start);
+        while (!open.empty()) {
+            const Cell cell = open.front();
+            open.pop();
+            const int here = distance[static_cast<std::size_t>(cell.y) * width + cell.x];
+
+            const Cell neighbours[] = {
+                { cell.x + 1, cell.y }, { cell.x - 1, cell.y }, { cell.x, cell.y + 1 }, { cell.x, cell.y - 1 } };
+            for (const Cell& n : neighbours) {
+                if (n.x < 0 || n.y < 0 || n.x >= width || n.y >= height) continue;
+                if (rows[n.y][n.x] == kWall) continue;
+                int& seen = distance[static_cast<std::size_t>(n.y) * width + n.x];
+                if (seen >= 0) continue;
+                seen = here + 1;
+                open.push(n);
+            }
+        }
+        return distance;
+    }
+
+    // Floor tiles of the biggest 4-connected floor region
+    std::vector<Cell> largestRegion(const std::vector<std::string>& rows) {
+        const int width = static_cast<int>(rows[0].size());
+        const int height = static_cast<int>(rows.size());
+        std::vector<bool> seen(static_cast<std::size_t>(width) * height, false);
+
+        std::vector<Cell> best;
+        std::vector<Cell> region;
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                if (rows[y][x] == kWall || seen[static_cast<std::size_t>(y) * width + x]) continue;
+
+                // The region list doubles as the BFS queue
+                region.clear();
+                region.push_back({ x, y });
+                seen[static_cast<std::size_t>(y) * width + x] = true;
+                for (std::size_t head = 0; head < region.size(); ++head) {
+                    const Cell cell = region[head];
+                    const Cell neighbours[] = {
+                        { cell.x + 1, cell.y }, { cell.x - 1, cell.y }, { cell.x, cell.y + 1 }, { cell.x, cell.y - 1 } };
+                    for (const Cell& n : neighbours) {
+                        if (n.x < 0 || n.y < 0 || n.x >= width || n.y >= height) continue;
+                        if (rows[n.y][n.x] == kWall) continue;
+                        if (seen[static_cast<std::size_t>(n.y) * width + n.x]) continue;
+                        seen[static_cast<std::size_t>(n.y) * width + n.x] = true;
+                        region.push_back(n);
+                    }
+                }
+                if (region.size() > best.size()) best.swap(region);
+            }
+        }
+        return best;
+    }
+
+    // Border plus straight wall runs until the density is reached
+    std::vector<std::string> layWalls(int width, int height, float density, SeededRandom& random) {
+        std::vector<std::string> rows(height, std::string(width, kFloor));
+        for (int x = 0; x < width; ++x) {
+            rows[0][x] = kWall;
+            rows[height - 1][x] = kWall;
+        }
+        for (int y = 0; y < height; ++y) {
+            rows[y][0] = kWall;
+            rows[y][width - 1] = kWall;
+        }
+
+        const int interior = (width - 2) * (height - 2);
+        const int target = static_cast<int>(interior * std::clamp(density, 0.f, 0.6f));
+        const int maxRun = std::clamp(std::min(width, height) / 4, 3, kMaxWallRun);
+
+        int placed = 0;
+        int tries = interior * 4;   // dense settings may not be reachable exactly
+        while (placed < target && tries-- > 0) {
+            const bool horizontal = (random.next() & 1u) != 0;
+            const int length = random.range(3, maxRun);
+            int x = random.range(1, width - 2);
+            int y = random.range(1, height - 2);
+            for (int i = 0; i < length && placed < target; ++i) {
+                if (x < 1 || y < 1 || x > width - 2 || y > height - 2) break;
+                if (rows[y][x] != kWall) {
+                    rows[y][x] = kWall;
+                    ++placed;
+                }
+                if (horizontal) ++x; else ++y;
+            }
+        }
+        return rows;
+    }
+}
+
+std::vector<std::string> LevelGenerator::generate(const LevelGenSettings& settings) {
+    const int width = std::max(kMinSize, settings.width);
+    const int height = std::max(kMinSize, settings.height);
+    const int beacons = std::clamp(settings.beacons, 0, 4);
+    const int wanted = beacons + std::max(0, settings.lightSources)
+        + std::max(0, settings.mirrors) + std::max(0, settings.spawners);
+
+    SeededRandom random(settings.seed);
+    float density = settings.wallDensity;
+
+    for (int attempt = 0;; ++attempt) {
+        // The last attempt has no interior walls, so it always has room
+        if (attempt == kMaxAttempts - 1) density = 0.f;
+        std::vector<std::string> rows = layWalls(width, height, density, random);
+
+        // Start in the biggest open area; everything cut off from it is filled
+        const std::vector<Cell> region = largestRegion(rows);
+        if (region.empty()) {
+            density *= 0.5f;
+            continue;
+        }
+        const Cell start = region[random.range(0, static_cast<int>(region.size()) - 1)];
+        const std::vector<int> distance = floorDistances(rows, start);
+
+        std::vector<Cell> reachable;
+        Cell exit = start;
+        int exitDistance = 0;
+        for (int y = 1; y < height - 1; ++y) {
+            for (int x = 1; x < width - 1; ++x) {
+                if (rows[y][x] == kWall) continue;
+                const int d = distance[static_cast<std::size_t>(y) * width + x];
+                if (d < 0) {
+                    rows[y][x] = kWall;
+                    continue;
+                }
+                if (d > exitDistance) {
+                    exitDistance = d;
+                    exit = { x, y };
+                }
+                if (d > 0) reachable.push_back({ x, y });
+            }
+        }
+
+        // Start, exit and every object need a tile of their own
+        if (static_cast<int>(reachable.size()) < wanted + 1 && attempt < kMaxAttempts - 1) {
+            density *= 0.5f;
+            continue;
+        }
+
+        rows[start.y][start.x] = 'S';
+        rows[exit.y][exit.x] = 'E';
+        reachable.erase(std::remove_if(reachable.begin(), reachable.end(),
+            [&](const Cell& c) { return c.x == exit.x && c.y == exit.y; }), reachable.end());
+
+        // Fisher-Yates, then hand tiles out in order
+        for (std::size_t i = reachable.size(); i > 1; --i) {
+            std::swap(reachable[i - 1], reachable[random.range(0, static_cast<int>(i) - 1)]);
+        }
+        std::size_t next = 0;
+        auto place = [&](char tile, int count) {
+            for (int i = 0; i < count && next < reachable.size(); ++i, ++next) {
+                rows[reachable[next].y][reachable[next].x] = tile;
+            }
+        };
+        for (int b = 0; b < beacons; ++b) place(static_cast<char>('1' + b), 1);
+        place('L', settings.lightSources);
+        place('/', settings.mirrors);
+        place('X', settings.spawners);
+
+        if (static_cast<int>(next) < wanted) {
+            EOL_LOG_WARNING << "LevelGenerator: room for only " << next << " of " << wanted
+                << " objects in a " << width << "x" << height << " level";
+        }
+        return rows;
+    }
+}
+
+void LevelGenerator::generate(const LevelGenSettings& settings, Map& out) {
+    out.loadFromLines(generate(settings));
+}
+
+bool LevelGenerator::writeToFile(const std::vector<std::string>& rows, const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        EOL_LOG_ERROR << "LevelGenerator::writeToFile - failed to open: " << filename;
+        return false;
+    }
+    for (const std::string& row : rows) file << row << '\n';
+    return static_cast<bool>(file);
+}
@@ -1,5 +1,5 @@
 #include "components/LevelManager.h"
-#include <iostream>
+#include "Log.h"
 
 LevelManager::LevelManager()
     : currentLevelIndex(0)
@@ -17,7 +17,7 @@ LevelManager::LevelManager()
 }
 
 bool LevelManager::loadLevel(const std::string& levelName) {
-    std::cout << "LevelManager: Loading " << levelName << std::endl;
+    EOL_LOG_INFO << "LevelManager: Loading " << levelName;
     bool ok = map.loadFromFile(levelName);
     if (ok) {
         // update current index to match if the file is in the list
@@ -31,12 +31,21 @@ bool LevelManager::loadLevel(const std::string& levelName) {
 bool LevelManager::loadCurrentLevel() {
     if (currentLevelIndex < 0 ||
         currentLevelIndex >= static_cast<int>(levelFiles.size())) {
-        std::cout << "LevelManager: current index out of range\n";
+        EOL_LOG_WARNING << "LevelManager: current index out of range";
         return false;
     }
     return loadLevel(levelFiles[currentLevelIndex]);
 }
 
+bool LevelManager::loadLevelAt(int idx) {
+    if (idx < 0 || idx >= static_cast<int>(levelFiles.size())) {
+        EOL_LOG_WARNING << "LevelManager: level " << idx << " out of range";
+        return false;
+    }
+    // loadLevel moves the index only once the map has loaded
+    return loadLevel(levelFiles[idx]);
+}
+
 void LevelManager::nextLevel() {
     if (currentLevelIndex >= static_cast<int>(levelFiles.size()) - 1) {
         currentLevelIndex = static_cast<int>(levelFiles.size());
@@ -1,4 +1,6 @@
 #include "components/LightComponent.h"
+#include "components/LightFieldStore.h"
+#include "WorldSnapshot.h"
 
 #include <algorithm>
 
@@ -9,6 +11,30 @@ LightComponent::LightComponent()
     m_baseIntensity = m_intensity;
 }
 
+LightComponent::LightComponent(const LightComponent& other)
+    : Component(other),
+      m_radius(other.m_radius),
+      m_intensity(other.getIntensity()),
+      m_baseIntensity(other.getBaseIntensity()),
+      m_decayRate(other.getDecayRate()),
+      m_decayDelay(other.getDecayDelay()),
+      m_timeSinceBoost(other.getBoostTimer()),
+      m_weaponized(other.m_weaponized) {}
+
+LightComponent::~LightComponent() {
+    if (m_fields) {
+        m_fields->detach(*this);
+    }
+}
+
+float& LightComponent::field(float& own, std::vector<float> LightFieldStore::*column) noexcept {
+    return m_fields ? (m_fields->*column)[m_fieldSlot] : own;
+}
+
+float LightComponent::field(float own, std::vector<float> LightFieldStore::*column) const noexcept {
+    return m_fields ? (m_fields->*column)[m_fieldSlot] : own;
+}
+
 void LightComponent::setRadius(float radius) noexcept {
     m_radius = radius;
 }
@@ -18,49 +44,50 @@ float LightComponent::getRadius() const noexcept {
 }
 
 void LightComponent::setIntensity(float intensity) noexcept {
-    m_intensity = intensity;
+    field(m_intensity, &LightFieldStore::intensity) = intensity;
 }
 
 float LightComponent::getIntensity() const noexcept {
-    return m_intensity;
+    return field(m_intensity, &LightFieldStore::intensity);
 }
 
 void LightComponent::setBaseIntensity(float intensity) noexcept {
-    m_baseIntensity = std::max(0.f, intensity);
-    m_intensity = m_baseIntensity;
+    const float base = std::max(0.f, intensity);
+    field(m_baseIntensity, &LightFieldStore::base) = base;
+    field(m_intensity, &LightFieldStore::intensity) = base;
     resetBoostTimer();
 }
 
 float LightComponent::getBaseIntensity() const noexcept {
-    return m_baseIntensity;
+    return field(m_baseIntensity, &LightFieldStore::base);
 }
 
 void LightComponent::setDecayRate(float rate) noexcept {
-    m_decayRate = std::max(0.f, rate);
+    field(m_decayRate, &LightFieldStore::decayRate) = std::max(0.f, rate);
 }
 
 float LightComponent::getDecayRate() const noexcept {
-    return m_decayRate;
+    return field(m_decayRate, &LightFieldStore::decayRate);
 }
 
 void LightComponent::setDecayDelay(float delay) noexcept {
-    m_decayDelay = std::max(0.f, delay);
+    field(m_decayDelay, &LightFieldStore::delay) = std::max(0.f, delay);
 }
 
 float LightComponent::getDecayDelay() const noexcept {
-    return m_decayDelay;
+    return field(m_decayDelay, &LightFieldStore::delay);
 }
 
 void LightComponent::resetBoostTimer() noexcept {
-    m_timeSinceBoost = 0.f;
+    field(m_timeSinceBoost, &LightFieldStore::timer) = 0.f;
 }
 
 void LightComponent::advanceBoostTimer(float deltaTime) noexcept {
-    m_timeSinceBoost += deltaTime;
+    field(m_timeSinceBoost, &LightFieldStore::timer) += deltaTime;
 }
 
 float LightComponent::getBoostTimer() const noexcept {
-    return m_timeSinceBoost;
+    return field(m_timeSinceBoost, &LightFieldStore::timer);
 }
 
 void LightComponent::setWeaponized(bool weaponized) noexcept {
@@ -71,5 +98,30 @@ bool LightComponent::isWeaponized() const noexcept {
     return m_weaponized;
 }
 
-} // namespace eol
+ComponentPtr LightComponent::clone() const {
+    return std::make_unique<LightComponent>(*this);
+}
+
+void LightComponent::saveState(SnapshotWriter& out) const {
+    Component::saveState(out);
+    out.write(m_radius);
+    out.write(getIntensity());
+    out.write(getBaseIntensity());
+    out.write(getDecayRate());
+    out.write(getDecayDelay());
+    out.write(getBoostTimer());
+    out.write(m_weaponized);
+}
 
+void LightComponent::loadState(SnapshotReader& in) {
+    Component::loadState(in);
+    in.read(m_radius);
+    in.read(field(m_intensity, &LightFieldStore::intensity));
+    in.read(field(m_baseIntensity, &LightFieldStore::base));
+    in.read(field(m_decayRate, &LightFieldStore::decayRate));
+    in.read(field(m_decayDelay, &LightFieldStore::delay));
+    in.read(field(m_timeSinceBoost, &LightFieldStore::timer));
+    in.read(m_weaponized);
+}
+
+} // namespace eol
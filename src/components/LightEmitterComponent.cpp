@@ -1,4 +1,5 @@
 #include "components/LightEmitterComponent.h"
+#include "WorldSnapshot.h"
 
 #include <algorithm>
 #include <cmath>
@@ -132,6 +133,42 @@ void LightEmitterComponent::registerShot() noexcept {
     m_cooldownTimer = m_cooldown;
 }
 
+ComponentPtr LightEmitterComponent::clone() const {
+    return std::make_unique<LightEmitterComponent>(*this);
+}
+
+void LightEmitterComponent::saveState(SnapshotWriter& out) const {
+    Component::saveState(out);
+    out.write(m_direction);
+    out.write(m_beamColor);
+    out.write(m_beamLength);
+    out.write(m_beamWidth);
+    out.write(m_damage);
+    out.write(m_cooldown);
+    out.write(m_beamDuration);
+    out.write(m_energyCost);
+    out.write(m_cooldownTimer);
+    out.write(m_maxReflections);
+    out.write(m_triggerHeld);
+    out.write(m_continuous);
+}
+
+void LightEmitterComponent::loadState(SnapshotReader& in) {
+    Component::loadState(in);
+    in.read(m_direction);
+    in.read(m_beamColor);
+    in.read(m_beamLength);
+    in.read(m_beamWidth);
+    in.read(m_damage);
+    in.read(m_cooldown);
+    in.read(m_beamDuration);
+    in.read(m_energyCost);
+    in.read(m_cooldownTimer);
+    in.read(m_maxReflections);
+    in.read(m_triggerHeld);
+    in.read(m_continuous);
+}
+
 } // namespace eol
 
 
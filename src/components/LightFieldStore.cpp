@@ -0,0 +1,74 @@
+#include "components/LightFieldStore.h"
+#include "components/LightComponent.h"
+
+namespace eol {
+
+LightFieldStore::~LightFieldStore() {
+    clear();
+}
+
+void LightFieldStore::attach(LightComponent& light, RenderComponent& render) {
+    if (light.m_fields) {
+        light.m_fields->detach(light);
+    }
+
+    lights.push_back(&light);
+    renders.push_back(&render);
+    intensity.push_back(light.m_intensity);
+    base.push_back(light.m_baseIntensity);
+    decayRate.push_back(light.m_decayRate);
+    delay.push_back(light.m_decayDelay);
+    timer.push_back(light.m_timeSinceBoost);
+
+    light.m_fields = this;
+    light.m_fieldSlot = static_cast<std::uint32_t>(lights.size() - 1);
+}
+
+void LightFieldStore::detach(LightComponent& light) {
+    if (light.m_fields != this) {
+        return;
+    }
+
+    const std::size_t slot = light.m_fieldSlot;
+    light.m_intensity = intensity[slot];
+    light.m_baseIntensity = base[slot];
+    light.m_decayRate = decayRate[slot];
+    light.m_decayDelay = delay[slot];
+    light.m_timeSinceBoost = timer[slot];
+    light.m_fields = nullptr;
+
+    const std::size_t last = lights.size() - 1;
+    if (slot != last) {
+        lights[slot] = lights[last];
+        renders[slot] = renders[last];
+        intensity[slot] = intensity[last];
+        base[slot] = base[last];
+        decayRate[slot] = decayRate[last];
+        delay[slot] = delay[last];
+        timer[slot] = timer[last];
+        lights[slot]->m_fieldSlot = static_cast<std::uint32_t>(slot);
+    }
+    lights.pop_back();
+    renders.pop_back();
+    intensity.pop_back();
+    base.pop_back();
+    decayRate.pop_back();
+    delay.pop_back();
+    timer.pop_back();
+}
+
+void LightFieldStore::clear() {
+    while (!lights.empty()) {
+        detach(*lights.back());
+    }
+}
+
+bool LightFieldStore::holds(const LightComponent& light) const noexcept {
+    return light.m_fields == this;
+}
+
+std::size_t LightFieldStore::slotOf(const LightComponent& light) const noexcept {
+    return light.m_fieldSlot;
+}
+
+} // namespace eol
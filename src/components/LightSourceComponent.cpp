@@ -1,4 +1,5 @@
 #include "components/LightSourceComponent.h"
+#include "WorldSnapshot.h"
 
 namespace eol {
 
@@ -29,5 +30,23 @@ void LightSourceComponent::setFuel(float fuel) noexcept {
     m_fuel = fuel;
 }
 
+ComponentPtr LightSourceComponent::clone() const {
+    return std::make_unique<LightSourceComponent>(*this);
+}
+
+void LightSourceComponent::saveState(SnapshotWriter& out) const {
+    Component::saveState(out);
+    out.write(m_movable);
+    out.write(m_active);
+    out.write(m_fuel);
+}
+
+void LightSourceComponent::loadState(SnapshotReader& in) {
+    Component::loadState(in);
+    in.read(m_movable);
+    in.read(m_active);
+    in.read(m_fuel);
+}
+
 } // namespace eol
 
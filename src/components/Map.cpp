@@ -1,6 +1,9 @@
 #include "components/Map.h"
+#include "Log.h"
+#include "systems/Camera.h"
+#include <algorithm>
+#include <cmath>
 #include <fstream>
-#include <iostream>
 
 TileType Map::charToTile(char c) const {
     switch (c) {
@@ -21,13 +24,23 @@ TileType Map::charToTile(char c) const {
 bool Map::loadFromFile(const std::string& filename) {
     std::ifstream file(filename);
     if (!file.is_open()) {
-        std::cerr << "Map::loadFromFile - failed to open: " << filename << std::endl;
+        EOL_LOG_ERROR << "Map::loadFromFile - failed to open: " << filename;
         return false;
     }
 
-    grid.clear();
+    std::vector<std::string> lines;
     std::string line;
-    while (std::getline(file, line)) {
+    while (std::getline(file, line)) lines.push_back(line);
+    loadFromLines(lines);
+
+    EOL_LOG_INFO << "Map loaded: " << filename << " (" << width << "x" << height << ")";
+    return true;
+}
+
+void Map::loadFromLines(const std::vector<std::string>& lines) {
+    grid.clear();
+    grid.reserve(lines.size());
+    for (const std::string& line : lines) {
         std::vector<TileType> row;
         row.reserve(line.size());
         for (char c : line) row.push_back(charToTile(c));
@@ -36,9 +49,6 @@ bool Map::loadFromFile(const std::string& filename) {
 
     height = static_cast<int>(grid.size());
     width = height > 0 ? static_cast<int>(grid[0].size()) : 0;
-
-    std::cout << "Map loaded: " << filename << " (" << width << "x" << height << ")\n";
-    return true;
 }
 
 TileType Map::getTile(int x, int y) const {
@@ -85,44 +95,23 @@ void Map::draw(sf::RenderWindow& window, int tileSize) const {
 */
 
 void Map::draw(sf::RenderWindow& window, float tileSize, sf::Vector2f offset) const {
-    if (width == 0 || height == 0) return;
+    if (width == 0 || height == 0 || tileSize <= 0.f) return;
 
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
+    // Only the tiles under the current view
+    const sf::FloatRect visible = viewBounds(window.getView());
+    const int x0 = std::max(0, static_cast<int>(std::floor((visible.position.x - offset.x) / tileSize)));
+    const int y0 = std::max(0, static_cast<int>(std::floor((visible.position.y - offset.y) / tileSize)));
+    const int x1 = std::min(width, static_cast<int>(std::ceil((visible.position.x + visible.size.x - offset.x) / tileSize)));
+    const int y1 = std::min(height, static_cast<int>(std::ceil((visible.position.y + visible.size.y - offset.y) / tileSize)));
+
+    for (int y = y0; y < y1; ++y) {
+        for (int x = x0; x < x1; ++x) {
             TileType tile = getTile(x, y);
             sf::Vector2f tilePos(offset.x + x * tileSize, offset.y + y * tileSize);
 
             // Check if we have a texture for this tile type
-            const sf::Texture* tex = nullptr;
             sf::Color fallbackColor;
-
-            switch (tile) {
-            case TileType::WALL:
-                tex = wallTexture;
-                fallbackColor = sf::Color(80, 80, 100);
-                break;
-            case TileType::LIGHT_SOURCE:
-                tex = lightTexture;
-                fallbackColor = sf::Color(255, 255, 150);
-                break;
-            case TileType::MIRROR:
-                tex = emptyTexture;
-                fallbackColor = sf::Color(30, 30, 40);
-                break;
-            case TileType::START:
-                tex = startTexture;
-                fallbackColor = sf::Color(100, 255, 100);
-                break;
-            case TileType::END:
-                tex = exitTexture;
-                fallbackColor = sf::Color(255, 100, 100);
-                break;
-            case TileType::EMPTY:
-            default:
-                tex = emptyTexture;
-                fallbackColor = sf::Color(30, 30, 40);
-                break;
-            }
+            const sf::Texture* tex = getTileTexture(tile, fallbackColor);
 
             if (tex) {
                 sf::Sprite sprite(*tex);
@@ -144,6 +133,81 @@ void Map::draw(sf::RenderWindow& window, float tileSize, sf::Vector2f offset) co
     }
 }
 
+const sf::Texture* Map::getTileTexture(TileType tile, sf::Color& fallbackColor) const {
+    switch (tile) {
+    case TileType::WALL:
+        fallbackColor = sf::Color(80, 80, 100);
+        return wallTexture;
+    case TileType::LIGHT_SOURCE:
+        fallbackColor = sf::Color(255, 255, 150);
+        return lightTexture;
+    case TileType::MIRROR:
+        fallbackColor = sf::Color(30, 30, 40);
+        return emptyTexture;
+    case TileType::START:
+        fallbackColor = sf::Color(100, 255, 100);
+        return startTexture;
+    case TileType::END:
+        fallbackColor = sf::Color(255, 100, 100);
+        return exitTexture;
+    case TileType::EMPTY:
+    default:
+        fallbackColor = sf::Color(30, 30, 40);
+        return emptyTexture;
+    }
+}
+
+std::vector<sf::IntRect> Map::buildWallRects() const {
+    return buildWallRects(sf::IntRect({ 0, 0 }, { width, height }));
+}
+
+std::vector<sf::IntRect> Map::buildWallRects(const sf::IntRect& area) const {
+    std::vector<sf::IntRect> rects;
+
+    const int left = std::max(0, area.position.x);
+    const int top = std::max(0, area.position.y);
+    const int right = std::min(width, area.position.x + area.size.x);
+    const int bottom = std::min(height, area.position.y + area.size.y);
+    if (left >= right || top >= bottom) return rects;
+
+    const int areaWidth = right - left;
+    std::vector<bool> used(static_cast<std::size_t>(areaWidth) * (bottom - top), false);
+
+    auto isFreeWall = [&](int x, int y) {
+        return getTile(x, y) == TileType::WALL
+            && !used[static_cast<std::size_t>(y - top) * areaWidth + (x - left)];
+    };
+
+    for (int y = top; y < bottom; ++y) {
+        for (int x = left; x < right; ++x) {
+            if (!isFreeWall(x, y)) continue;
+
+            int endX = x + 1;
+            while (endX < right && isFreeWall(endX, y)) ++endX;
+
+            int endY = y + 1;
+            while (endY < bottom) {
+                bool fullRow = true;
+                for (int sx = x; sx < endX && fullRow; ++sx) {
+                    fullRow = isFreeWall(sx, endY);
+                }
+                if (!fullRow) break;
+                ++endY;
+            }
+
+            for (int ry = y; ry < endY; ++ry) {
+                for (int rx = x; rx < endX; ++rx) {
+                    used[static_cast<std::size_t>(ry - top) * areaWidth + (rx - left)] = true;
+                }
+            }
+
+            rects.emplace_back(sf::Vector2i{ x, y }, sf::Vector2i{ endX - x, endY - y });
+        }
+    }
+
+    return rects;
+}
+
 bool Map::isWalkableTile(TileType t) const {
     switch (t) {
         case TileType::WALL: return false;
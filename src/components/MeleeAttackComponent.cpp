@@ -1,4 +1,5 @@
 #include "components/MeleeAttackComponent.h"
+#include "WorldSnapshot.h"
 
 #include <algorithm>
 
@@ -45,6 +46,26 @@ void MeleeAttackComponent::resetCooldown() noexcept {
     m_cooldownTimer = m_cooldown;
 }
 
+ComponentPtr MeleeAttackComponent::clone() const {
+    return std::make_unique<MeleeAttackComponent>(*this);
+}
+
+void MeleeAttackComponent::saveState(SnapshotWriter& out) const {
+    Component::saveState(out);
+    out.write(m_damage);
+    out.write(m_range);
+    out.write(m_cooldown);
+    out.write(m_cooldownTimer);
+}
+
+void MeleeAttackComponent::loadState(SnapshotReader& in) {
+    Component::loadState(in);
+    in.read(m_damage);
+    in.read(m_range);
+    in.read(m_cooldown);
+    in.read(m_cooldownTimer);
+}
+
 } // namespace eol
 
 
@@ -1,4 +1,5 @@
 #include "components/MirrorComponent.h"
+#include "WorldSnapshot.h"
 
 #include <cmath>
 
@@ -24,6 +25,7 @@ MirrorComponent::MirrorComponent()
 
 void MirrorComponent::setNormal(const sf::Vector2f& normal) noexcept {
     m_normal = normalizeVector(normal);
+    ++m_version;
 }
 
 const sf::Vector2f& MirrorComponent::getNormal() const noexcept {
@@ -32,6 +34,7 @@ const sf::Vector2f& MirrorComponent::getNormal() const noexcept {
 
 void MirrorComponent::setSize(const sf::Vector2f& size) noexcept {
     m_size = size;
+    ++m_version;
 }
 
 const sf::Vector2f& MirrorComponent::getSize() const noexcept {
@@ -40,6 +43,7 @@ const sf::Vector2f& MirrorComponent::getSize() const noexcept {
 
 void MirrorComponent::setReflectionLoss(float loss) noexcept {
     m_reflectionLoss = loss;
+    ++m_version;
 }
 
 float MirrorComponent::getReflectionLoss() const noexcept {
@@ -48,6 +52,7 @@ float MirrorComponent::getReflectionLoss() const noexcept {
 
 void MirrorComponent::setType(MirrorType type) noexcept {
     m_type = type;
+    ++m_version;
 }
 
 MirrorComponent::MirrorType MirrorComponent::getType() const noexcept {
@@ -56,6 +61,7 @@ MirrorComponent::MirrorType MirrorComponent::getType() const noexcept {
 
 void MirrorComponent::setActive(bool active) noexcept {
     m_active = active;
+    ++m_version;
 }
 
 bool MirrorComponent::isActive() const noexcept {
@@ -70,6 +76,35 @@ bool MirrorComponent::isPickable() const noexcept {
     return m_pickable;
 }
 
+std::uint32_t MirrorComponent::getVersion() const noexcept {
+    return m_version;
+}
+
+ComponentPtr MirrorComponent::clone() const {
+    return std::make_unique<MirrorComponent>(*this);
+}
+
+void MirrorComponent::saveState(SnapshotWriter& out) const {
+    Component::saveState(out);
+    out.write(m_normal);
+    out.write(m_size);
+    out.write(m_reflectionLoss);
+    out.write(m_type);
+    out.write(m_active);
+    out.write(m_pickable);
+}
+
+void MirrorComponent::loadState(SnapshotReader& in) {
+    Component::loadState(in);
+    in.read(m_normal);
+    in.read(m_size);
+    in.read(m_reflectionLoss);
+    in.read(m_type);
+    in.read(m_active);
+    in.read(m_pickable);
+    ++m_version;
+}
+
 } // namespace eol
 
 
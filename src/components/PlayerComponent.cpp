@@ -1,4 +1,5 @@
 #include "components/PlayerComponent.h"
+#include "WorldSnapshot.h"
 
 #include <algorithm>
 
@@ -82,5 +83,33 @@ void PlayerComponent::tickInvulnerability(float deltaTime) noexcept {
     }
 }
 
+ComponentPtr PlayerComponent::clone() const {
+    return std::make_unique<PlayerComponent>(*this);
+}
+
+void PlayerComponent::saveState(SnapshotWriter& out) const {
+    Component::saveState(out);
+    out.write(m_movementSpeed);
+    out.write(m_lightCapacity);
+    out.write(m_lightFragments);
+    out.write(m_upgradePoints);
+    out.write(m_health);
+    out.write(m_maxHealth);
+    out.write(m_invulnerabilityTimer);
+    out.writeEntity(m_carriedEntity);
+}
+
+void PlayerComponent::loadState(SnapshotReader& in) {
+    Component::loadState(in);
+    in.read(m_movementSpeed);
+    in.read(m_lightCapacity);
+    in.read(m_lightFragments);
+    in.read(m_upgradePoints);
+    in.read(m_health);
+    in.read(m_maxHealth);
+    in.read(m_invulnerabilityTimer);
+    m_carriedEntity = in.readEntity();
+}
+
 } // namespace eol
 
@@ -1,4 +1,5 @@
 #include "components/PuzzleComponent.h"
+#include "WorldSnapshot.h"
 
 #include <algorithm>
 
@@ -72,5 +73,39 @@ void PuzzleComponent::resetSources() noexcept {
     m_uniqueSources.clear();
 }
 
+ComponentPtr PuzzleComponent::clone() const {
+    return std::make_unique<PuzzleComponent>(*this);
+}
+
+void PuzzleComponent::saveState(SnapshotWriter& out) const {
+    Component::saveState(out);
+    out.write(m_requiredLight);
+    out.write(m_receivedLight);
+    out.write(m_solved);
+    out.write(m_requirement);
+    out.write(m_requiredUniqueSources);
+    out.write(static_cast<std::uint32_t>(m_uniqueSources.size()));
+    for (const Entity* source : m_uniqueSources) {
+        out.writeEntity(source);
+    }
+}
+
+void PuzzleComponent::loadState(SnapshotReader& in) {
+    Component::loadState(in);
+    in.read(m_requiredLight);
+    in.read(m_receivedLight);
+    in.read(m_solved);
+    in.read(m_requirement);
+    in.read(m_requiredUniqueSources);
+
+    m_uniqueSources.clear();
+    const std::uint32_t sourceCount = in.read<std::uint32_t>();
+    for (std::uint32_t i = 0; i < sourceCount && !in.hasFailed(); ++i) {
+        if (const Entity* source = in.readEntity()) {
+            m_uniqueSources.insert(source);
+        }
+    }
+}
+
 } // namespace eol
 
@@ -1,4 +1,5 @@
 #include "components/RenderComponent.h"
+#include "WorldSnapshot.h"
 
 #include <utility>
 
@@ -10,6 +11,17 @@ RenderComponent::RenderComponent()
     , m_sprite{m_placeholderTexture}
     , m_tint{sf::Color::White} {}
 
+RenderComponent::RenderComponent(const RenderComponent& other)
+    : Component(other)
+    , m_textureId{other.m_textureId}
+    , m_placeholderTexture{other.m_placeholderTexture}
+    , m_sprite{other.m_sprite}
+    , m_tint{other.m_tint} {
+    if (&other.m_sprite.getTexture() == &other.m_placeholderTexture) {
+        m_sprite.setTexture(m_placeholderTexture);
+    }
+}
+
 void RenderComponent::setTextureId(std::string textureId) {
     m_textureId = std::move(textureId);
 }
@@ -34,5 +46,35 @@ const sf::Color& RenderComponent::getTint() const noexcept {
     return m_tint;
 }
 
+ComponentPtr RenderComponent::clone() const {
+    return std::make_unique<RenderComponent>(*this);
+}
+
+void RenderComponent::saveState(SnapshotWriter& out) const {
+    Component::saveState(out);
+    out.writeString(m_textureId);
+    out.write(m_tint);
+    out.write(m_sprite.getPosition());
+    out.write(m_sprite.getRotation().asDegrees());
+    out.write(m_sprite.getScale());
+    out.write(m_sprite.getOrigin());
+    out.write(m_sprite.getTextureRect());
+    out.write(m_sprite.getColor());
+}
+
+void RenderComponent::loadState(SnapshotReader& in) {
+    Component::loadState(in);
+    in.readString(m_textureId);
+    in.read(m_tint);
+    // The texture binding is owned by whoever built the entity; only the
+    // sprite's placement and colour are part of the saved state
+    m_sprite.setPosition(in.read<sf::Vector2f>());
+    m_sprite.setRotation(sf::degrees(in.read<float>()));
+    m_sprite.setScale(in.read<sf::Vector2f>());
+    m_sprite.setOrigin(in.read<sf::Vector2f>());
+    m_sprite.setTextureRect(in.read<sf::IntRect>());
+    m_sprite.setColor(in.read<sf::Color>());
+}
+
 } // namespace eol
 
@@ -1,4 +1,5 @@
 #include "components/SpawnerComponent.h"
+#include "WorldSnapshot.h"
 #include <algorithm>
 
 namespace eol {
@@ -61,4 +62,26 @@ namespace eol {
         return m_active;
     }
 
+    ComponentPtr SpawnerComponent::clone() const {
+        return std::make_unique<SpawnerComponent>(*this);
+    }
+
+    void SpawnerComponent::saveState(SnapshotWriter& out) const {
+        Component::saveState(out);
+        out.write(m_spawnInterval);
+        out.write(m_spawnTimer);
+        out.write(m_maxEnemies);
+        out.write(m_currentEnemies);
+        out.write(m_active);
+    }
+
+    void SpawnerComponent::loadState(SnapshotReader& in) {
+        Component::loadState(in);
+        in.read(m_spawnInterval);
+        in.read(m_spawnTimer);
+        in.read(m_maxEnemies);
+        in.read(m_currentEnemies);
+        in.read(m_active);
+    }
+
 } // namespace eol
\ No newline at end of file
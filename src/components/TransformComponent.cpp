@@ -1,4 +1,5 @@
 #include "components/TransformComponent.h"
+#include "WorldSnapshot.h"
 
 namespace eol {
 
@@ -19,6 +20,7 @@ const sf::Vector2f& TransformComponent::getPosition() const noexcept {
 
 void TransformComponent::setPosition(const sf::Vector2f& position) noexcept {
     m_position = position;
+    ++m_version;
 }
 
 const sf::Vector2f& TransformComponent::getScale() const noexcept {
@@ -27,6 +29,7 @@ const sf::Vector2f& TransformComponent::getScale() const noexcept {
 
 void TransformComponent::setScale(const sf::Vector2f& scale) noexcept {
     m_scale = scale;
+    ++m_version;
 }
 
 float TransformComponent::getRotation() const noexcept {
@@ -35,6 +38,30 @@ float TransformComponent::getRotation() const noexcept {
 
 void TransformComponent::setRotation(float rotation) noexcept {
     m_rotation = rotation;
+    ++m_version;
+}
+
+std::uint32_t TransformComponent::getVersion() const noexcept {
+    return m_version;
+}
+
+ComponentPtr TransformComponent::clone() const {
+    return std::make_unique<TransformComponent>(*this);
+}
+
+void TransformComponent::saveState(SnapshotWriter& out) const {
+    Component::saveState(out);
+    out.write(m_position);
+    out.write(m_scale);
+    out.write(m_rotation);
+}
+
+void TransformComponent::loadState(SnapshotReader& in) {
+    Component::loadState(in);
+    in.read(m_position);
+    in.read(m_scale);
+    in.read(m_rotation);
+    ++m_version;
 }
 
 } // namespace eol
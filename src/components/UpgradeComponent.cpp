@@ -1,4 +1,5 @@
 #include "components/UpgradeComponent.h"
+#include "WorldSnapshot.h"
 
 #include <utility>
 
@@ -23,5 +24,27 @@ void UpgradeComponent::setCost(unsigned int cost) noexcept {
     m_cost = cost;
 }
 
+ComponentPtr UpgradeComponent::clone() const {
+    return std::make_unique<UpgradeComponent>(*this);
+}
+
+void UpgradeComponent::saveState(SnapshotWriter& out) const {
+    Component::saveState(out);
+    out.write(static_cast<std::uint32_t>(m_availableUpgrades.size()));
+    for (const std::string& upgrade : m_availableUpgrades) {
+        out.writeString(upgrade);
+    }
+    out.write(m_cost);
+}
+
+void UpgradeComponent::loadState(SnapshotReader& in) {
+    Component::loadState(in);
+    m_availableUpgrades.resize(in.read<std::uint32_t>());
+    for (std::string& upgrade : m_availableUpgrades) {
+        in.readString(upgrade);
+    }
+    in.read(m_cost);
+}
+
 } // namespace eol
 
@@ -1,26 +1,87 @@
 #include "scenes/GameplayScene.h"
 #include "scenes/PauseMenuScene.h"
 #include "GameSettings.h"
-#include <iostream>
+#include "Log.h"
+#include <sstream>
+
+namespace
+{
+    const char* const kQuickSaveFile = "quicksave.eols";
+}
 
 GameplayScene::GameplayScene(Application& app)
     : app(app)
 {
 }
 
+GameplayScene::GameplayScene(Application& app, std::shared_ptr<ReplaySession> replay)
+    : app(app)
+    , game(replay ? replay->getStartLevel() : 0)
+    , replay(std::move(replay))
+{
+}
+
 void GameplayScene::onEnter()
 {
+    // Built during the first frames of play, so the first ESC is instant
+    app.preloadScene(app.getScene<PauseMenuScene>());
+
     if (!initialized)
     {
         if (!game.initialize())
         {
-            std::cout << "Failed to initialize Game!" << std::endl;
+            EOL_LOG_ERROR << "Failed to initialize Game!";
         }
 
         initialized = true;
+
+        // Only the first live session is recorded, from the state it starts in
+        const std::string recordPath = app.takeRecordPath();
+        if (!replay && !recordPath.empty() &&
+            recorder.open(recordPath, game.getStartLevel()))
+        {
+            recorder.recordCheckpoint(game.computeStateHash());
+        }
     }
 }
 
+void GameplayScene::onExit()
+{
+    recorder.close();
+}
+
+void GameplayScene::handleSnapshotKey(sf::Keyboard::Key key)
+{
+    if (key == sf::Keyboard::Key::F5)
+    {
+        game.saveSnapshot(quickSave);
+        quickSave.saveToFile(kQuickSaveFile);
+        EOL_LOG_INFO << "Quick saved (" << quickSave.getData().size() << " bytes)";
+        return;
+    }
+
+    // Jumping around would desync a recording from what it replays
+    if (recorder.isOpen() || replay)
+    {
+        EOL_LOG_INFO << "Quick load / restart is disabled while recording or replaying";
+        return;
+    }
+
+    if (key == sf::Keyboard::Key::F4)
+    {
+        if (game.restartLevel())
+            EOL_LOG_INFO << "Level restarted";
+        return;
+    }
+
+    // Fall back to the file so a save survives restarting the game
+    if (quickSave.empty() && !quickSave.loadFromFile(kQuickSaveFile))
+        return;
+
+    if (game.restoreSnapshot(quickSave))
+        EOL_LOG_INFO << "Quick loaded";
+}
+
 void GameplayScene::handleEvent(const sf::Event& event)
 {
     // Pause on ESC
@@ -30,39 +91,60 @@ void GameplayScene::handleEvent(const sf::Event& event)
 
         if (key == sf::Keyboard::Key::Escape)
         {
-            app.pushScene(std::make_shared<PauseMenuScene>(app));
+            app.pushScene(app.getScene<PauseMenuScene>());
+            return;
+        }
+
+        // Quick save / load / restart level
+        if (key == sf::Keyboard::Key::F5 || key == sf::Keyboard::Key::F9 || key == sf::Keyboard::Key::F4)
+        {
+            handleSnapshotKey(key);
             return;
         }
     }
 
     // NOTE:
-    // If you decide to move any input-event logic for the player here,
-    // you can do that later. Currently, InputSystem handles real-time inputs,
-    // so no work is needed.
+    // Player input is collected by the SceneStack's InputActionMap and
+    // handed to Game::update as an InputFrame, so no work is needed here.
 }
 
 void GameplayScene::update(float dt)
 {
-    // Get window reference
-    auto& window = app.getWindow();
+    if (replay)
+    {
+        // Recorded dt and input replace the live ones
+        if (!replay->step(game) && !replayReported)
+        {
+            std::ostringstream report;
+            replay->printReport(report);
+            EOL_LOG_INFO << report.str();
+            replayReported = true;
+            app.getWindow().close();
+        }
+        return;
+    }
 
-    // IMPORTANT:
-    // Ensure gameplay uses the scaled reference view (for correct collision,
-    // mouse mapping, raycasts, and light system behaviour)
-    sf::View scaledView = GameSettings::getScaledView(window.getSize());
-    window.setView(scaledView);
+    // Aim through the camera as it was drawn last frame; the cached
+    // transform only changes when the camera or the window does
+    ViewManager& views = app.getViews();
+    views.setWorldCenter(game.getCameraCenter());
+    InputFrame input = app.getInput().getFrame();
+    input.aim = views.mapPixelToWorld(input.cursor);
 
     // Update gameplay
-    game.update(dt, window);
+    game.update(dt, input);
+
+    if (recorder.isOpen())
+    {
+        recorder.recordFrame(dt, input);
+        if (recorder.isCheckpointDue())
+            recorder.recordCheckpoint(game.computeStateHash());
+    }
 }
 
 void GameplayScene::render(sf::RenderWindow& window)
 {
-    // Use the same scaled view for rendering
-    sf::View scaledView = GameSettings::getScaledView(window.getSize());
-    window.setView(scaledView);
-
-    // Render the ECS world
-    game.render(window);
+    // Render the ECS world (sets the camera view, then the HUD view)
+    game.render(window, app.getViews());
 }
 
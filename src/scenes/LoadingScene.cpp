@@ -0,0 +1,71 @@
+#include "scenes/LoadingScene.h"
+#include "scenes/GameplayScene.h"
+#include "GameSettings.h"
+#include "Log.h"
+#include <algorithm>
+
+namespace
+{
+    // Texture uploads per frame; keeps the bar moving while big images go up
+    constexpr std::size_t kUploadsPerFrame = 2;
+    // How fast the bar catches up with the real progress (per second)
+    constexpr float kBarEaseRate = 12.f;
+}
+
+LoadingScene::LoadingScene(Application& app, std::shared_ptr<GameplayScene> next)
+    : app(app)
+    , next(std::move(next))
+{
+}
+
+void LoadingScene::onEnter()
+{
+    clock.restart();
+    next->queueResources(loader);
+    loader.start();
+}
+
+void LoadingScene::handleEvent(const sf::Event&)
+{
+    // Nothing to interact with while loading
+}
+
+void LoadingScene::update(float dt)
+{
+    if (handedOver)
+        return;
+
+    loader.uploadReady(kUploadsPerFrame);
+    shownProgress += (loader.getProgress() - shownProgress) * std::min(1.f, dt * kBarEaseRate);
+
+    if (!loader.isDone())
+        return;
+
+    // A failed load is reported; Game::initialize then retries synchronously
+    // and logs its own error, as it did before background loading
+    next->finishResources(loader);
+    EOL_LOG_INFO << "Loaded " << loader.getJobCount() << " resources in "
+        << clock.getElapsedTime().asMilliseconds() << " ms";
+
+    handedOver = true;
+    app.popScene();
+    app.pushScene(next);
+}
+
+void LoadingScene::render(sf::RenderWindow& window)
+{
+    const sf::Vector2f barSize = GameSettings::relativeSize(0.4f, 0.02f);
+    const sf::Vector2f barPos = GameSettings::relativePos(0.5f, 0.6f) - barSize * 0.5f;
+
+    sf::RectangleShape frame(barSize);
+    frame.setPosition(barPos);
+    frame.setFillColor(sf::Color(40, 40, 55));
+    frame.setOutlineColor(sf::Color(255, 230, 160));
+    frame.setOutlineThickness(2.f);
+    window.draw(frame);
+
+    sf::RectangleShape fill({ barSize.x * std::clamp(shownProgress, 0.f, 1.f), barSize.y });
+    fill.setPosition(barPos);
+    fill.setFillColor(sf::Color(255, 230, 160));
+    window.draw(fill);
+}
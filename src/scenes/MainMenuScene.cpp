@@ -1,15 +1,25 @@
 ﻿#include "scenes/MainMenuScene.h"
 #include "scenes/OptionsMenuScene.h"
 #include "scenes/GameplayScene.h"
+#include "scenes/LoadingScene.h"
 #include "Application.h"
 #include "GameSettings.h"
-#include <iostream>
+#include "Log.h"
 
 MainMenuScene::MainMenuScene(Application& app)
     : app(app)
 {
-    if (!font.openFromFile("resources/fonts/ScienceGothic.ttf"))
-        std::cout << "Failed to load font!\n";
+}
+
+void MainMenuScene::preload(SceneResources& resources)
+{
+    const sf::Font& font = resources.getUiFont();
+
+    title.emplace(font);
+    title->setString("ECHOES OF LIGHT");
+    title->setCharacterSize(96);
+    title->setFillColor(sf::Color(255, 230, 160));
+    title->setPosition(GameSettings::relativePos(0.20f, 0.15f));
 
     const std::vector<std::string> labels = {
         "Start Game",
@@ -33,6 +43,15 @@ MainMenuScene::MainMenuScene(Application& app)
     buttons[0].setFillColor(sf::Color::Yellow);
 }
 
+void MainMenuScene::onEnter()
+{
+    selectedIndex = 0;
+    updateVisuals();
+
+    // Usually opened from here; have it ready before it is asked for
+    app.preloadScene(app.getScene<OptionsMenuScene>());
+}
+
 void MainMenuScene::updateVisuals()
 {
     for (int i = 0; i < buttons.size(); ++i)
@@ -60,10 +79,10 @@ void MainMenuScene::handleEvent(const sf::Event& event)
     else if (key == sf::Keyboard::Key::Enter)
     {
         if (selectedIndex == 0)
-            app.pushScene(std::make_shared<GameplayScene>(app));
+            app.pushScene(std::make_shared<LoadingScene>(app, std::make_shared<GameplayScene>(app)));
 
         else if (selectedIndex == 1)
-            app.pushScene(std::make_shared<OptionsMenuScene>(app));
+            app.pushScene(app.getScene<OptionsMenuScene>());
 
         else if (selectedIndex == 2)
             app.getWindow().close();
@@ -74,13 +93,7 @@ void MainMenuScene::update(float) {}
 
 void MainMenuScene::render(sf::RenderWindow& window)
 {
-    sf::Text title(font);
-    title.setString("ECHOES OF LIGHT");
-    title.setCharacterSize(96);
-    title.setFillColor(sf::Color(255, 230, 160));
-    title.setPosition(GameSettings::relativePos(0.20f, 0.15f));
-
-    window.draw(title);
+    window.draw(*title);
 
     for (auto& b : buttons)
         window.draw(b);
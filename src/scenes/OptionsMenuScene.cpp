@@ -1,13 +1,16 @@
 ﻿#include "scenes/OptionsMenuScene.h"
 #include "Application.h"
 #include "GameSettings.h"
-#include <iostream>
+#include "Log.h"
 
 OptionsMenuScene::OptionsMenuScene(Application& app)
     : app(app)
 {
-    if (!font.openFromFile("resources/fonts/ScienceGothic.ttf"))
-        std::cout << "Failed to load font!\n";
+}
+
+void OptionsMenuScene::preload(SceneResources& resources)
+{
+    const sf::Font& font = resources.getUiFont();
 
     buttons.clear();
     buttons.reserve(3);
@@ -30,6 +33,12 @@ OptionsMenuScene::OptionsMenuScene(Application& app)
     updateVisuals();
 }
 
+void OptionsMenuScene::onEnter()
+{
+    selectedIndex = 0;
+    updateVisuals();
+}
+
 void OptionsMenuScene::updateVisuals()
 {
     // Update resolution text
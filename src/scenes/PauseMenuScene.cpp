@@ -3,13 +3,24 @@
 #include "scenes/MainMenuScene.h"
 #include "Application.h"
 #include "GameSettings.h"
-#include <iostream>
+#include "Log.h"
 
 PauseMenuScene::PauseMenuScene(Application& app)
     : app(app)
 {
-    if (!font.openFromFile("resources/fonts/ScienceGothic.ttf"))
-        std::cout << "Failed to load font!\n";
+}
+
+void PauseMenuScene::preload(SceneResources& resources)
+{
+    const sf::Font& font = resources.getUiFont();
+
+    title.emplace(font);
+    title->setString("Paused");
+    title->setCharacterSize(96);
+    title->setFillColor(sf::Color(255, 230, 160));
+    title->setPosition(GameSettings::relativePos(0.30f, 0.18f));
+
+    overlay.setFillColor(sf::Color(0, 0, 0, 160));
 
     const std::vector<std::string> labels = {
         "Resume",
@@ -32,6 +43,12 @@ PauseMenuScene::PauseMenuScene(Application& app)
     buttons[0].setFillColor(sf::Color::Yellow);
 }
 
+void PauseMenuScene::onEnter()
+{
+    selectedIndex = 0;
+    updateVisuals();
+}
+
 void PauseMenuScene::updateVisuals()
 {
     for (int i = 0; i < buttons.size(); ++i)
@@ -75,32 +92,31 @@ void PauseMenuScene::activateSelection()
         break;
 
     case 1: // Options
-        app.pushScene(std::make_shared<OptionsMenuScene>(app));
+        app.pushScene(app.getScene<OptionsMenuScene>());
         break;
 
     case 2: // Quit to Main Menu
+    {
         app.popScene(); 
         app.popScene(); 
-        app.pushScene(std::make_shared<MainMenuScene>(app));
+
+        // The menu is normally still under the game; a replay starts without it
+        auto menu = app.getScene<MainMenuScene>();
+        if (!app.isSceneOnStack(menu))
+            app.pushScene(menu);
         break;
     }
+    }
 }
 
 void PauseMenuScene::update(float) {}
 
 void PauseMenuScene::render(sf::RenderWindow& window)
 {
-    sf::RectangleShape overlay;
     overlay.setSize(sf::Vector2f(window.getSize()));
-    overlay.setFillColor(sf::Color(0, 0, 0, 160));
     window.draw(overlay);
 
-    sf::Text title(font);
-    title.setString("Paused");
-    title.setCharacterSize(96);
-    title.setFillColor(sf::Color(255, 230, 160));
-    title.setPosition(GameSettings::relativePos(0.30f, 0.18f));
-    window.draw(title);
+    window.draw(*title);
 
     for (auto& b : buttons)
         window.draw(b);
@@ -0,0 +1,15 @@
+#include "scenes/SceneResources.h"
+#include "Log.h"
+
+const sf::Font& SceneResources::getFont(const std::string& path)
+{
+    auto it = fonts.find(path);
+    if (it != fonts.end())
+        return *it->second;
+
+    auto font = std::make_unique<sf::Font>();
+    if (!font->openFromFile(path))
+        EOL_LOG_ERROR << "Failed to load font: " << path;
+
+    return *fonts.emplace(path, std::move(font)).first->second;
+}
@@ -1,5 +1,6 @@
 ﻿#include "scenes/SceneStack.h"
 #include <algorithm>
+#include "Log.h"
 
 void SceneStack::pushScene(std::shared_ptr<Scene> scene)
 {
@@ -21,8 +22,7 @@ void SceneStack::replaceScene(std::shared_ptr<Scene> scene)
         scenes.back()->onExit();
         scenes.pop_back();
     }
-    scenes.push_back(scene);
-    scene->onEnter();
+    enter(scene);
 }
 
 void SceneStack::clear()
@@ -32,6 +32,9 @@ void SceneStack::clear()
 
 void SceneStack::handleEvent(const sf::Event& event)
 {
+    // Buffer into the action map even if no scene consumes the event
+    input.handleEvent(event);
+
     if (!scenes.empty())
         scenes.back()->handleEvent(event);
 }
@@ -47,7 +50,50 @@ void SceneStack::update(float dt)
             break;
     }
 
+    // Edges are only valid for the frame they happened in
+    input.endFrame();
+
     applyPendingActions();
+
+    // Idle-time preloading, one scene per frame
+    if (!preloadQueue.empty())
+    {
+        ensurePreloaded(*preloadQueue.front());
+        preloadQueue.erase(preloadQueue.begin());
+    }
+}
+
+void SceneStack::queuePreload(std::shared_ptr<Scene> scene)
+{
+    if (scene && !scene->preloaded)
+        preloadQueue.push_back(std::move(scene));
+}
+
+void SceneStack::ensurePreloaded(Scene& scene)
+{
+    if (scene.preloaded)
+        return;
+    scene.preload(resources);
+    scene.preloaded = true;
+}
+
+void SceneStack::enter(const std::shared_ptr<Scene>& scene)
+{
+    // Cached scenes can be asked for twice (e.g. the menu under a session)
+    if (contains(scene))
+    {
+        EOL_LOG_WARNING << "SceneStack: scene is already on the stack, not pushed again";
+        return;
+    }
+
+    ensurePreloaded(*scene);
+    scenes.push_back(scene);
+    scene->onEnter();
+}
+
+bool SceneStack::contains(const std::shared_ptr<Scene>& scene) const
+{
+    return std::find(scenes.begin(), scenes.end(), scene) != scenes.end();
 }
 
 void SceneStack::applyPendingActions()
@@ -58,10 +104,7 @@ void SceneStack::applyPendingActions()
         {
         case ActionType::Push:
             if (action.scene)
-            {
-                scenes.push_back(action.scene);
-                action.scene->onEnter();
-            }
+                enter(action.scene);
             break;
 
         case ActionType::Pop:
@@ -2,14 +2,83 @@
 
 #include "components/AnimationComponent.h"
 
+#include <algorithm>
+
+namespace {
+// Moves every animation forward by deltaTime. Several frames may pass in one
+// step (long frame, short clip frames); the time left over carries into the
+// next frame instead of being dropped. Finished one-shot clips hold their
+// last frame, and rows without a playable clip are left as they are. Every
+// row takes the same path, picking results with selects, so the loop
+// vectorises.
+void advanceAnimations(std::size_t count,
+                       int* frame,
+                       float* elapsed,
+                       std::uint8_t* finished,
+                       const int* frameCount,
+                       const float* frameDuration,
+                       const std::uint8_t* loop,
+                       const std::uint8_t* running,
+                       float deltaTime) {
+    for (std::size_t i = 0; i < count; ++i) {
+        const float duration = frameDuration[i];
+        const float time = elapsed[i] + deltaTime;
+        const int steps = static_cast<int>(time / duration);
+        const float remainder = std::max(0.f, time - static_cast<float>(steps) * duration);
+
+        const int next = frame[i] + steps;
+        const int last = frameCount[i] - 1;
+        const bool loops = loop[i] != 0;
+        const bool idle = running[i] == 0;
+        const bool ended = !loops & (next > last);
+        const bool holding = (finished[i] != 0) & !loops;
+
+        const int advanced = loops ? next % frameCount[i] : std::min(next, last);
+        frame[i] = (holding | idle) ? frame[i] : advanced;
+        elapsed[i] = idle ? elapsed[i] : ((holding | ended) ? 0.f : remainder);
+        finished[i] = idle ? finished[i] : static_cast<std::uint8_t>(holding | ended);
+    }
+}
+}
+
 void AnimationSystem::update(std::vector<Entity*>& entities, float deltaTime) {
+    if (m_entities.changed(entities)) {
+        syncAnimations(entities);
+    }
+
+    eol::AnimationStore& store = m_animations;
+    advanceAnimations(store.size(), store.frame.data(), store.elapsed.data(), store.finished.data(),
+                      store.frameCount.data(), store.frameDuration.data(), store.loop.data(),
+                      store.running.data(), deltaTime);
+    store.refreshFrameRects();
+}
+
+void AnimationSystem::syncAnimations(std::vector<Entity*>& entities) {
+    eol::AnimationStore& store = m_animations;
+    m_seen.assign(store.size(), 0);
+
+    // Whether a component is enabled is read here, when the list changes
     for (Entity* entity : entities) {
         if (!entity) continue;
 
         auto* animation = entity->getComponent<eol::AnimationComponent>();
-        if (animation && animation->isEnabled()) {
-            animation->update(deltaTime);
+        if (!animation || !animation->isEnabled()) {
+            continue;
+        }
+
+        if (store.holds(*animation)) {
+            m_seen[store.slotOf(*animation)] = 1;
+        }
+        else {
+            store.attach(*animation);
+            m_seen.push_back(1);
         }
     }
-}
 
+    // Walking backwards, the row moved into a hole is always one already kept
+    for (std::size_t i = store.size(); i-- > 0;) {
+        if (!m_seen[i]) {
+            store.detach(*store.animations[i]);
+        }
+    }
+}
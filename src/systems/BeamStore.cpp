@@ -0,0 +1,161 @@
+#include "systems/BeamStore.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+constexpr float kEpsilon = 0.0001f;
+} // namespace
+
+void BeamStore::Bucket::clear() {
+    head = 0;
+    start.clear();
+    end.clear();
+    color.clear();
+    width.clear();
+    ttl.clear();
+    lifetime.clear();
+    invLifetime.clear();
+    intensity.clear();
+    peakAlpha.clear();
+    quad.clear();
+}
+
+BeamStore::BeamStore(std::size_t maxSegments)
+    : m_maxSegments(std::max<std::size_t>(1, maxSegments)) {
+    m_mesh.reserve(6 * 256);
+    m_quadOwners.reserve(256);
+}
+
+std::int64_t BeamStore::tickFor(double time) const {
+    return static_cast<std::int64_t>(std::floor(time / kBucketSeconds));
+}
+
+BeamStore::Bucket& BeamStore::bucketFor(std::int64_t tick) {
+    return m_buckets[static_cast<std::size_t>(tick) % kBucketCount];
+}
+
+void BeamStore::add(const Segment& segment) {
+    if (m_size >= m_maxSegments) {
+        evictOldest();
+    }
+
+    const std::int64_t lastTick = m_currentTick + static_cast<std::int64_t>(kBucketCount) - 1;
+    const std::int64_t tick = std::clamp(tickFor(m_clock + std::max(0.f, segment.ttl)), m_currentTick, lastTick);
+    const auto bucketIndex = static_cast<std::uint32_t>(static_cast<std::size_t>(tick) % kBucketCount);
+    Bucket& bucket = m_buckets[bucketIndex];
+
+    bucket.start.push_back(segment.start);
+    bucket.end.push_back(segment.end);
+    bucket.color.push_back(segment.color);
+    bucket.width.push_back(segment.width);
+    bucket.ttl.push_back(segment.ttl);
+    bucket.lifetime.push_back(segment.lifetime);
+    bucket.invLifetime.push_back(segment.lifetime > 0.f ? 1.f / segment.lifetime : 0.f);
+    bucket.intensity.push_back(segment.intensity);
+    bucket.peakAlpha.push_back(segment.color.a * std::clamp(segment.intensity / 50.f, 0.2f, 1.f));
+    bucket.quad.push_back(static_cast<std::uint32_t>(m_quadOwners.size()));
+    m_quadOwners.push_back(QuadOwner{bucketIndex, static_cast<std::uint32_t>(bucket.ttl.size() - 1)});
+
+    // Zero-length beams keep their slot as a degenerate quad
+    const sf::Vector2f dir = segment.end - segment.start;
+    sf::Vector2f normal{0.f, 0.f};
+    const float length = std::sqrt(dir.x * dir.x + dir.y * dir.y);
+    if (length > kEpsilon) {
+        const float halfWidth = segment.width * 0.5f;
+        normal = sf::Vector2f{-dir.y / length * halfWidth, dir.x / length * halfWidth};
+    }
+
+    const sf::Vector2f corners[6] = {
+        segment.start + normal, segment.start - normal, segment.end + normal,
+        segment.start - normal, segment.end - normal, segment.end + normal,
+    };
+    const float life = std::min(1.f, std::max(0.f, segment.ttl * bucket.invLifetime.back()));
+    sf::Color color = segment.color;
+    color.a = static_cast<std::uint8_t>(bucket.peakAlpha.back() * life);
+    for (const sf::Vector2f& corner : corners) {
+        m_mesh.push_back(sf::Vertex{corner, color});
+    }
+
+    ++m_size;
+}
+
+void BeamStore::evictOldest() {
+    for (std::size_t offset = 0; offset < kBucketCount; ++offset) {
+        Bucket& bucket = bucketFor(m_currentTick + static_cast<std::int64_t>(offset));
+        if (bucket.live() == 0) {
+            continue;
+        }
+
+        releaseQuad(bucket.quad[bucket.head]);
+        ++bucket.head;
+        if (bucket.head == bucket.ttl.size()) {
+            bucket.clear();
+        }
+        --m_size;
+        ++m_evicted;
+        return;
+    }
+}
+
+void BeamStore::advance(float deltaTime) {
+    if (m_size == 0) {
+        // Nothing to age; just keep the clock moving
+        m_clock += deltaTime;
+        m_currentTick = tickFor(m_clock);
+        return;
+    }
+
+    m_clock += deltaTime;
+    const std::int64_t newTick = tickFor(m_clock);
+    const std::int64_t expired = std::min<std::int64_t>(newTick - m_currentTick, kBucketCount);
+    for (std::int64_t i = 0; i < expired; ++i) {
+        Bucket& bucket = bucketFor(m_currentTick + i);
+        for (std::size_t s = bucket.head; s < bucket.quad.size(); ++s) {
+            releaseQuad(bucket.quad[s]);
+        }
+        m_size -= bucket.live();
+        bucket.clear();
+    }
+    m_currentTick = newTick;
+
+    // Age the survivors and write their fade straight into the mesh
+    sf::Vertex* mesh = m_mesh.data();
+    for (Bucket& bucket : m_buckets) {
+        float* ttl = bucket.ttl.data();
+        const float* invLifetime = bucket.invLifetime.data();
+        const float* peakAlpha = bucket.peakAlpha.data();
+        const std::uint32_t* quad = bucket.quad.data();
+        const std::size_t count = bucket.ttl.size();
+        for (std::size_t i = bucket.head; i < count; ++i) {
+            ttl[i] = std::max(0.f, ttl[i] - deltaTime);
+            const float life = std::min(1.f, ttl[i] * invLifetime[i]);
+            const auto alpha = static_cast<std::uint8_t>(peakAlpha[i] * life);
+            sf::Vertex* vertices = mesh + std::size_t{quad[i]} * 6;
+            for (int v = 0; v < 6; ++v) {
+                vertices[v].color.a = alpha;
+            }
+        }
+    }
+}
+
+void BeamStore::releaseQuad(std::uint32_t quad) {
+    const auto last = static_cast<std::uint32_t>(m_quadOwners.size() - 1);
+    if (quad != last) {
+        std::copy_n(m_mesh.begin() + std::size_t{last} * 6, 6, m_mesh.begin() + std::size_t{quad} * 6);
+        const QuadOwner moved = m_quadOwners[last];
+        m_quadOwners[quad] = moved;
+        m_buckets[moved.bucket].quad[moved.index] = quad;
+    }
+    m_quadOwners.pop_back();
+    m_mesh.resize(m_mesh.size() - 6);
+}
+
+void BeamStore::clear() {
+    for (Bucket& bucket : m_buckets) {
+        bucket.clear();
+    }
+    m_mesh.clear();
+    m_quadOwners.clear();
+    m_size = 0;
+}
@@ -0,0 +1,64 @@
+#include "systems/Camera.h"
+
+#include "GameSettings.h"
+
+#include <algorithm>
+#include <cmath>
+
+Camera::Camera()
+    : m_worldBounds({ 0.f, 0.f }, { GameSettings::width(), GameSettings::height() })
+    , m_viewSize(GameSettings::width(), GameSettings::height())
+    , m_center(GameSettings::center()) {
+}
+
+void Camera::setWorldBounds(const sf::FloatRect& bounds) {
+    m_worldBounds = bounds;
+    m_center = clampCenter(m_center);
+}
+
+const sf::FloatRect& Camera::getWorldBounds() const noexcept {
+    return m_worldBounds;
+}
+
+void Camera::follow(const sf::Vector2f& target, float deltaTime) {
+    // Frame-rate independent exponential ease
+    const float blend = 1.f - std::exp(-m_followRate * std::max(0.f, deltaTime));
+    m_center = clampCenter(m_center + (target - m_center) * blend);
+}
+
+void Camera::snapTo(const sf::Vector2f& target) {
+    m_center = clampCenter(target);
+}
+
+void Camera::setFollowRate(float rate) noexcept {
+    m_followRate = std::max(0.f, rate);
+}
+
+sf::Vector2f Camera::getCenter() const noexcept {
+    return m_center;
+}
+
+sf::FloatRect Camera::getViewRect() const {
+    return sf::FloatRect(m_center - m_viewSize * 0.5f, m_viewSize);
+}
+
+sf::Vector2f Camera::clampCenter(const sf::Vector2f& center) const {
+    const sf::Vector2f half = m_viewSize * 0.5f;
+    const sf::Vector2f worldMin = m_worldBounds.position;
+    const sf::Vector2f worldMax = m_worldBounds.position + m_worldBounds.size;
+
+    auto clampAxis = [](float value, float low, float high, float halfView) {
+        if (high - low <= halfView * 2.f) {
+            return (low + high) * 0.5f;
+        }
+        return std::clamp(value, low + halfView, high - halfView);
+    };
+
+    return sf::Vector2f(
+        clampAxis(center.x, worldMin.x, worldMax.x, half.x),
+        clampAxis(center.y, worldMin.y, worldMax.y, half.y));
+}
+
+sf::FloatRect viewBounds(const sf::View& view) {
+    return sf::FloatRect(view.getCenter() - view.getSize() * 0.5f, view.getSize());
+}
@@ -2,13 +2,10 @@
 #include "Systems.h"
 #include "components/CollisionComponent.h"
 #include "components/TransformComponent.h"
+#include "systems/Geometry.h"
 
 bool CollisionSystem::checkOverlap(const sf::FloatRect& a, const sf::FloatRect& b) {
-    // Standard AABB overlap check
-    return a.position.x < b.position.x + b.size.x &&
-           a.position.x + a.size.x > b.position.x &&
-           a.position.y < b.position.y + b.size.y &&
-           a.position.y + a.size.y > b.position.y;
+    return geometry::boxesOverlap(a, b);
 }
 
 sf::FloatRect CollisionSystem::getBounds(Entity& entity) {
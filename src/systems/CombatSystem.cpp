@@ -7,9 +7,9 @@
 #include "components/PlayerComponent.h"
 #include "components/RenderComponent.h"
 #include "components/TransformComponent.h"
+#include "Log.h"
 
 #include <algorithm>
-#include <iostream>
 namespace {
 
 float clampf(float value, float minValue, float maxValue) {
@@ -151,9 +151,9 @@ void CombatSystem::applyPlayerDamage(Entity& attacker, Entity& target, float dam
     if (auto* render = target.getComponent<eol::RenderComponent>()) {
         render->setTint(sf::Color(255, 160, 160, 220));
     }
-    std::cout << "Player damaged: " << damage << std::endl;
-    std::cout << "Player health: " << player->getHealth() << std::endl;
-    std::cout << "Player max health: " << player->getMaxHealth() << std::endl;
+    EOL_LOG_DEBUG << "Player damaged: " << damage;
+    EOL_LOG_DEBUG << "Player health: " << player->getHealth();
+    EOL_LOG_DEBUG << "Player max health: " << player->getMaxHealth();
 }
 
 Entity* CombatSystem::findPlayer(const std::vector<Entity*>& entities) const {
@@ -1,5 +1,6 @@
 #include "systems/DialogSystem.h"
 #include "GameSettings.h"
+#include "WorldSnapshot.h"
 #include <algorithm>
 #include <cmath>
 
@@ -9,7 +10,6 @@ DialogSystem::DialogSystem()
     , m_dialogQueue()
     , m_currentLineIndex(0)
     , m_fullText()
-    , m_displayedText()
     , m_typewriterTimer(0.f)
     , m_charsPerSecond(40.f)
     , m_currentCharIndex(0)
@@ -18,10 +18,11 @@ DialogSystem::DialogSystem()
     , m_boxBackground()
     , m_nameBackground()
     , m_nameText(nullptr)
-    , m_dialogText(nullptr)
     , m_continueIndicator(nullptr)
+    , m_dialogLayout()
+    , m_dialogTextSize(0)
+    , m_dialogWrapWidth(0.f)
     , m_boxOpacity(0.85f)
-    , m_advanceKeyWasPressed(false)
     , m_indicatorTimer(0.f)
 {
 }
@@ -31,16 +32,14 @@ bool DialogSystem::initialize(const sf::Font& font) {
     
     // SFML 3.x: Create text objects with font reference
     m_nameText = std::make_unique<sf::Text>(font);
-    m_dialogText = std::make_unique<sf::Text>(font);
     m_continueIndicator = std::make_unique<sf::Text>(font);
     
     // Configure text sizes (relative to screen)
     unsigned int nameSize = static_cast<unsigned int>(GameSettings::relativeMin(0.028f));
-    unsigned int textSize = static_cast<unsigned int>(GameSettings::relativeMin(0.024f));
+    m_dialogTextSize = static_cast<unsigned int>(GameSettings::relativeMin(0.024f));
     unsigned int indicatorSize = static_cast<unsigned int>(GameSettings::relativeMin(0.018f));
     
     m_nameText->setCharacterSize(nameSize);
-    m_dialogText->setCharacterSize(textSize);
     m_continueIndicator->setCharacterSize(indicatorSize);
     
     m_continueIndicator->setString("Press ENTER to continue...");
@@ -97,12 +96,11 @@ void DialogSystem::setupBoxGeometry() {
         ));
     }
     
-    if (m_dialogText) {
-        m_dialogText->setPosition(sf::Vector2f(
-            boxX + textPadding,
-            boxY + textPadding
-        ));
-    }
+    m_dialogLayout.setPosition(sf::Vector2f(
+        boxX + textPadding,
+        boxY + textPadding
+    ));
+    m_dialogWrapWidth = boxWidth - textPadding * 2.f;
     
     // Continue indicator in bottom-right of dialog box
     if (m_continueIndicator) {
@@ -114,39 +112,25 @@ void DialogSystem::setupBoxGeometry() {
 }
 
 void DialogSystem::startDialog(const std::vector<DialogLine>& lines) {
-    if (!m_initialized || lines.empty() || !m_nameText || !m_dialogText) {
+    if (!m_initialized || lines.empty() || !m_nameText) {
         return;
     }
     
     m_dialogQueue = lines;
     m_currentLineIndex = 0;
-    
-    // Set up the first line
-    const DialogLine& firstLine = m_dialogQueue[0];
-    m_fullText = firstLine.text;
-    m_displayedText.clear();
     m_currentCharIndex = 0;
     m_typewriterTimer = 0.f;
     
-    // Set speaker name and colors
-    m_nameText->setString(firstLine.speaker);
-    const SpeakerStyle& style = getSpeakerStyle(firstLine.speaker);
-    m_nameText->setFillColor(style.nameColor);
-    m_dialogText->setFillColor(style.textColor);
+    // Set up the first line
+    showLine(m_dialogQueue[0]);
 }
 
 void DialogSystem::queueLine(const std::string& speaker, const std::string& text) {
     m_dialogQueue.emplace_back(speaker, text);
     
     // If this is the first line and nothing is playing, start it
-    if (m_dialogQueue.size() == 1 && m_currentLineIndex == 0 && m_displayedText.empty()) {
-        if (m_nameText && m_dialogText) {
-            m_fullText = text;
-            m_nameText->setString(speaker);
-            const SpeakerStyle& style = getSpeakerStyle(speaker);
-            m_nameText->setFillColor(style.nameColor);
-            m_dialogText->setFillColor(style.textColor);
-        }
+    if (m_dialogQueue.size() == 1 && m_currentLineIndex == 0 && m_currentCharIndex == 0) {
+        showLine(m_dialogQueue[0]);
     }
 }
 
@@ -154,17 +138,17 @@ void DialogSystem::clear() {
     m_dialogQueue.clear();
     m_currentLineIndex = 0;
     m_fullText.clear();
-    m_displayedText.clear();
+    m_dialogLayout.clear();
     m_currentCharIndex = 0;
     m_typewriterTimer = 0.f;
 }
 
-void DialogSystem::update(float deltaTime) {
-    if (!isActive() || !m_dialogText) {
+void DialogSystem::update(float deltaTime, const InputFrame& input) {
+    if (!isActive()) {
         return;
     }
     
-    // Update typewriter effect
+    // Update typewriter effect; render draws the first m_currentCharIndex glyphs
     if (m_currentCharIndex < m_fullText.size()) {
         m_typewriterTimer += deltaTime;
         float timePerChar = 1.f / m_charsPerSecond;
@@ -172,8 +156,6 @@ void DialogSystem::update(float deltaTime) {
         while (m_typewriterTimer >= timePerChar && m_currentCharIndex < m_fullText.size()) {
             m_typewriterTimer -= timePerChar;
             m_currentCharIndex++;
-            m_displayedText = m_fullText.substr(0, m_currentCharIndex);
-            m_dialogText->setString(m_displayedText);
         }
     }
     
@@ -186,14 +168,46 @@ void DialogSystem::update(float deltaTime) {
         m_continueIndicator->setFillColor(indicatorColor);
     }
     
-    // Handle input (real-time polling for responsiveness)
-    bool advancePressed = sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Enter);
-    
-    if (advancePressed && !m_advanceKeyWasPressed) {
+    // Advance on the press edge only, holding Enter does not skip lines
+    if (input.wasPressed(InputAction::Advance)) {
         advance();
     }
-    
-    m_advanceKeyWasPressed = advancePressed;
+}
+
+void DialogSystem::saveState(SnapshotWriter& out) const {
+    out.write(static_cast<std::uint32_t>(m_dialogQueue.size()));
+    for (const DialogLine& line : m_dialogQueue) {
+        out.writeString(line.speaker);
+        out.writeString(line.text);
+    }
+    out.write(static_cast<std::uint32_t>(m_currentLineIndex));
+    out.write(static_cast<std::uint32_t>(m_currentCharIndex));
+    out.write(m_typewriterTimer);
+    out.write(m_indicatorTimer);
+}
+
+void DialogSystem::loadState(SnapshotReader& in) {
+    const std::uint32_t lineCount = in.read<std::uint32_t>();
+    m_dialogQueue.clear();
+    for (std::uint32_t i = 0; i < lineCount && !in.hasFailed(); ++i) {
+        std::string speaker;
+        std::string text;
+        in.readString(speaker);
+        in.readString(text);
+        m_dialogQueue.emplace_back(speaker, text);
+    }
+    m_currentLineIndex = in.read<std::uint32_t>();
+    m_currentCharIndex = in.read<std::uint32_t>();
+    in.read(m_typewriterTimer);
+    in.read(m_indicatorTimer);
+
+    // Rebuild the layout for the restored line
+    m_fullText.clear();
+    m_dialogLayout.clear();
+    if (m_currentLineIndex < m_dialogQueue.size()) {
+        showLine(m_dialogQueue[m_currentLineIndex]);
+        m_currentCharIndex = std::min(m_currentCharIndex, m_fullText.size());
+    }
 }
 
 void DialogSystem::render(sf::RenderWindow& window) {
@@ -209,9 +223,7 @@ void DialogSystem::render(sf::RenderWindow& window) {
     if (m_nameText) {
         window.draw(*m_nameText);
     }
-    if (m_dialogText) {
-        window.draw(*m_dialogText);
-    }
+    m_dialogLayout.draw(window, m_currentCharIndex);
     
     // Draw continue indicator if line is complete
     if (isLineComplete() && m_continueIndicator) {
@@ -235,10 +247,6 @@ void DialogSystem::advance() {
     if (!isLineComplete()) {
         // Skip to end of current line
         m_currentCharIndex = m_fullText.size();
-        m_displayedText = m_fullText;
-        if (m_dialogText) {
-            m_dialogText->setString(m_displayedText);
-        }
     }
     else {
         // Move to next line
@@ -251,20 +259,9 @@ void DialogSystem::advanceToNextLine() {
     
     if (m_currentLineIndex < m_dialogQueue.size()) {
         // Set up the next line
-        const DialogLine& line = m_dialogQueue[m_currentLineIndex];
-        m_fullText = line.text;
-        m_displayedText.clear();
         m_currentCharIndex = 0;
         m_typewriterTimer = 0.f;
-        
-        // Update speaker
-        if (m_nameText && m_dialogText) {
-            m_nameText->setString(line.speaker);
-            const SpeakerStyle& style = getSpeakerStyle(line.speaker);
-            m_nameText->setFillColor(style.nameColor);
-            m_dialogText->setFillColor(style.textColor);
-            m_dialogText->setString("");
-        }
+        showLine(m_dialogQueue[m_currentLineIndex]);
     }
     else {
         // Dialog complete - clear everything
@@ -272,6 +269,19 @@ void DialogSystem::advanceToNextLine() {
     }
 }
 
+// Speaker name, colours and the full glyph layout of a line
+void DialogSystem::showLine(const DialogLine& line) {
+    m_fullText = line.text;
+    if (!m_font || !m_nameText) {
+        return;
+    }
+
+    const SpeakerStyle& style = getSpeakerStyle(line.speaker);
+    m_nameText->setString(line.speaker);
+    m_nameText->setFillColor(style.nameColor);
+    m_dialogLayout.build(*m_font, m_fullText, m_dialogTextSize, m_dialogWrapWidth, style.textColor);
+}
+
 void DialogSystem::registerSpeaker(const std::string& name, const SpeakerStyle& style) {
     m_speakerStyles[name] = style;
 }
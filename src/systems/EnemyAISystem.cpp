@@ -6,11 +6,22 @@
 #include "components/RenderComponent.h"
 #include "components/TransformComponent.h"
 #include "systems/CollisionSystem.h"
+#include "systems/Geometry.h"
 #include "GameSettings.h"
 
+#include <algorithm>
 #include <cmath>
 
 namespace {
+// Steering weights (desired direction has weight 1)
+constexpr float kSeparationWeight = 1.6f;
+constexpr float kAlignmentWeight = 0.35f;
+constexpr float kAvoidanceWeight = 1.8f;
+// How quickly velocity turns towards the steering target (1/s)
+constexpr float kSteeringResponse = 10.f;
+// Spreads agents that were spawned on the exact same point
+constexpr float kGoldenAngle = 2.39996323f;
+
 float lengthSquared(const sf::Vector2f& value) {
     return value.x * value.x + value.y * value.y;
 }
@@ -23,8 +34,47 @@ sf::Vector2f normalizeVector(const sf::Vector2f& value) {
     const float invLen = 1.f / std::sqrt(lenSq);
     return sf::Vector2f{value.x * invLen, value.y * invLen};
 }
+
+sf::Vector2f closestPointOnRect(const sf::Vector2f& point, const sf::FloatRect& rect) {
+    return sf::Vector2f{
+        std::clamp(point.x, rect.position.x, rect.position.x + rect.size.x),
+        std::clamp(point.y, rect.position.y, rect.position.y + rect.size.y)};
+}
+
+sf::FloatRect squareAround(const sf::Vector2f& center, float halfExtent) {
+    return sf::FloatRect(
+        sf::Vector2f{center.x - halfExtent, center.y - halfExtent},
+        sf::Vector2f{halfExtent * 2.f, halfExtent * 2.f});
+}
 } // namespace
 
+EnemyAISystem::EnemyAISystem()
+    : m_agentGrid(GameSettings::relativeMin(0.045f))
+    , m_solidGrid(GameSettings::relativeMin(0.06f))
+    , m_separationRadius(GameSettings::relativeMin(0.045f)) {
+}
+
+void EnemyAISystem::setCrowdSteeringEnabled(bool enabled) noexcept {
+    m_crowdSteering = enabled;
+}
+
+bool EnemyAISystem::isCrowdSteeringEnabled() const noexcept {
+    return m_crowdSteering;
+}
+
+void EnemyAISystem::setSeparationRadius(float radius) noexcept {
+    m_separationRadius = std::max(1.f, radius);
+    m_agentGrid.setCellSize(m_separationRadius);
+}
+
+float EnemyAISystem::getSeparationRadius() const noexcept {
+    return m_separationRadius;
+}
+
+void EnemyAISystem::setWorldBounds(const sf::FloatRect& bounds) noexcept {
+    m_worldBounds = bounds;
+}
+
 void EnemyAISystem::update(std::vector<Entity*>& entities, float deltaTime, Entity& player) {
     auto* playerTransform = player.getComponent<eol::TransformComponent>();
     if (!playerTransform) {
@@ -33,21 +83,18 @@ void EnemyAISystem::update(std::vector<Entity*>& entities, float deltaTime, Enti
 
     const sf::Vector2f playerPos = playerTransform->getPosition();
 
-    for (Entity* entity : entities) {
-        if (!entity) continue;
+    buildNeighbourGrids(entities, deltaTime);
 
-        auto* ai = entity->getComponent<eol::EnemyAIComponent>();
-        auto* transform = entity->getComponent<eol::TransformComponent>();
-        if (!ai || !transform || !ai->isEnabled()) {
-            continue;
-        }
+    for (std::size_t i = 0; i < m_agents.size(); ++i) {
+        Agent& agent = m_agents[i];
+        eol::EnemyAIComponent& ai = *agent.ai;
 
-        const sf::Vector2f enemyPos = transform->getPosition();
+        const sf::Vector2f enemyPos = agent.position;
         const sf::Vector2f toPlayer = playerPos - enemyPos;
         const float distanceSq = lengthSquared(toPlayer);
-        const float attackRange = ai->getAttackRange();
-        const float detectionRange = ai->getDetectionRange();
-        const bool hasLos = hasLineOfSight(enemyPos, playerPos, entities, entity, &player);
+        const float attackRange = ai.getAttackRange();
+        const float detectionRange = ai.getDetectionRange();
+        const bool hasLos = hasLineOfSight(enemyPos, playerPos, agent.entity, &player);
 
         eol::EnemyAIComponent::BehaviorState nextState = eol::EnemyAIComponent::BehaviorState::Patrol;
         if (hasLos && distanceSq <= attackRange * attackRange) {
@@ -57,38 +104,88 @@ void EnemyAISystem::update(std::vector<Entity*>& entities, float deltaTime, Enti
             nextState = eol::EnemyAIComponent::BehaviorState::Chase;
         }
 
-        ai->setState(nextState);
-        if (ai->isEnabled()) {
-            driveBehavior(*entity, *ai, playerPos, deltaTime, entities);
+        ai.setState(nextState);
+        if (ai.isEnabled()) {
+            driveBehavior(i, playerPos, deltaTime);
         }
     }
 }
 
-void EnemyAISystem::driveBehavior(Entity& entity,
-                                  eol::EnemyAIComponent& ai,
+// One pass over the entity list: enemies go into the agent grid,
+// solid colliders into the obstacle grid. Everything after this only
+// looks at local grid cells instead of the whole entity list.
+void EnemyAISystem::buildNeighbourGrids(std::vector<Entity*>& entities, float deltaTime) {
+    m_agents.clear();
+    m_agentBounds.clear();
+    m_solidEntities.clear();
+    m_solidBounds.clear();
+    m_solidReach.clear();
+
+    for (Entity* entity : entities) {
+        if (!entity) continue;
+
+        std::size_t solid = kNotSolid;
+        if (auto* collision = entity->getComponent<eol::CollisionComponent>(); collision && collision->isSolid()) {
+            solid = m_solidBounds.size();
+            m_solidEntities.push_back(entity);
+            m_solidBounds.push_back(CollisionSystem::getBounds(*entity));
+            m_solidReach.push_back(m_solidBounds.back());
+        }
+
+        auto* ai = entity->getComponent<eol::EnemyAIComponent>();
+        auto* transform = entity->getComponent<eol::TransformComponent>();
+        if (!ai || !transform || !ai->isEnabled()) {
+            continue;
+        }
+
+        if (solid != kNotSolid) {
+            // Steering blends towards moveSpeed from the current velocity,
+            // so a move never goes further than the larger of the two
+            const float reach = std::max(ai->getMoveSpeed(), std::sqrt(lengthSquared(ai->getVelocity()))) * deltaTime;
+            sf::FloatRect& grown = m_solidReach.back();
+            grown.position -= sf::Vector2f{reach, reach};
+            grown.size += sf::Vector2f{reach * 2.f, reach * 2.f};
+        }
+
+        m_agents.push_back(Agent{
+            entity,
+            ai,
+            transform,
+            entity->getComponent<eol::CollisionComponent>(),
+            transform->getPosition(),
+            ai->getVelocity(),
+            solid });
+        m_agentBounds.push_back(squareAround(transform->getPosition(), 0.f));
+    }
+
+    m_agentGrid.setCellSize(m_separationRadius);
+    m_agentGrid.build(m_agentBounds);
+    m_solidGrid.build(m_solidReach);
+}
+
+void EnemyAISystem::driveBehavior(std::size_t agentIndex,
                                   const sf::Vector2f& playerPos,
-                                  float deltaTime,
-                                  std::vector<Entity*>& entities) {
-    switch (ai.getState()) {
+                                  float deltaTime) {
+    Agent& agent = m_agents[agentIndex];
+    switch (agent.ai->getState()) {
         case eol::EnemyAIComponent::BehaviorState::Attack:
-            executeAttack(entity);
+            executeAttack(agent);
             break;
         case eol::EnemyAIComponent::BehaviorState::Chase:
-            executeChase(entity, ai, playerPos, deltaTime, entities);
+            executeChase(agentIndex, playerPos, deltaTime);
             break;
         case eol::EnemyAIComponent::BehaviorState::Patrol:
         default:
-            executePatrol(entity, ai, deltaTime, entities);
+            executePatrol(agentIndex, deltaTime);
             break;
     }
 }
 
-void EnemyAISystem::executePatrol(Entity& entity,
-                                  eol::EnemyAIComponent& ai,
-                                  float deltaTime,
-                                  std::vector<Entity*>& entities) {
-    auto* transform = entity.getComponent<eol::TransformComponent>();
-    auto* collision = entity.getComponent<eol::CollisionComponent>();
+void EnemyAISystem::executePatrol(std::size_t agentIndex, float deltaTime) {
+    Agent& agent = m_agents[agentIndex];
+    Entity& entity = *agent.entity;
+    eol::EnemyAIComponent& ai = *agent.ai;
+
     auto* melee = entity.getComponent<eol::MeleeAttackComponent>();
     if (melee) {
         melee->setEnabled(false);
@@ -98,7 +195,7 @@ void EnemyAISystem::executePatrol(Entity& entity,
     }
 
     const auto& points = ai.getPatrolPoints();
-    if (points.empty() || !transform) {
+    if (points.empty()) {
         return;
     }
 
@@ -108,44 +205,26 @@ void EnemyAISystem::executePatrol(Entity& entity,
     }
 
     const sf::Vector2f target = points[targetIndex];
-    sf::Vector2f delta = target - transform->getPosition();
+    sf::Vector2f delta = target - agent.position;
 
-    if (lengthSquared(delta) < 16.f) {
+    // Crowded agents cannot all stand on the exact patrol point,
+    // so accept arriving anywhere inside half the separation radius
+    const float arriveRadius = m_crowdSteering ? std::max(4.f, m_separationRadius * 0.5f) : 4.f;
+    if (lengthSquared(delta) < arriveRadius * arriveRadius) {
         ai.advancePatrolPoint();
         return;
     }
 
-    const sf::Vector2f direction = normalizeVector(delta);
-    const float speed = ai.getMoveSpeed();
-    const sf::Vector2f currentPos = transform->getPosition();
-    sf::Vector2f desiredPos = currentPos + direction * speed * deltaTime;
-    desiredPos = GameSettings::clampToWorld(desiredPos, 0.02f);
-
-    if (!collision || !CollisionSystem::wouldCollide(desiredPos, collision->getBoundingBox(), entities, &entity)) {
-        transform->setPosition(desiredPos);
-        return;
-    }
-
-    // Slide attempt along axes
-    sf::Vector2f tryX{ desiredPos.x, currentPos.y };
-    if (!collision || !CollisionSystem::wouldCollide(tryX, collision->getBoundingBox(), entities, &entity)) {
-        transform->setPosition(tryX);
-        return;
-    }
-
-    sf::Vector2f tryY{ currentPos.x, desiredPos.y };
-    if (!collision || !CollisionSystem::wouldCollide(tryY, collision->getBoundingBox(), entities, &entity)) {
-        transform->setPosition(tryY);
-    }
+    const sf::Vector2f velocity = computeSteering(agentIndex, normalizeVector(delta), deltaTime);
+    moveAgent(agent, velocity, deltaTime);
 }
 
-void EnemyAISystem::executeChase(Entity& entity,
-                                 const eol::EnemyAIComponent& ai,
+void EnemyAISystem::executeChase(std::size_t agentIndex,
                                  const sf::Vector2f& playerPos,
-                                 float deltaTime,
-                                 std::vector<Entity*>& entities) {
-    auto* transform = entity.getComponent<eol::TransformComponent>();
-    auto* collision = entity.getComponent<eol::CollisionComponent>();
+                                 float deltaTime) {
+    Agent& agent = m_agents[agentIndex];
+    Entity& entity = *agent.entity;
+
     auto* melee = entity.getComponent<eol::MeleeAttackComponent>();
     if (melee) {
         melee->setEnabled(false);
@@ -154,102 +233,202 @@ void EnemyAISystem::executeChase(Entity& entity,
         render->setTint(sf::Color(255, 120, 120, 230));
     }
 
-    if (!transform) {
-        return;
-    }
-
-    sf::Vector2f delta = playerPos - transform->getPosition();
-    const sf::Vector2f direction = normalizeVector(delta);
-    const float speed = ai.getMoveSpeed();
-    const sf::Vector2f currentPos = transform->getPosition();
-    sf::Vector2f desiredPos = currentPos + direction * speed * deltaTime;
-    desiredPos = GameSettings::clampToWorld(desiredPos, 0.02f);
-
-    auto tryMove = [&](const sf::Vector2f& pos) -> bool {
-        if (!collision || !CollisionSystem::wouldCollide(pos, collision->getBoundingBox(), entities, &entity)) {
-            transform->setPosition(pos);
-            return true;
-        }
-        return false;
-    };
-
-    if (tryMove(desiredPos)) return;
-    if (tryMove({ desiredPos.x, currentPos.y })) return;
-    tryMove({ currentPos.x, desiredPos.y });
+    const sf::Vector2f direction = normalizeVector(playerPos - agent.position);
+    const sf::Vector2f velocity = computeSteering(agentIndex, direction, deltaTime);
+    moveAgent(agent, velocity, deltaTime);
 }
 
-void EnemyAISystem::executeAttack(Entity& entity) {
-    auto* melee = entity.getComponent<eol::MeleeAttackComponent>();
+void EnemyAISystem::executeAttack(Agent& agent) {
+    auto* melee = agent.entity->getComponent<eol::MeleeAttackComponent>();
     if (melee) {
         melee->setEnabled(true);
     }
 
-    auto* render = entity.getComponent<eol::RenderComponent>();
+    auto* render = agent.entity->getComponent<eol::RenderComponent>();
     if (render) {
         render->setTint(sf::Color(255, 90, 90, 240));
     }
+
+    // Standing still - neighbours should not align to a stale heading
+    agent.ai->setVelocity(sf::Vector2f{0.f, 0.f});
 }
 
-bool EnemyAISystem::hasLineOfSight(const sf::Vector2f& origin,
-                                   const sf::Vector2f& target,
-                                   const std::vector<Entity*>& entities,
-                                   Entity* self,
-                                   Entity* targetEntity) const {
-    for (Entity* entity : entities) {
-        if (!entity || entity == self || entity == targetEntity) {
-            continue;
+sf::Vector2f EnemyAISystem::computeSteering(std::size_t agentIndex,
+                                            const sf::Vector2f& desiredDirection,
+                                            float deltaTime) const {
+    const Agent& agent = m_agents[agentIndex];
+    const float speed = agent.ai->getMoveSpeed();
+
+    if (!m_crowdSteering) {
+        return desiredDirection * speed;
+    }
+
+    const float radius = m_separationRadius;
+    sf::Vector2f separation{0.f, 0.f};
+    sf::Vector2f alignment{0.f, 0.f};
+    int neighbours = 0;
+
+    m_agentGrid.query(squareAround(agent.position, radius), [&](std::size_t other) {
+        if (other == agentIndex) {
+            return;
         }
 
-        auto* collision = entity->getComponent<eol::CollisionComponent>();
-        if (!collision || !collision->isSolid()) {
-            continue;
+        const Agent& neighbour = m_agents[other];
+        sf::Vector2f away = agent.position - neighbour.position;
+        float distSq = lengthSquared(away);
+        if (distSq >= radius * radius) {
+            return;
         }
 
-        sf::FloatRect bounds = CollisionSystem::getBounds(*entity);
-        if (lineIntersectsRect(origin, target, bounds)) {
-            return false;
+        float dist = 0.f;
+        if (distSq < 0.0001f) {
+            // Stacked on the same point (same spawner) - fan out by index
+            const float angle = kGoldenAngle * static_cast<float>(agentIndex + 1);
+            away = sf::Vector2f{std::cos(angle), std::sin(angle)};
+            dist = 0.f;
         }
+        else {
+            dist = std::sqrt(distSq);
+            away /= dist;
+        }
+
+        separation += away * (1.f - dist / radius);
+        alignment += neighbour.velocity;
+        ++neighbours;
+    });
+
+    if (neighbours > 0 && speed > 0.f) {
+        alignment /= static_cast<float>(neighbours) * speed;
     }
 
-    // Include player's own size when checking immediate obstruction (optional)
-    return true;
+    const sf::Vector2f heading = lengthSquared(agent.velocity) > 0.0001f
+        ? normalizeVector(agent.velocity)
+        : desiredDirection;
+    const sf::Vector2f avoidance = computeAvoidance(agent, heading);
+
+    sf::Vector2f steer = desiredDirection
+        + separation * kSeparationWeight
+        + alignment * kAlignmentWeight
+        + avoidance * kAvoidanceWeight;
+
+    if (lengthSquared(steer) <= 0.0001f) {
+        steer = desiredDirection;
+    }
+
+    const sf::Vector2f target = normalizeVector(steer) * speed;
+    const float blend = std::min(1.f, deltaTime * kSteeringResponse);
+    return agent.velocity + (target - agent.velocity) * blend;
 }
 
-bool EnemyAISystem::lineIntersectsRect(const sf::Vector2f& a,
-                                       const sf::Vector2f& b,
-                                       const sf::FloatRect& rect) const {
-    const float xMin = rect.position.x;
-    const float xMax = rect.position.x + rect.size.x;
-    const float yMin = rect.position.y;
-    const float yMax = rect.position.y + rect.size.y;
+// Push away from the nearest solid in front of the agent
+sf::Vector2f EnemyAISystem::computeAvoidance(const Agent& agent, const sf::Vector2f& heading) const {
+    const float lookAhead = m_separationRadius * 1.5f;
+    const sf::Vector2f probe = agent.position + heading * lookAhead;
 
-    float t0 = 0.f;
-    float t1 = 1.f;
-    const sf::Vector2f d = b - a;
+    sf::FloatRect area(
+        sf::Vector2f{std::min(agent.position.x, probe.x), std::min(agent.position.y, probe.y)},
+        sf::Vector2f{std::abs(probe.x - agent.position.x), std::abs(probe.y - agent.position.y)});
 
-    auto clip = [&](float p, float q) -> bool {
-        if (std::abs(p) < 1e-6f) {
-            return q >= 0.f;
+    sf::Vector2f best{0.f, 0.f};
+    float bestDistSq = lookAhead * lookAhead;
+
+    m_solidGrid.query(area, [&](std::size_t index) {
+        if (m_solidEntities[index] == agent.entity) {
+            return;
         }
-        const float r = q / p;
-        if (p < 0.f) {
-            if (r > t1) return false;
-            if (r > t0) t0 = r;
+
+        const sf::FloatRect& rect = m_solidBounds[index];
+        if (!geometry::segmentIntersectsBox(agent.position, probe, rect)) {
+            return;
         }
-        else {
-            if (r < t0) return false;
-            if (r < t1) t1 = r;
+
+        const sf::Vector2f closest = closestPointOnRect(agent.position, rect);
+        sf::Vector2f push = agent.position - closest;
+        float distSq = lengthSquared(push);
+        if (distSq < 0.0001f) {
+            // Already inside the box - push out from its centre
+            push = agent.position - (rect.position + rect.size * 0.5f);
+            distSq = 0.f;
+        }
+
+        if (distSq < bestDistSq) {
+            bestDistSq = distSq;
+            best = normalizeVector(push) * (1.f - std::sqrt(distSq) / lookAhead);
         }
-        return true;
+    });
+
+    return best;
+}
+
+void EnemyAISystem::moveAgent(Agent& agent, const sf::Vector2f& velocity, float deltaTime) {
+    const sf::Vector2f currentPos = agent.position;
+    sf::Vector2f desiredPos = currentPos + velocity * deltaTime;
+    desiredPos = GameSettings::clampToWorld(desiredPos, m_worldBounds, 0.02f);
+
+    auto tryMove = [&](const sf::Vector2f& pos) -> bool {
+        if (!agent.collision ||
+            !collidesWithSolids(pos, agent.collision->getBoundingBox(), agent.entity)) {
+            agent.transform->setPosition(pos);
+            agent.position = pos;
+            if (agent.solid != kNotSolid) {
+                // Later agents this frame collide with where it is now
+                m_solidBounds[agent.solid] = CollisionSystem::getBounds(*agent.entity);
+            }
+            return true;
+        }
+        return false;
     };
 
-    if (clip(-d.x, a.x - xMin) &&
-        clip(d.x, xMax - a.x) &&
-        clip(-d.y, a.y - yMin) &&
-        clip(d.y, yMax - a.y)) {
-        return t0 <= t1;
-    }
+    agent.ai->setVelocity(velocity);
+
+    if (tryMove(desiredPos)) return;
+    if (tryMove({ desiredPos.x, currentPos.y })) return;
+    if (tryMove({ currentPos.x, desiredPos.y })) return;
 
-    return false;
+    // Fully blocked - drop the heading so the next frame re-steers from rest
+    agent.ai->setVelocity(sf::Vector2f{0.f, 0.f});
 }
 
+bool EnemyAISystem::collidesWithSolids(const sf::Vector2f& position,
+                                       const sf::Vector2f& size,
+                                       const Entity* self) const {
+    const sf::FloatRect testBox(
+        sf::Vector2f(position.x - size.x * 0.5f, position.y - size.y * 0.5f),
+        size);
+
+    bool hit = false;
+    m_solidGrid.query(testBox, [&](std::size_t index) {
+        if (!hit && m_solidEntities[index] != self &&
+            CollisionSystem::checkOverlap(testBox, m_solidBounds[index])) {
+            hit = true;
+        }
+    });
+    return hit;
+}
+
+bool EnemyAISystem::hasLineOfSight(const sf::Vector2f& origin,
+                                   const sf::Vector2f& target,
+                                   Entity* self,
+                                   Entity* targetEntity) const {
+    const sf::FloatRect area(
+        sf::Vector2f{std::min(origin.x, target.x), std::min(origin.y, target.y)},
+        sf::Vector2f{std::abs(target.x - origin.x), std::abs(target.y - origin.y)});
+
+    bool blocked = false;
+    m_solidGrid.query(area, [&](std::size_t index) {
+        if (blocked) {
+            return;
+        }
+
+        const Entity* entity = m_solidEntities[index];
+        if (entity == self || entity == targetEntity) {
+            return;
+        }
+
+        if (geometry::segmentIntersectsBox(origin, target, m_solidBounds[index])) {
+            blocked = true;
+        }
+    });
+
+    return !blocked;
+}
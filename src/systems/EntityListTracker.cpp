@@ -0,0 +1,21 @@
+#include "systems/EntityListTracker.h"
+#include "components/ComponentPool.h"
+
+#include <algorithm>
+
+bool EntityListTracker::changed(const std::vector<Entity*>& entities) {
+    const std::uint64_t releases = eol::ComponentPool::instance().getReleaseCount();
+    if (m_valid && releases == m_releaseCount &&
+        std::equal(entities.begin(), entities.end(), m_entities.begin(), m_entities.end())) {
+        return false;
+    }
+
+    m_entities.assign(entities.begin(), entities.end());
+    m_releaseCount = releases;
+    m_valid = true;
+    return true;
+}
+
+void EntityListTracker::reset() noexcept {
+    m_valid = false;
+}
@@ -0,0 +1,376 @@
+#include "systems/Geometry.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define EOL_GEOMETRY_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define EOL_GEOMETRY_SSE 1
+#endif
+
+namespace geometry {
+
+namespace {
+// Padding / disabled boxes sit far outside any level, so every lane rejects
+// them through the ordinary slab test instead of a separate mask
+constexpr float kEmptyCoord = 1e30f;
+
+// Axis directions smaller than this are nudged so 1/d stays finite and the
+// slab products never hit 0 * inf
+constexpr float kMinDirection = 1e-12f;
+
+constexpr std::size_t kNoHit = std::numeric_limits<std::size_t>::max();
+
+float safeInverse(float d) {
+    if (std::abs(d) < kMinDirection) {
+        d = std::signbit(d) ? -kMinDirection : kMinDirection;
+    }
+    return 1.f / d;
+}
+
+// Entry distance into box i, or +inf if the ray misses it within maxDistance
+float slabEnter(const BoxBatch& boxes, std::size_t i,
+                float ox, float oy, float invX, float invY, float maxDistance) {
+    const float tx1 = (boxes.minX()[i] - ox) * invX;
+    const float tx2 = (boxes.maxX()[i] - ox) * invX;
+    const float ty1 = (boxes.minY()[i] - oy) * invY;
+    const float ty2 = (boxes.maxY()[i] - oy) * invY;
+
+    const float enter = std::max(std::max(std::min(tx1, tx2), std::min(ty1, ty2)), 0.f);
+    const float exit = std::min(std::min(std::max(tx1, tx2), std::max(ty1, ty2)), maxDistance);
+    return enter <= exit ? enter : std::numeric_limits<float>::infinity();
+}
+
+// Normal of the face the ray enters through; from inside, the closest face
+sf::Vector2f faceNormal(const sf::Vector2f& origin, const sf::Vector2f& direction,
+                        const sf::FloatRect& box, float distance) {
+    const float left = box.position.x;
+    const float right = box.position.x + box.size.x;
+    const float top = box.position.y;
+    const float bottom = box.position.y + box.size.y;
+
+    if (distance <= 0.f) {
+        const float leftDistance = std::abs(origin.x - left);
+        const float rightDistance = std::abs(right - origin.x);
+        const float topDistance = std::abs(origin.y - top);
+        const float bottomDistance = std::abs(bottom - origin.y);
+        const float minAxis = std::min(std::min(leftDistance, rightDistance), std::min(topDistance, bottomDistance));
+
+        if (minAxis == leftDistance) return sf::Vector2f{-1.f, 0.f};
+        if (minAxis == rightDistance) return sf::Vector2f{1.f, 0.f};
+        if (minAxis == topDistance) return sf::Vector2f{0.f, -1.f};
+        return sf::Vector2f{0.f, 1.f};
+    }
+
+    const float invX = safeInverse(direction.x);
+    const float invY = safeInverse(direction.y);
+    const float enterX = std::min((left - origin.x) * invX, (right - origin.x) * invX);
+    const float enterY = std::min((top - origin.y) * invY, (bottom - origin.y) * invY);
+
+    if (enterX >= enterY) {
+        return sf::Vector2f{direction.x > 0.f ? -1.f : 1.f, 0.f};
+    }
+    return sf::Vector2f{0.f, direction.y > 0.f ? -1.f : 1.f};
+}
+
+bool finishHit(const sf::Vector2f& origin, const sf::Vector2f& direction,
+               const BoxBatch& boxes, std::size_t index, float distance, RayHit& outHit) {
+    if (index == kNoHit) {
+        return false;
+    }
+    outHit.index = index;
+    outHit.distance = distance;
+    outHit.normal = faceNormal(origin, direction, boxes.get(index), distance);
+    return true;
+}
+
+#if defined(EOL_GEOMETRY_AVX)
+std::size_t nearestBatch(const BoxBatch& boxes, float ox, float oy, float invX, float invY,
+                         float maxDistance, float& outDistance) {
+    const __m256 originX = _mm256_set1_ps(ox);
+    const __m256 originY = _mm256_set1_ps(oy);
+    const __m256 inverseX = _mm256_set1_ps(invX);
+    const __m256 inverseY = _mm256_set1_ps(invY);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 range = _mm256_set1_ps(maxDistance);
+
+    float best = std::numeric_limits<float>::infinity();
+    std::size_t bestIndex = kNoHit;
+    alignas(32) float enter[8];
+
+    for (std::size_t i = 0; i < boxes.paddedSize(); i += 8) {
+        const __m256 tx1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(boxes.minX() + i), originX), inverseX);
+        const __m256 tx2 = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(boxes.maxX() + i), originX), inverseX);
+        const __m256 ty1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(boxes.minY() + i), originY), inverseY);
+        const __m256 ty2 = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(boxes.maxY() + i), originY), inverseY);
+
+        const __m256 tEnter = _mm256_max_ps(_mm256_max_ps(_mm256_min_ps(tx1, tx2), _mm256_min_ps(ty1, ty2)), zero);
+        const __m256 tExit = _mm256_min_ps(_mm256_min_ps(_mm256_max_ps(tx1, tx2), _mm256_max_ps(ty1, ty2)), range);
+        const __m256 hit = _mm256_and_ps(_mm256_cmp_ps(tEnter, tExit, _CMP_LE_OQ),
+                                         _mm256_cmp_ps(tEnter, _mm256_set1_ps(best), _CMP_LT_OQ));
+
+        const int mask = _mm256_movemask_ps(hit);
+        if (mask == 0) {
+            continue;
+        }
+
+        _mm256_store_ps(enter, tEnter);
+        for (int lane = 0; lane < 8; ++lane) {
+            if ((mask & (1 << lane)) && enter[lane] < best) {
+                best = enter[lane];
+                bestIndex = i + static_cast<std::size_t>(lane);
+            }
+        }
+    }
+
+    outDistance = best;
+    return bestIndex;
+}
+#elif defined(EOL_GEOMETRY_SSE)
+std::size_t nearestBatch(const BoxBatch& boxes, float ox, float oy, float invX, float invY,
+                         float maxDistance, float& outDistance) {
+    const __m128 originX = _mm_set1_ps(ox);
+    const __m128 originY = _mm_set1_ps(oy);
+    const __m128 inverseX = _mm_set1_ps(invX);
+    const __m128 inverseY = _mm_set1_ps(invY);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 range = _mm_set1_ps(maxDistance);
+
+    float best = std::numeric_limits<float>::infinity();
+    std::size_t bestIndex = kNoHit;
+    alignas(16) float enter[4];
+
+    for (std::size_t i = 0; i < boxes.paddedSize(); i += 4) {
+        const __m128 tx1 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(boxes.minX() + i), originX), inverseX);
+        const __m128 tx2 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(boxes.maxX() + i), originX), inverseX);
+        const __m128 ty1 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(boxes.minY() + i), originY), inverseY);
+        const __m128 ty2 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(boxes.maxY() + i), originY), inverseY);
+
+        const __m128 tEnter = _mm_max_ps(_mm_max_ps(_mm_min_ps(tx1, tx2), _mm_min_ps(ty1, ty2)), zero);
+        const __m128 tExit = _mm_min_ps(_mm_min_ps(_mm_max_ps(tx1, tx2), _mm_max_ps(ty1, ty2)), range);
+        const __m128 hit = _mm_and_ps(_mm_cmple_ps(tEnter, tExit), _mm_cmplt_ps(tEnter, _mm_set1_ps(best)));
+
+        const int mask = _mm_movemask_ps(hit);
+        if (mask == 0) {
+            continue;
+        }
+
+        _mm_store_ps(enter, tEnter);
+        for (int lane = 0; lane < 4; ++lane) {
+            if ((mask & (1 << lane)) && enter[lane] < best) {
+                best = enter[lane];
+                bestIndex = i + static_cast<std::size_t>(lane);
+            }
+        }
+    }
+
+    outDistance = best;
+    return bestIndex;
+}
+#endif
+
+std::size_t nearestScalar(const BoxBatch& boxes, float ox, float oy, float invX, float invY,
+                          float maxDistance, float& outDistance) {
+    float best = std::numeric_limits<float>::infinity();
+    std::size_t bestIndex = kNoHit;
+
+    for (std::size_t i = 0; i < boxes.size(); ++i) {
+        const float enter = slabEnter(boxes, i, ox, oy, invX, invY, maxDistance);
+        if (enter < best) {
+            best = enter;
+            bestIndex = i;
+        }
+    }
+
+    outDistance = best;
+    return bestIndex;
+}
+} // namespace
+
+void BoxBatch::clear() {
+    m_minX.clear();
+    m_minY.clear();
+    m_maxX.clear();
+    m_maxY.clear();
+    m_count = 0;
+}
+
+void BoxBatch::reserve(std::size_t count) {
+    const std::size_t padded = (count + kLanes - 1) / kLanes * kLanes;
+    m_minX.reserve(padded);
+    m_minY.reserve(padded);
+    m_maxX.reserve(padded);
+    m_maxY.reserve(padded);
+}
+
+void BoxBatch::grow() {
+    if (m_count < m_minX.size()) {
+        return;
+    }
+    const std::size_t padded = m_minX.size() + kLanes;
+    m_minX.resize(padded, kEmptyCoord);
+    m_minY.resize(padded, kEmptyCoord);
+    m_maxX.resize(padded, kEmptyCoord);
+    m_maxY.resize(padded, kEmptyCoord);
+}
+
+std::size_t BoxBatch::add(const sf::FloatRect& box) {
+    grow();
+    set(m_count, box);
+    return m_count++;
+}
+
+std::size_t BoxBatch::addEmpty() {
+    grow();
+    setEmpty(m_count);
+    return m_count++;
+}
+
+void BoxBatch::set(std::size_t index, const sf::FloatRect& box) {
+    // Normalise negative sizes so min <= max on both axes
+    m_minX[index] = std::min(box.position.x, box.position.x + box.size.x);
+    m_maxX[index] = std::max(box.position.x, box.position.x + box.size.x);
+    m_minY[index] = std::min(box.position.y, box.position.y + box.size.y);
+    m_maxY[index] = std::max(box.position.y, box.position.y + box.size.y);
+}
+
+void BoxBatch::setEmpty(std::size_t index) {
+    m_minX[index] = kEmptyCoord;
+    m_minY[index] = kEmptyCoord;
+    m_maxX[index] = kEmptyCoord;
+    m_maxY[index] = kEmptyCoord;
+}
+
+sf::FloatRect BoxBatch::get(std::size_t index) const {
+    return sf::FloatRect({m_minX[index], m_minY[index]},
+                         {m_maxX[index] - m_minX[index], m_maxY[index] - m_minY[index]});
+}
+
+bool intersectRayBoxes(const sf::Vector2f& origin,
+                       const sf::Vector2f& direction,
+                       float maxDistance,
+                       const BoxBatch& boxes,
+                       RayHit& outHit) {
+    if (boxes.size() == 0 || maxDistance < 0.f) {
+        return false;
+    }
+
+    const float invX = safeInverse(direction.x);
+    const float invY = safeInverse(direction.y);
+    float distance = 0.f;
+#if defined(EOL_GEOMETRY_AVX) || defined(EOL_GEOMETRY_SSE)
+    const std::size_t index = nearestBatch(boxes, origin.x, origin.y, invX, invY, maxDistance, distance);
+#else
+    const std::size_t index = nearestScalar(boxes, origin.x, origin.y, invX, invY, maxDistance, distance);
+#endif
+    return finishHit(origin, direction, boxes, index, distance, outHit);
+}
+
+bool intersectRayBoxesScalar(const sf::Vector2f& origin,
+                             const sf::Vector2f& direction,
+                             float maxDistance,
+                             const BoxBatch& boxes,
+                             RayHit& outHit) {
+    if (boxes.size() == 0 || maxDistance < 0.f) {
+        return false;
+    }
+
+    const float invX = safeInverse(direction.x);
+    const float invY = safeInverse(direction.y);
+    float distance = 0.f;
+    const std::size_t index = nearestScalar(boxes, origin.x, origin.y, invX, invY, maxDistance, distance);
+    return finishHit(origin, direction, boxes, index, distance, outHit);
+}
+
+bool intersectRayBox(const sf::Vector2f& origin,
+                     const sf::Vector2f& direction,
+                     float maxDistance,
+                     const sf::FloatRect& box,
+                     float& outDistance,
+                     sf::Vector2f& outNormal) {
+    if (maxDistance < 0.f) {
+        return false;
+    }
+
+    const float invX = safeInverse(direction.x);
+    const float invY = safeInverse(direction.y);
+    const float x0 = box.position.x;
+    const float x1 = box.position.x + box.size.x;
+    const float y0 = box.position.y;
+    const float y1 = box.position.y + box.size.y;
+
+    const float tx1 = (std::min(x0, x1) - origin.x) * invX;
+    const float tx2 = (std::max(x0, x1) - origin.x) * invX;
+    const float ty1 = (std::min(y0, y1) - origin.y) * invY;
+    const float ty2 = (std::max(y0, y1) - origin.y) * invY;
+
+    const float enter = std::max(std::max(std::min(tx1, tx2), std::min(ty1, ty2)), 0.f);
+    const float exit = std::min(std::min(std::max(tx1, tx2), std::max(ty1, ty2)), maxDistance);
+    if (enter > exit) {
+        return false;
+    }
+
+    outDistance = enter;
+    outNormal = faceNormal(origin, direction, box, enter);
+    return true;
+}
+
+bool segmentIntersectsBox(const sf::Vector2f& a, const sf::Vector2f& b, const sf::FloatRect& box) {
+    const float xMin = box.position.x;
+    const float xMax = box.position.x + box.size.x;
+    const float yMin = box.position.y;
+    const float yMax = box.position.y + box.size.y;
+
+    // Liang-Barsky clip of a + t * (b - a), t in [0, 1]
+    float t0 = 0.f;
+    float t1 = 1.f;
+    const sf::Vector2f d = b - a;
+
+    auto clip = [&](float p, float q) -> bool {
+        if (std::abs(p) < 1e-6f) {
+            return q >= 0.f;
+        }
+        const float r = q / p;
+        if (p < 0.f) {
+            if (r > t1) return false;
+            if (r > t0) t0 = r;
+        }
+        else {
+            if (r < t0) return false;
+            if (r < t1) t1 = r;
+        }
+        return true;
+    };
+
+    if (clip(-d.x, a.x - xMin) &&
+        clip(d.x, xMax - a.x) &&
+        clip(-d.y, a.y - yMin) &&
+        clip(d.y, yMax - a.y)) {
+        return t0 <= t1;
+    }
+
+    return false;
+}
+
+bool boxesOverlap(const sf::FloatRect& a, const sf::FloatRect& b) {
+    return a.position.x < b.position.x + b.size.x &&
+           a.position.x + a.size.x > b.position.x &&
+           a.position.y < b.position.y + b.size.y &&
+           a.position.y + a.size.y > b.position.y;
+}
+
+const char* batchKernelName() {
+#if defined(EOL_GEOMETRY_AVX)
+    return "avx";
+#elif defined(EOL_GEOMETRY_SSE)
+    return "sse";
+#else
+    return "scalar";
+#endif
+}
+
+} // namespace geometry
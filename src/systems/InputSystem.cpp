@@ -33,7 +33,9 @@ namespace {
     }
 }
 
-void InputSystem::update(Entity& player, float deltaTime, const sf::RenderWindow& window) {
+void InputSystem::update(Entity& player,
+    float deltaTime,
+    const InputFrame& input) {
     auto* transform = player.getComponent<eol::TransformComponent>();
     auto* playerComp = player.getComponent<eol::PlayerComponent>();
     auto* animation = player.getComponent<eol::AnimationComponent>();
@@ -44,11 +46,11 @@ void InputSystem::update(Entity& player, float deltaTime, const sf::RenderWindow
 
     playerComp->tickInvulnerability(deltaTime);
 
-    sf::Vector2f movement = getMovementInput();
+    sf::Vector2f movement = getMovementInput(input);
     const bool isMoving = (movement.x != 0.f || movement.y != 0.f);
 
     if (animation) {
-        animation->setAnimation(isMoving ? "walk" : "idle");
+        playMovementClip(*animation, isMoving);
     }
 
     if (isMoving) {
@@ -60,18 +62,31 @@ void InputSystem::update(Entity& player, float deltaTime, const sf::RenderWindow
         pos.y += movement.y * speed * deltaTime;
 
         // Clamp to world bounds using GameSettings
-        pos = GameSettings::clampToWorld(pos, 0.025f);
+        pos = GameSettings::clampToWorld(pos, m_worldBounds, 0.025f);
 
         transform->setPosition(pos);
     }
 
-    updatePlayerEmitter(player, window);
+    updatePlayerEmitter(player, input);
+}
+
+void InputSystem::setWorldBounds(const sf::FloatRect& bounds) noexcept {
+    m_worldBounds = bounds;
+}
+
+void InputSystem::playMovementClip(eol::AnimationComponent& animation, bool isMoving) {
+    if (m_idleClip == eol::InvalidClip || m_walkClip == eol::InvalidClip) {
+        const auto& clips = eol::AnimationLibrary::instance();
+        m_idleClip = clips.find("player.idle");
+        m_walkClip = clips.find("player.walk");
+    }
+    animation.setClip(isMoving ? m_walkClip : m_idleClip);
 }
 
 // update with collision checking to test
 void InputSystem::updateWithCollision(Entity& player,
     float deltaTime,
-    const sf::RenderWindow& window,
+    const InputFrame& input,
     std::vector<Entity*>& entities) {
     auto* transform = player.getComponent<eol::TransformComponent>();
     auto* playerComp = player.getComponent<eol::PlayerComponent>();
@@ -82,15 +97,15 @@ void InputSystem::updateWithCollision(Entity& player,
         return;
     }
 
-    handlePickupDrop(player, entities);
+    handlePickupDrop(player, input, entities);
     playerComp->tickInvulnerability(deltaTime);
-    handleMirrorRotation(player);
+    handleMirrorRotation(player, input);
 
-    sf::Vector2f movement = getMovementInput();
+    sf::Vector2f movement = getMovementInput(input);
     const bool isMoving = (movement.x != 0.f || movement.y != 0.f);
 
     if (animation) {
-        animation->setAnimation(isMoving ? "walk" : "idle");
+        playMovementClip(*animation, isMoving);
     }
 
     if (isMoving) {
@@ -103,7 +118,7 @@ void InputSystem::updateWithCollision(Entity& player,
         newPos.y = currentPos.y + movement.y * speed * deltaTime;
 
         // Clamp to world bounds using GameSettings
-        newPos = GameSettings::clampToWorld(newPos, 0.025f);
+        newPos = GameSettings::clampToWorld(newPos, m_worldBounds, 0.025f);
 
         // If player has collision component, check before moving
         if (collision) {
@@ -131,7 +146,7 @@ void InputSystem::updateWithCollision(Entity& player,
         }
     }
 
-    updatePlayerEmitter(player, window);
+    updatePlayerEmitter(player, input);
 
     if (playerComp->isCarrying()) {
         Entity* carried = playerComp->getCarriedEntity();
@@ -144,26 +159,26 @@ void InputSystem::updateWithCollision(Entity& player,
     }
 }
 
-sf::Vector2f InputSystem::getMovementInput() const {
+sf::Vector2f InputSystem::getMovementInput(const InputFrame& input) const {
     sf::Vector2f movement(0.f, 0.f);
 
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::W)) {
+    if (input.isHeld(InputAction::MoveUp)) {
         movement.y -= 1.f;
     }
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::S)) {
+    if (input.isHeld(InputAction::MoveDown)) {
         movement.y += 1.f;
     }
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::A)) {
+    if (input.isHeld(InputAction::MoveLeft)) {
         movement.x -= 1.f;
     }
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::D)) {
+    if (input.isHeld(InputAction::MoveRight)) {
         movement.x += 1.f;
     }
 
     return movement;
 }
 
-void InputSystem::updatePlayerEmitter(Entity& player, const sf::RenderWindow& window) {
+void InputSystem::updatePlayerEmitter(Entity& player, const InputFrame& input) {
     auto* emitter = player.getComponent<eol::LightEmitterComponent>();
     auto* transform = player.getComponent<eol::TransformComponent>();
     if (!emitter || !transform) {
@@ -175,22 +190,16 @@ void InputSystem::updatePlayerEmitter(Entity& player, const sf::RenderWindow& wi
         const sf::Sprite& sprite = render->getSprite();
         origin = sprite.getTransform().transformPoint(sprite.getOrigin());
     }
-    const sf::Vector2f cursor = window.mapPixelToCoords(sf::Mouse::getPosition(window));
-    sf::Vector2f aimDir = cursor - origin;
+    sf::Vector2f aimDir = input.aim - origin;
     aimDir = normalizeVector(aimDir);
     emitter->setDirection(aimDir);
 
-    const bool triggerHeld =
-        sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Space) ||
-        sf::Mouse::isButtonPressed(sf::Mouse::Button::Left);
-    emitter->setTriggerHeld(triggerHeld);
+    emitter->setTriggerHeld(input.isActive(InputAction::Fire));
 }
 
-void InputSystem::handlePickupDrop(Entity& player, std::vector<Entity*>& entities) {
-    bool ePressed = sf::Keyboard::isKeyPressed(sf::Keyboard::Key::E);
-
+void InputSystem::handlePickupDrop(Entity& player, const InputFrame& input, std::vector<Entity*>& entities) {
     // Only trigger on key press, not hold
-    if (ePressed && !m_pickupKeyWasPressed) {
+    if (input.wasPressed(InputAction::Interact)) {
         auto* playerComp = player.getComponent<eol::PlayerComponent>();
         auto* playerTransform = player.getComponent<eol::TransformComponent>();
         if (!playerComp || !playerTransform) return;
@@ -238,24 +247,19 @@ void InputSystem::handlePickupDrop(Entity& player, std::vector<Entity*>& entitie
             }
         }
     }
-    m_pickupKeyWasPressed = ePressed;
 }
 
 // Rotate the carried mirror by 45 degrees when R is pressed
-void InputSystem::handleMirrorRotation(Entity& player) {
-    bool rPressed = sf::Keyboard::isKeyPressed(sf::Keyboard::Key::R);
-
+void InputSystem::handleMirrorRotation(Entity& player, const InputFrame& input) {
     // Only trigger on key press, not hold
-    if (rPressed && !m_rotateKeyWasPressed) {
+    if (input.wasPressed(InputAction::Rotate)) {
         auto* playerComp = player.getComponent<eol::PlayerComponent>();
         if (!playerComp || !playerComp->isCarrying()) {
-            m_rotateKeyWasPressed = rPressed;
             return;
         }
 
         Entity* carried = playerComp->getCarriedEntity();
         if (!carried) {
-            m_rotateKeyWasPressed = rPressed;
             return;
         }
 
@@ -281,6 +285,5 @@ void InputSystem::handleMirrorRotation(Entity& player) {
             transform->setRotation(currentRotation + 45.f);
         }
     }
-    m_rotateKeyWasPressed = rPressed;
 }
 
@@ -10,16 +10,28 @@
 #include "components/PlayerComponent.h"
 #include "components/RenderComponent.h"
 #include "components/TransformComponent.h"
+#include "systems/Camera.h"
 #include "GameSettings.h"
+#include "Log.h"
+#include "WorldSnapshot.h"
 
 #include <algorithm>
 #include <cmath>
-#include <iostream>
 #include <vector>
 
 namespace {
 constexpr float kEpsilon = 0.0001f;
 
+// Beam tree limits per emitter per frame
+constexpr std::size_t kMaxSegmentsPerEmitter = 512;
+constexpr std::size_t kMaxRaysPerEmitter = 128;
+constexpr float kCoalesceCellSize = 8.f;
+constexpr std::int32_t kCoalesceAngleSteps = 512;
+
+// The static light layer covers the view plus this much on every side, so
+// scrolling only redraws it once the view has moved out of that area
+constexpr float kStaticLayerMargin = 256.f;
+
 sf::Vector2f normalizeVector(const sf::Vector2f& value) {
     const float length = std::sqrt(value.x * value.x + value.y * value.y);
     if (length <= kEpsilon) {
@@ -45,6 +57,38 @@ sf::Vector2f rectCenter(const sf::FloatRect& rect) {
                         rect.position.y + rect.size.y * 0.5f};
 }
 
+// Boosted lights fade back to base once their delay has passed, dimmed
+// lights recover at half rate. Selects instead of branches so the loop
+// vectorises; timer already includes this frame.
+void decayLightFields(std::size_t count,
+                      float* intensity,
+                      const float* base,
+                      const float* decayRate,
+                      const float* delay,
+                      const float* timer,
+                      float deltaTime) {
+    for (std::size_t i = 0; i < count; ++i) {
+        const float current = intensity[i];
+        const float step = decayRate[i] * deltaTime;
+        const float decayed = std::max(base[i], current - step);
+        const float restored = std::min(base[i], current + step * 0.5f);   // == current at base
+        const float target = current > base[i] ? decayed : restored;
+        const bool holding = (current > base[i]) & (timer[i] < delay[i]);
+        intensity[i] = holding ? current : target;
+    }
+}
+
+void computeLightTints(std::size_t count, const float* intensity, float ambient, sf::Color* out) {
+    for (std::size_t i = 0; i < count; ++i) {
+        const float brightness = std::min(1.25f, std::max(0.f, ambient + intensity[i]));
+        out[i] = sf::Color(
+            static_cast<std::uint8_t>(std::min(255.f, 100.f + brightness * 140.f)),
+            static_cast<std::uint8_t>(std::min(255.f, 100.f + brightness * 120.f)),
+            static_cast<std::uint8_t>(std::min(255.f, 110.f + brightness * 80.f)),
+            static_cast<std::uint8_t>(std::min(1.f, brightness) * 255.f));
+    }
+}
+
 sf::Vector2f rotateVector(const sf::Vector2f& v, float degrees) {
     const float radians = degrees * 3.1415926535f / 180.f;
     const float cs = std::cos(radians);
@@ -54,7 +98,7 @@ sf::Vector2f rotateVector(const sf::Vector2f& v, float degrees) {
 } // namespace
 
 LightSystem::LightSystem(CombatSystem& combatSystem)
-    : m_beamSegments()
+    : m_beams()
     , m_darknessOverlay()
     , m_debugOverlay(false)
     , m_ambientLight(0.28f)
@@ -80,39 +124,76 @@ bool LightSystem::isDebugOverlayEnabled() const noexcept {
     return m_debugOverlay;
 }
 
-void LightSystem::update(std::vector<Entity*>& entities, float deltaTime, const sf::RenderWindow& window) {
+void LightSystem::setOccluders(const Map& map, float tileSize, const sf::Vector2f& offset) {
+    m_shadowCaster.build(map, tileSize, offset);
+    m_shadows.clear();
+    m_tileSize = tileSize;
+    m_tileOffset = offset;
+    m_staticLayerDirty = true;
+}
+
+void LightSystem::saveState(SnapshotWriter& out) const {
+    out.write(static_cast<std::uint32_t>(m_beams.size()));
+    m_beams.forEach([&out](const BeamStore::Segment& segment) {
+        out.write(segment);
+    });
+}
+
+void LightSystem::loadState(SnapshotReader& in) {
+    m_beams.clear();
+    const std::uint32_t count = in.read<std::uint32_t>();
+    for (std::uint32_t i = 0; i < count && !in.hasFailed(); ++i) {
+        m_beams.add(in.read<BeamStore::Segment>());
+    }
+    m_debugHitPoints.clear();
+}
+
+void LightSystem::update(std::vector<Entity*>& entities, float deltaTime) {
     refreshBeamTimers(deltaTime);
-    updateEmitters(entities, deltaTime, window);
+    updateEmitters(entities, deltaTime);
     updateLightFields(entities, deltaTime);
 }
 
 void LightSystem::render(sf::RenderTarget& target, std::vector<Entity*>& entities) {
+    m_viewRect = viewBounds(target.getView());
+    m_cullRect = m_viewRect;
     ensureOverlaySize(target);
-    drawLightGlows(target, entities);
-    drawLightBeacons(target, entities);
-    drawOverlay(target);
-    drawBeams(target);
+    updateBeamMesh();
+
+    const bool lightmap = updateLightmap(entities);
+    if (lightmap && composeLightLayers(entities)) {
+        // Scene darkened and shadowed, then every light effect in one pass
+        drawLightmap(target);
+        sf::RenderStates addState;
+        addState.blendMode = sf::BlendMode(sf::BlendMode::Factor::One, sf::BlendMode::Factor::One);
+        sf::Sprite composite(m_compositeLayer.getTexture());
+        composite.setPosition(m_viewRect.position);
+        target.draw(composite, addState);
+    }
+    else {
+        // No render textures: draw every effect straight onto the target
+        drawLightGlows(target, entities);
+        drawLightBeacons(target, entities);
+        if (lightmap) {
+            drawLightmap(target);
+        }
+        else {
+            drawOverlay(target);
+        }
+        drawBeams(target);
+    }
+
     if (m_debugOverlay) {
         drawDebugData(target);
     }
 }
 
 void LightSystem::refreshBeamTimers(float deltaTime) {
-    for (auto& beam : m_beamSegments) {
-        beam.ttl = std::max(0.f, beam.ttl - deltaTime);
-    }
-
-    m_beamSegments.erase(
-        std::remove_if(
-            m_beamSegments.begin(),
-            m_beamSegments.end(),
-            [](const BeamSegment& beam) { return beam.ttl <= 0.f; }),
-        m_beamSegments.end());
+    m_beams.advance(deltaTime);
 }
 
 void LightSystem::updateEmitters(std::vector<Entity*>& entities,
-                                 float deltaTime,
-                                 const sf::RenderWindow& window) {
+                                 float deltaTime) {
     auto refreshDebugBounds = [this, &entities]() {
         if (!m_debugOverlay) {
             m_debugMirrorBounds.clear();
@@ -130,6 +211,7 @@ void LightSystem::updateEmitters(std::vector<Entity*>& entities,
 
     refreshDebugBounds();
     m_debugHitPoints.clear();
+    syncMirrorTable(entities);
 
     struct PendingShot {
         Entity* owner;
@@ -203,77 +285,153 @@ void LightSystem::castBeam(Entity& owner,
                            float intensity,
                            float ttl,
                            std::uint32_t reflectionsLeft) {
-    sf::Vector2f currentStart = origin;
-    sf::Vector2f currentDirection = normalizeVector(direction);
-    float remainingRange = range;
-    float currentIntensity = intensity;
+    collectBeamObstacles(owner, entities);
+    m_rayQueue.clear();
+    m_rayKeys.clear();
+    m_rayNext = 0;
+    enqueueRay(BeamRay{origin, normalizeVector(direction), range, width, intensity, ttl, reflectionsLeft});
+
+    std::size_t segmentBudget = kMaxSegmentsPerEmitter;
+    while (m_rayNext < m_rayQueue.size() && segmentBudget > 0) {
+        // Copy: traceRay may grow the queue
+        const BeamRay ray = m_rayQueue[m_rayNext++];
+        traceRay(owner, entities, ray, color, segmentBudget);
+    }
+}
 
+void LightSystem::collectBeamObstacles(Entity& owner, std::vector<Entity*>& entities) {
     const bool ownerIsEnemy = owner.getComponent<eol::EnemyComponent>() != nullptr;
 
-    while (remainingRange > 4.f && currentIntensity > 0.1f) {
-        float nearestDistance = remainingRange;
-        Entity* hitEntity = nullptr;
-        sf::Vector2f hitNormal{0.f, 0.f};
-        eol::MirrorComponent* hitMirror = nullptr;
+    m_beamBoxes.clear();
+    m_beamBoxes.reserve(entities.size());
 
-        for (Entity* candidate : entities) {
-            if (!candidate || candidate == &owner) {
-                continue;
-            }
+    for (Entity* candidate : entities) {
+        if (!candidate || candidate == &owner ||
+            (!ownerIsEnemy && candidate->getComponent<eol::PlayerComponent>())) {
+            m_beamBoxes.addEmpty();
+            continue;
+        }
 
-            if (!ownerIsEnemy && candidate->getComponent<eol::PlayerComponent>()) {
-                continue;
-            }
+        if (auto* mirror = candidate->getComponent<eol::MirrorComponent>(); mirror && mirror->isActive()) {
+            m_beamBoxes.addEmpty();
+            continue;
+        }
 
-            float hitDistance = 0.f;
-            sf::Vector2f normal{};
-
-            if (auto* mirror = candidate->getComponent<eol::MirrorComponent>(); mirror && mirror->isActive()) {
-                if (rayIntersectsMirror(currentStart, currentDirection, remainingRange, *candidate, hitDistance, normal)) {
-                    if (hitDistance < nearestDistance) {
-                        nearestDistance = hitDistance;
-                        hitEntity = candidate;
-                        hitNormal = normal;
-                        hitMirror = mirror;
-                    }
-                }
-                continue;
-            }
+        if (auto bounds = computeBounds(*candidate)) {
+            m_beamBoxes.add(*bounds);
+        }
+        else {
+            m_beamBoxes.addEmpty();
+        }
+    }
+}
 
-            auto bounds = computeBounds(*candidate);
-            if (!bounds) {
-                continue;
-            }
+// Impacts can kill or move their target; later rays of the same cast must see that
+void LightSystem::refreshBeamObstacle(std::size_t index, Entity& entity) {
+    if (auto bounds = computeBounds(entity)) {
+        m_beamBoxes.set(index, *bounds);
+    }
+    else {
+        m_beamBoxes.setEmpty(index);
+    }
+}
 
-            if (rayIntersectsRect(currentStart, currentDirection, remainingRange, *bounds, hitDistance, normal)) {
-                if (hitDistance < nearestDistance) {
-                    nearestDistance = hitDistance;
-                    hitEntity = candidate;
-                    hitNormal = normal;
-                    hitMirror = nullptr;
-                }
+bool LightSystem::enqueueRay(const BeamRay& ray) {
+    if (m_rayQueue.size() >= kMaxRaysPerEmitter) {
+        return false;
+    }
+
+    // Rays starting in the same small cell in nearly the same direction
+    // would draw the same beam; keep the brightest one. Only rays still
+    // waiting in the queue can absorb a new one: a traced ray has already
+    // drawn its beam, so a brighter duplicate of it is traced as well.
+    const auto cellX = static_cast<std::int32_t>(std::floor(ray.origin.x / kCoalesceCellSize));
+    const auto cellY = static_cast<std::int32_t>(std::floor(ray.origin.y / kCoalesceCellSize));
+    const float angle = std::atan2(ray.direction.y, ray.direction.x);
+    const auto angleStep = static_cast<std::int32_t>(
+        std::lround((angle + 3.1415926535f) / (2.f * 3.1415926535f) * kCoalesceAngleSteps)) % kCoalesceAngleSteps;
+
+    const std::uint64_t key = (static_cast<std::uint64_t>(static_cast<std::uint32_t>(cellX) & 0xFFFFFu) << 40)
+                            | (static_cast<std::uint64_t>(static_cast<std::uint32_t>(cellY) & 0xFFFFFu) << 20)
+                            | static_cast<std::uint64_t>(angleStep);
+
+    for (std::size_t i = 0; i < m_rayKeys.size(); ++i) {
+        if (m_rayKeys[i] != key) {
+            continue;
+        }
+        BeamRay& existing = m_rayQueue[i];
+        if (i >= m_rayNext) {
+            existing.intensity = std::max(existing.intensity, ray.intensity);
+            existing.range = std::max(existing.range, ray.range);
+            return false;
+        }
+        if (ray.intensity <= existing.intensity) {
+            return false;
+        }
+    }
+
+    m_rayKeys.push_back(key);
+    m_rayQueue.push_back(ray);
+    return true;
+}
+
+void LightSystem::traceRay(Entity& owner,
+                           std::vector<Entity*>& entities,
+                           const BeamRay& ray,
+                           sf::Color color,
+                           std::size_t& segmentBudget) {
+    sf::Vector2f currentStart = ray.origin;
+    sf::Vector2f currentDirection = ray.direction;
+    float remainingRange = ray.range;
+    float currentIntensity = ray.intensity;
+    std::uint32_t reflectionsLeft = ray.reflectionsLeft;
+
+    while (remainingRange > 4.f && currentIntensity > 0.1f && segmentBudget > 0) {
+        float nearestDistance = remainingRange;
+        Entity* hitEntity = nullptr;
+        std::size_t hitIndex = 0;
+        sf::Vector2f hitNormal{0.f, 0.f};
+        const MirrorSegment* hitMirror = nullptr;
+
+        geometry::RayHit boxHit;
+        if (geometry::intersectRayBoxes(currentStart, currentDirection, remainingRange, m_beamBoxes, boxHit) &&
+            boxHit.index < entities.size()) {
+            nearestDistance = boxHit.distance;
+            hitEntity = entities[boxHit.index];
+            hitIndex = boxHit.index;
+            hitNormal = boxHit.normal;
+        }
+
+        for (const MirrorSegment& mirror : m_mirrorTable) {
+            float hitDistance = 0.f;
+            if (mirror.active && rayIntersectsMirror(currentStart, currentDirection, nearestDistance, mirror, hitDistance) &&
+                hitDistance < nearestDistance) {
+                nearestDistance = hitDistance;
+                hitEntity = mirror.entity;
+                hitNormal = mirror.normal;
+                hitMirror = &mirror;
             }
         }
 
         sf::Vector2f endPoint = currentStart + currentDirection * nearestDistance;
-        m_beamSegments.push_back(BeamSegment{
+        m_beams.add(BeamStore::Segment{
             currentStart,
             endPoint,
             color,
-            width,
-            ttl,
-            ttl,
+            ray.width,
+            ray.ttl,
+            ray.ttl,
             currentIntensity });
+        --segmentBudget;
 
         if (!hitEntity) {
             break;
         }
 
         if (hitMirror) {
-            if (hitMirror->getType() == eol::MirrorComponent::MirrorType::Flat && reflectionsLeft > 0) {
+            if (hitMirror->type == eol::MirrorComponent::MirrorType::Flat && reflectionsLeft > 0) {
                 sf::Vector2f mirrorNormal = hitNormal;
-                const float loss = clampf(hitMirror->getReflectionLoss(), 0.f, 0.9f);
-                currentIntensity *= (1.f - loss);
+                currentIntensity *= (1.f - hitMirror->loss);
                 reflectionsLeft--;
 
                 remainingRange -= nearestDistance;
@@ -283,63 +441,30 @@ void LightSystem::castBeam(Entity& owner,
             }
 
             if (reflectionsLeft > 0) {
-                if (hitMirror->getType() == eol::MirrorComponent::MirrorType::Splitter) {
+                if (hitMirror->type == eol::MirrorComponent::MirrorType::Splitter) {
                     const sf::Vector2f mirrorNormal = hitNormal;
                     const sf::Vector2f tangent = normalizeVector(perpendicular(mirrorNormal));
                     const float childRange = remainingRange * 0.65f;
-                    const float childWidth = width * 0.7f;
-                    const float childIntensity = intensity * 0.6f;
-                    const float childTtl = ttl * 0.85f;
-
-                    castBeam(owner,
-                             entities,
-                             endPoint + tangent * 4.f,
-                             tangent,
-                             childRange,
-                             childWidth,
-                             color,
-                             childIntensity,
-                             childTtl,
-                             reflectionsLeft - 1);
-
-                    castBeam(owner,
-                             entities,
-                             endPoint - tangent * 4.f,
-                             -tangent,
-                             childRange,
-                             childWidth,
-                             color,
-                             childIntensity,
-                             childTtl,
-                             reflectionsLeft - 1);
+                    const float childWidth = ray.width * 0.7f;
+                    const float childIntensity = ray.intensity * 0.6f;
+                    const float childTtl = ray.ttl * 0.85f;
+
+                    enqueueRay(BeamRay{endPoint + tangent * 4.f, tangent, childRange, childWidth,
+                                       childIntensity, childTtl, reflectionsLeft - 1});
+                    enqueueRay(BeamRay{endPoint - tangent * 4.f, -tangent, childRange, childWidth,
+                                       childIntensity, childTtl, reflectionsLeft - 1});
                 }
-                else if (hitMirror->getType() == eol::MirrorComponent::MirrorType::Prism) {
+                else if (hitMirror->type == eol::MirrorComponent::MirrorType::Prism) {
                     constexpr float prismAngle = 35.f;
                     const auto dirA = normalizeVector(rotateVector(currentDirection, prismAngle));
                     const auto dirB = normalizeVector(rotateVector(currentDirection, -prismAngle));
                     const float childRange = remainingRange * 0.55f;
-                    const float childIntensity = intensity * 0.5f;
-
-                    castBeam(owner,
-                             entities,
-                             endPoint,
-                             dirA,
-                             childRange,
-                             width * 0.6f,
-                             color,
-                             childIntensity,
-                             ttl * 0.75f,
-                             reflectionsLeft - 1);
-                    castBeam(owner,
-                             entities,
-                             endPoint,
-                             dirB,
-                             childRange,
-                             width * 0.6f,
-                             color,
-                             childIntensity,
-                             ttl * 0.75f,
-                             reflectionsLeft - 1);
+                    const float childIntensity = ray.intensity * 0.5f;
+
+                    enqueueRay(BeamRay{endPoint, dirA, childRange, ray.width * 0.6f,
+                                       childIntensity, ray.ttl * 0.75f, reflectionsLeft - 1});
+                    enqueueRay(BeamRay{endPoint, dirB, childRange, ray.width * 0.6f,
+                                       childIntensity, ray.ttl * 0.75f, reflectionsLeft - 1});
                 }
             }
 
@@ -348,6 +473,7 @@ void LightSystem::castBeam(Entity& owner,
         }
 
         handleBeamImpact(owner, *hitEntity, currentIntensity, endPoint);
+        refreshBeamObstacle(hitIndex, *hitEntity);
         if (m_debugOverlay) {
             m_debugHitPoints.push_back(endPoint);
         }
@@ -355,95 +481,73 @@ void LightSystem::castBeam(Entity& owner,
     }
 }
 
-bool LightSystem::rayIntersectsRect(const sf::Vector2f& origin,
-                                    const sf::Vector2f& direction,
-                                    float maxDistance,
-                                    const sf::FloatRect& bounds,
-                                    float& outDistance,
-                                    sf::Vector2f& outNormal) const {
-    const float step = 6.f;
-    sf::Vector2f sample = origin;
-    float travelled = 0.f;
-
-    while (travelled <= maxDistance) {
-        if (bounds.contains(sample)) {
-            outDistance = travelled;
-
-            const float leftDistance = std::abs(sample.x - bounds.position.x);
-            const float rightDistance = std::abs(bounds.position.x + bounds.size.x - sample.x);
-            const float topDistance = std::abs(sample.y - bounds.position.y);
-            const float bottomDistance = std::abs(bounds.position.y + bounds.size.y - sample.y);
-            const float minAxis = std::min(std::min(leftDistance, rightDistance), std::min(topDistance, bottomDistance));
+void LightSystem::syncMirrorTable(std::vector<Entity*>& entities) {
+    if (m_mirrorEntities.changed(entities)) {
+        m_mirrorTable.clear();
+        for (Entity* entity : entities) {
+            if (!entity) continue;
 
-            if (minAxis == leftDistance) {
-                outNormal = sf::Vector2f{-1.f, 0.f};
-            }
-            else if (minAxis == rightDistance) {
-                outNormal = sf::Vector2f{1.f, 0.f};
-            }
-            else if (minAxis == topDistance) {
-                outNormal = sf::Vector2f{0.f, -1.f};
-            }
-            else {
-                outNormal = sf::Vector2f{0.f, 1.f};
+            auto* mirror = entity->getComponent<eol::MirrorComponent>();
+            auto* transform = entity->getComponent<eol::TransformComponent>();
+            if (!mirror || !transform) {
+                continue;
             }
-            return true;
+
+            MirrorSegment row;
+            row.entity = entity;
+            row.mirror = mirror;
+            row.transform = transform;
+            refreshMirrorRow(row);
+            m_mirrorTable.push_back(row);
         }
+        return;
+    }
 
-        travelled += step;
-        sample += direction * step;
+    // Same mirrors as last update; only the carried or turned ones changed
+    for (MirrorSegment& row : m_mirrorTable) {
+        if (row.mirrorVersion != row.mirror->getVersion() ||
+            row.transformVersion != row.transform->getVersion()) {
+            refreshMirrorRow(row);
+        }
     }
+}
 
-    return false;
+void LightSystem::refreshMirrorRow(MirrorSegment& row) const {
+    const eol::MirrorComponent& mirror = *row.mirror;
+    row.mirrorVersion = mirror.getVersion();
+    row.transformVersion = row.transform->getVersion();
+    row.active = mirror.isActive();
+    row.center = row.transform->getPosition();
+    row.normal = normalizeVector(mirror.getNormal());
+    row.tangent = normalizeVector(perpendicular(row.normal));
+    row.halfExtents = sf::Vector2f{std::max(4.f, mirror.getSize().x * 0.5f),
+                                   std::max(2.f, mirror.getSize().y * 0.5f)};
+    row.type = mirror.getType();
+    row.loss = clampf(mirror.getReflectionLoss(), 0.f, 0.9f);
 }
 
 bool LightSystem::rayIntersectsMirror(const sf::Vector2f& origin,
                                       const sf::Vector2f& direction,
                                       float maxDistance,
-                                      Entity& mirrorEntity,
-                                      float& outDistance,
-                                      sf::Vector2f& outNormal) const {
-    auto* mirror = mirrorEntity.getComponent<eol::MirrorComponent>();
-    auto* transform = mirrorEntity.getComponent<eol::TransformComponent>();
-    if (!mirror || !transform) {
-        return false;
-    }
-
-    sf::Vector2f normal = normalizeVector(mirror->getNormal());
-    sf::Vector2f center = transform->getPosition();
-
-    if (auto* render = mirrorEntity.getComponent<eol::RenderComponent>()) {
-        const sf::Sprite& sprite = render->getSprite();
-        center = sprite.getTransform().transformPoint(sprite.getOrigin());
-    }
-
-    const float denom = dot(direction, normal);
+                                      const MirrorSegment& mirror,
+                                      float& outDistance) const {
+    const float denom = dot(direction, mirror.normal);
     if (std::abs(denom) <= kEpsilon) {
         return false;
     }
 
-    const float distanceAlongRay = dot(center - origin, normal) / denom;
+    const float distanceAlongRay = dot(mirror.center - origin, mirror.normal) / denom;
     if (distanceAlongRay < 0.f || distanceAlongRay > maxDistance) {
         return false;
     }
 
-    const sf::Vector2f hitPoint = origin + direction * distanceAlongRay;
-    const sf::Vector2f tangent = normalizeVector(perpendicular(normal));
-    const float halfLength = std::max(4.f, mirror->getSize().x * 0.5f);
-    const float halfThickness = std::max(2.f, mirror->getSize().y * 0.5f);
-
-    const float distAlongTangent = std::abs(dot(hitPoint - center, tangent));
-    if (distAlongTangent > halfLength) {
-        return false;
-    }
-
-    const float distFromPlane = std::abs(dot(hitPoint - center, normal));
-    if (distFromPlane > halfThickness) {
+    const sf::Vector2f offset = origin + direction * distanceAlongRay - mirror.center;
+    if (std::abs(dot(offset, mirror.tangent)) > mirror.halfExtents.x ||
+        std::abs(dot(offset, mirror.normal)) > mirror.halfExtents.y) {
         return false;
     }
 
     outDistance = distanceAlongRay;
-    outNormal = normal;
     return true;
 }
 
@@ -544,13 +648,13 @@ void LightSystem::applyPuzzleLight(Entity& source, Entity& entity, float intensi
 
     puzzle->registerSourceContribution(&source);
     puzzle->addReceivedLight(intensity * 0.1f);
-    std::cout << "[LightSystem] Puzzle " << entity.name << " received " << intensity * 0.1f << " light." << std::endl;
-    std::cout << "[LightSystem] Puzzle " << entity.name << " accumulated " << puzzle->getAccumulatedLight() << " light." << std::endl;
-    std::cout << "[LightSystem] Puzzle " << entity.name << " required " << puzzle->getRequiredLight() << " light." << std::endl;
+    EOL_LOG_DEBUG << "[LightSystem] Puzzle " << entity.name << " received " << intensity * 0.1f << " light.";
+    EOL_LOG_DEBUG << "[LightSystem] Puzzle " << entity.name << " accumulated " << puzzle->getAccumulatedLight() << " light.";
+    EOL_LOG_DEBUG << "[LightSystem] Puzzle " << entity.name << " required " << puzzle->getRequiredLight() << " light.";
     if (puzzle->hasRequiredUniqueSources() &&
         puzzle->getAccumulatedLight() >= static_cast<float>(puzzle->getRequiredLight())) {
         puzzle->setSolved(true);
-        std::cout << "[LightSystem] Beacon " << entity.name << " reactivated." << std::endl;
+        EOL_LOG_DEBUG << "[LightSystem] Beacon " << entity.name << " reactivated.";
     }
 }
 
@@ -560,6 +664,33 @@ sf::Vector2f LightSystem::reflect(const sf::Vector2f& direction, const sf::Vecto
 }
 
 void LightSystem::updateLightFields(std::vector<Entity*>& entities, float deltaTime) {
+    if (m_lightFieldEntities.changed(entities)) {
+        syncLightFields(entities);
+    }
+
+    eol::LightFieldStore& fields = m_lightFields;
+    const std::size_t count = fields.size();
+    for (std::size_t i = 0; i < count; ++i) {
+        fields.timer[i] += deltaTime;
+    }
+
+    m_lightTints.resize(count);
+    decayLightFields(count, fields.intensity.data(), fields.base.data(), fields.decayRate.data(),
+                     fields.delay.data(), fields.timer.data(), deltaTime);
+    computeLightTints(count, fields.intensity.data(), m_ambientLight, m_lightTints.data());
+
+    for (std::size_t i = 0; i < count; ++i) {
+        eol::RenderComponent& render = *fields.renders[i];
+        if (render.getTint() != m_lightTints[i]) {
+            render.setTint(m_lightTints[i]);
+        }
+    }
+}
+
+void LightSystem::syncLightFields(std::vector<Entity*>& entities) {
+    eol::LightFieldStore& fields = m_lightFields;
+    m_lightFieldSeen.assign(fields.size(), 0);
+
     for (Entity* entity : entities) {
         if (!entity) continue;
 
@@ -569,33 +700,29 @@ void LightSystem::updateLightFields(std::vector<Entity*>& entities, float deltaT
             continue;
         }
 
-        light->advanceBoostTimer(deltaTime);
-
-        if (light->getIntensity() > light->getBaseIntensity()) {
-            if (light->getBoostTimer() >= light->getDecayDelay()) {
-                const float newIntensity = std::max(
-                    light->getBaseIntensity(),
-                    light->getIntensity() - light->getDecayRate() * deltaTime);
-                light->setIntensity(newIntensity);
-            }
+        if (fields.holds(*light)) {
+            m_lightFieldSeen[fields.slotOf(*light)] = 1;
         }
-        else if (light->getIntensity() < light->getBaseIntensity()) {
-            const float restoreIntensity = std::min(
-                light->getBaseIntensity(),
-                light->getIntensity() + light->getDecayRate() * deltaTime * 0.5f);
-            light->setIntensity(restoreIntensity);
+        else {
+            fields.attach(*light, *render);
+            m_lightFieldSeen.push_back(1);
         }
+    }
 
-        const float brightness = clampf(m_ambientLight + light->getIntensity(), 0.f, 1.25f);
-        sf::Color color = render->getTint();
-        color.r = static_cast<std::uint8_t>(clampf(100.f + brightness * 140.f, 0.f, 255.f));
-        color.g = static_cast<std::uint8_t>(clampf(100.f + brightness * 120.f, 0.f, 255.f));
-        color.b = static_cast<std::uint8_t>(clampf(110.f + brightness * 80.f, 0.f, 255.f));
-        color.a = static_cast<std::uint8_t>(clampf(brightness, 0.f, 1.f) * 255.f);
-        render->setTint(color);
+    // Lights that went to sleep or left the list keep their state on the
+    // component. Walking backwards, the row moved into a hole is always one
+    // already kept.
+    for (std::size_t i = fields.size(); i-- > 0;) {
+        if (!m_lightFieldSeen[i]) {
+            fields.detach(*fields.lights[i]);
+        }
     }
 }
 
+bool LightSystem::isOnScreen(const sf::FloatRect& bounds) const {
+    return geometry::boxesOverlap(bounds, m_cullRect);
+}
+
 void LightSystem::ensureOverlaySize(const sf::RenderTarget& target) {
     // Use reference resolution instead of actual window size
     // The view scales the reference resolution to fit the window,
@@ -606,45 +733,55 @@ void LightSystem::ensureOverlaySize(const sf::RenderTarget& target) {
         static_cast<float>(GameSettings::refWidth),
         static_cast<float>(GameSettings::refHeight)
     ));
+    m_darknessOverlay.setPosition(m_viewRect.position);
 
     const auto alpha = static_cast<std::uint8_t>(clampf(1.f - m_ambientLight, 0.f, 1.f) * 220.f);
     m_darknessOverlay.setFillColor(sf::Color(5, 5, 15, alpha));
 }
 
-void LightSystem::drawBeams(sf::RenderTarget& target) const {
-    if (m_beamSegments.empty()) {
-        return;
+void LightSystem::updateBeamMesh() {
+    const std::vector<sf::Vertex>& mesh = m_beams.getMesh();
+
+    if (!m_beamBufferChecked) {
+        // Needs a GL context, so it's checked on the first render
+        m_beamBufferAvailable = sf::VertexBuffer::isAvailable();
+        m_beamBufferChecked = true;
     }
 
-    sf::VertexArray mesh{sf::PrimitiveType::Triangles};
-    for (const auto& beam : m_beamSegments) {
-        const sf::Vector2f dir = beam.end - beam.start;
-        if (std::abs(dir.x) < kEpsilon && std::abs(dir.y) < kEpsilon) {
-            continue;
+    m_beamBufferCount = 0;
+    if (m_beamBufferAvailable && !mesh.empty()) {
+        if (mesh.size() > m_beamBufferCapacity) {
+            const std::size_t capacity = std::max(mesh.size(), m_beamBufferCapacity * 2);
+            if (!m_beamBuffer.create(capacity)) {
+                m_beamBufferAvailable = false;
+                return;
+            }
+            m_beamBufferCapacity = capacity;
         }
-
-        sf::Vector2f normal = normalizeVector(perpendicular(dir)) * (beam.width * 0.5f);
-        const float lifeRatio = beam.lifetime > 0.f ? clampf(beam.ttl / beam.lifetime, 0.f, 1.f) : 0.f;
-        sf::Color color = beam.color;
-        color.a = static_cast<std::uint8_t>(color.a * lifeRatio * clampf(beam.intensity / 50.f, 0.2f, 1.f));
-
-        const sf::Vector2f v0 = beam.start + normal;
-        const sf::Vector2f v1 = beam.start - normal;
-        const sf::Vector2f v2 = beam.end + normal;
-        const sf::Vector2f v3 = beam.end - normal;
-
-        mesh.append(sf::Vertex{v0, color});
-        mesh.append(sf::Vertex{v1, color});
-        mesh.append(sf::Vertex{v2, color});
-
-        mesh.append(sf::Vertex{v1, color});
-        mesh.append(sf::Vertex{v3, color});
-        mesh.append(sf::Vertex{v2, color});
+        if (!m_beamBuffer.update(mesh.data(), mesh.size(), 0)) {
+            m_beamBufferAvailable = false;
+            return;
+        }
+        m_beamBufferCount = mesh.size();
     }
+}
 
+void LightSystem::drawBeams(sf::RenderTarget& target) const {
     sf::RenderStates states;
     states.blendMode = sf::BlendAdd;
-    target.draw(mesh, states);
+    if (m_beamBufferAvailable) {
+        // What the last update uploaded; beams restored since then show
+        // from the next update
+        if (m_beamBufferCount > 0) {
+            target.draw(m_beamBuffer, 0, m_beamBufferCount, states);
+        }
+        return;
+    }
+
+    const std::vector<sf::Vertex>& mesh = m_beams.getMesh();
+    if (!mesh.empty()) {
+        target.draw(mesh.data(), mesh.size(), sf::PrimitiveType::Triangles, states);
+    }
 }
 
 void LightSystem::drawOverlay(sf::RenderTarget& target) const {
@@ -672,7 +809,7 @@ void LightSystem::drawDebugData(sf::RenderTarget& target) const {
     }
 }
 
-void LightSystem::drawLightGlows(sf::RenderTarget& target, std::vector<Entity*>& entities) {
+void LightSystem::drawLightGlows(sf::RenderTarget& target, std::vector<Entity*>& entities, GlowSet set) {
     sf::RenderStates addState;
     addState.blendMode = sf::BlendAdd;
 
@@ -684,18 +821,21 @@ void LightSystem::drawLightGlows(sf::RenderTarget& target, std::vector<Entity*>&
             continue;
         }
 
+        if (set != GlowSet::All) {
+            const bool dynamic = entity->getComponent<eol::PlayerComponent>() != nullptr;
+            if (dynamic != (set == GlowSet::Dynamic)) {
+                continue;
+            }
+        }
+
         const float intensity = clampf(light->getIntensity(), 0.f, 2.f);
         const float radius = std::max(36.f, light->getRadius() * 0.55f);
-        auto bounds = computeBounds(*entity);
-
-        sf::Vector2f center;
-        if (bounds) {
-            center = rectCenter(*bounds);
-        }
-        else if (auto* transform = entity->getComponent<eol::TransformComponent>()) {
-            center = transform->getPosition();
+        const auto lightCenter = computeLightCenter(*entity);
+        if (!lightCenter) {
+            continue;
         }
-        else {
+        const sf::Vector2f center = *lightCenter;
+        if (!isOnScreen(sf::FloatRect(center - sf::Vector2f{radius, radius}, {radius * 2.f, radius * 2.f}))) {
             continue;
         }
 
@@ -756,6 +896,20 @@ void LightSystem::drawLightBeacons(sf::RenderTarget& target, std::vector<Entity*
 
         const sf::Vector2f normal = normalizeVector(perpendicular(dir));
 
+        // Shaft bounds: the wide top edge and the narrower base
+        const sf::Vector2f corners[] = {
+            topCenter - normal * baseWidth, topCenter + normal * baseWidth,
+            bottomCenter - normal * (baseWidth * 0.4f), bottomCenter + normal * (baseWidth * 0.4f)};
+        sf::Vector2f minCorner = corners[0];
+        sf::Vector2f maxCorner = corners[0];
+        for (const sf::Vector2f& corner : corners) {
+            minCorner = {std::min(minCorner.x, corner.x), std::min(minCorner.y, corner.y)};
+            maxCorner = {std::max(maxCorner.x, corner.x), std::max(maxCorner.y, corner.y)};
+        }
+        if (!isOnScreen(sf::FloatRect(minCorner, maxCorner - minCorner))) {
+            continue;
+        }
+
         sf::VertexArray outer(sf::PrimitiveType::TriangleStrip, 4);
         sf::Color outerTop(120, 190, 255, 0);
         sf::Color outerBottom(255, 240, 200, 110);
@@ -784,3 +938,243 @@ void LightSystem::drawLightBeacons(sf::RenderTarget& target, std::vector<Entity*
     }
 }
 
+
+std::optional<sf::Vector2f> LightSystem::computeLightCenter(Entity& entity) const {
+    if (auto bounds = computeBounds(entity)) {
+        return rectCenter(*bounds);
+    }
+    if (auto* transform = entity.getComponent<eol::TransformComponent>()) {
+        return transform->getPosition();
+    }
+    return std::nullopt;
+}
+
+void LightSystem::rebuildShadow(LightShadow& shadow, const sf::Vector2f& origin, float radius) {
+    shadow.origin = origin;
+    shadow.radius = radius;
+    shadow.occluderVersion = m_shadowCaster.getVersion();
+    shadow.shadedIntensity = -1.f;
+
+    m_shadowCaster.computeVisibility(origin, radius, m_visibilityScratch);
+
+    // Centre vertex, the perimeter, then the first perimeter point again to close the fan
+    const std::size_t perimeter = m_visibilityScratch.size();
+    shadow.fan.resize(perimeter > 0 ? perimeter + 2 : 0);
+    shadow.falloff.resize(shadow.fan.getVertexCount());
+    if (perimeter == 0) {
+        return;
+    }
+
+    shadow.fan[0].position = origin;
+    shadow.falloff[0] = 1.f;
+    for (std::size_t i = 0; i <= perimeter; ++i) {
+        const sf::Vector2f& point = m_visibilityScratch[i % perimeter];
+        const sf::Vector2f offset = point - origin;
+        const float distance = std::sqrt(offset.x * offset.x + offset.y * offset.y);
+        shadow.fan[i + 1].position = point;
+        shadow.falloff[i + 1] = clampf(1.f - distance / radius, 0.f, 1.f);
+    }
+}
+
+bool LightSystem::updateLightmap(std::vector<Entity*>& entities) {
+    if (m_lightmapUnavailable) {
+        return false;
+    }
+
+    // Half the reference resolution; the falloff is smooth enough to upscale
+    constexpr unsigned int kDownscale = 2;
+    if (!m_lightmapReady) {
+        const sf::Vector2u size{GameSettings::refWidth / kDownscale, GameSettings::refHeight / kDownscale};
+        if (!m_lightmap.resize(size)) {
+            EOL_LOG_WARNING << "Lightmap render texture unavailable, using flat darkness overlay";
+            m_lightmapUnavailable = true;
+            return false;
+        }
+        m_lightmap.setSmooth(true);
+        m_lightmapReady = true;
+    }
+    m_lightmap.setView(sf::View(m_viewRect));
+
+    // Unlit areas get the same darkening the flat overlay would apply
+    const auto shade = static_cast<std::uint8_t>(255 - m_darknessOverlay.getFillColor().a);
+    m_lightmap.clear(sf::Color(shade, shade, static_cast<std::uint8_t>(std::min(255, shade + 10))));
+
+    sf::RenderStates addState;
+    addState.blendMode = sf::BlendAdd;
+
+    ++m_lightFrame;
+    for (Entity* entity : entities) {
+        if (!entity) continue;
+
+        auto* light = entity->getComponent<eol::LightComponent>();
+        if (!light || !light->isEnabled() || light->getRadius() <= 0.f) {
+            continue;
+        }
+
+        const auto center = computeLightCenter(*entity);
+        if (!center) {
+            continue;
+        }
+
+        // Off-screen lights keep their cached fan but are not drawn
+        const float radius = light->getRadius();
+        if (!isOnScreen(sf::FloatRect(*center - sf::Vector2f{radius, radius}, {radius * 2.f, radius * 2.f}))) {
+            const auto cached = m_shadows.find(entity);
+            if (cached != m_shadows.end()) {
+                cached->second.lastFrame = m_lightFrame;
+            }
+            continue;
+        }
+
+        LightShadow& shadow = m_shadows[entity];
+        const sf::Vector2f moved = *center - shadow.origin;
+        if (shadow.occluderVersion != m_shadowCaster.getVersion()
+            || std::abs(shadow.radius - light->getRadius()) > 0.5f
+            || moved.x * moved.x + moved.y * moved.y > 0.25f
+            || shadow.fan.getVertexCount() == 0) {
+            rebuildShadow(shadow, *center, light->getRadius());
+        }
+        shadow.lastFrame = m_lightFrame;
+
+        const float intensity = clampf(light->getIntensity(), 0.f, 2.f);
+        if (std::abs(intensity - shadow.shadedIntensity) > 0.005f) {
+            const float peak = clampf(0.35f + intensity * 0.5f, 0.f, 1.f) * 255.f;
+            for (std::size_t i = 0; i < shadow.fan.getVertexCount(); ++i) {
+                shadow.fan[i].color = sf::Color(255, 244, 214,
+                    static_cast<std::uint8_t>(peak * shadow.falloff[i]));
+            }
+            shadow.shadedIntensity = intensity;
+        }
+
+        m_lightmap.draw(shadow.fan, addState);
+    }
+
+    // Forget lights that were not drawn this frame (disabled or removed)
+    for (auto it = m_shadows.begin(); it != m_shadows.end();) {
+        if (it->second.lastFrame != m_lightFrame) {
+            it = m_shadows.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+
+    m_lightmap.display();
+    return true;
+}
+
+void LightSystem::drawLightmap(sf::RenderTarget& target) const {
+    const sf::Vector2u size = m_lightmap.getSize();
+    sf::Sprite lightmapSprite(m_lightmap.getTexture());
+    lightmapSprite.setScale({static_cast<float>(GameSettings::refWidth) / size.x,
+                             static_cast<float>(GameSettings::refHeight) / size.y});
+    lightmapSprite.setPosition(m_viewRect.position);
+
+    sf::RenderStates multiplyState;
+    multiplyState.blendMode = sf::BlendMultiply;
+    target.draw(lightmapSprite, multiplyState);
+}
+
+void LightSystem::collectStaticSignature(std::vector<Entity*>& entities, std::vector<float>& out) {
+    out.clear();
+    for (Entity* entity : entities) {
+        if (!entity) continue;
+
+        auto* light = entity->getComponent<eol::LightComponent>();
+        if (light && light->isEnabled() && !entity->getComponent<eol::PlayerComponent>()) {
+            if (const auto center = computeLightCenter(*entity)) {
+                // Glow alpha only has a few dozen distinct steps
+                out.push_back(center->x);
+                out.push_back(center->y);
+                out.push_back(light->getRadius());
+                out.push_back(std::round(clampf(light->getIntensity(), 0.f, 2.f) * 32.f));
+            }
+        }
+
+        auto* source = entity->getComponent<eol::LightSourceComponent>();
+        auto* puzzle = entity->getComponent<eol::PuzzleComponent>();
+        if (source && puzzle && source->isActive() && puzzle->isSolved()) {
+            if (const auto bounds = computeBounds(*entity)) {
+                out.push_back(bounds->position.x);
+                out.push_back(bounds->position.y);
+                out.push_back(bounds->size.x);
+                out.push_back(bounds->size.y);
+            }
+            if (auto* emitter = entity->getComponent<eol::LightEmitterComponent>()) {
+                out.push_back(emitter->getDirection().x);
+                out.push_back(emitter->getDirection().y);
+            }
+        }
+    }
+}
+
+bool LightSystem::composeLightLayers(std::vector<Entity*>& entities) {
+    if (m_layersUnavailable) {
+        return false;
+    }
+
+    if (!m_layersReady) {
+        // Plain colour targets: no depth/stencil, no shaders, so software
+        // GL (Mesa llvmpipe) handles them like any other driver
+        const sf::Vector2u size{GameSettings::refWidth, GameSettings::refHeight};
+        const auto margin = static_cast<unsigned int>(kStaticLayerMargin);
+        const sf::Vector2u staticSize{size.x + margin * 2u, size.y + margin * 2u};
+        if (!m_staticLayer.resize(staticSize) || !m_compositeLayer.resize(size)) {
+            EOL_LOG_WARNING << "Light layer render textures unavailable, drawing lights directly";
+            m_layersUnavailable = true;
+            return false;
+        }
+        m_layersReady = true;
+        m_staticLayerDirty = true;
+    }
+
+    const sf::View worldView(m_viewRect);
+    m_compositeLayer.setView(worldView);
+
+    collectStaticSignature(entities, m_signatureScratch);
+    if (m_staticLayerDirty || m_signatureScratch != m_staticSignature || !staticRegionCovers(m_viewRect)) {
+        placeStaticRegion();
+        m_staticLayer.setView(sf::View(m_staticRegion));
+        m_staticLayer.clear(sf::Color::Transparent);
+        m_cullRect = m_staticRegion;
+        drawLightGlows(m_staticLayer, entities, GlowSet::Static);
+        drawLightBeacons(m_staticLayer, entities);
+        m_cullRect = m_viewRect;
+        m_staticLayer.display();
+        m_staticSignature.swap(m_signatureScratch);
+        m_staticLayerDirty = false;
+    }
+
+    // Same order as drawing straight to the target: glows and shafts are
+    // darkened by the lightmap, beams are drawn over it at full strength
+    m_compositeLayer.clear(sf::Color::Transparent);
+    sf::RenderStates copyState;
+    copyState.blendMode = sf::BlendNone;
+    sf::Sprite staticSprite(m_staticLayer.getTexture());
+    staticSprite.setPosition(m_staticRegion.position);
+    m_compositeLayer.draw(staticSprite, copyState);
+    drawLightGlows(m_compositeLayer, entities, GlowSet::Dynamic);
+    drawLightmap(m_compositeLayer);
+    drawBeams(m_compositeLayer);
+    m_compositeLayer.display();
+    return true;
+}
+
+// The view grown by the margin, its corner snapped down to the tile grid so
+// the layer lines up the same way each time it is redrawn. Snapping moves
+// the corner by less than the margin, so the view always stays inside.
+void LightSystem::placeStaticRegion() {
+    const float step = (m_tileSize > 0.f && m_tileSize <= kStaticLayerMargin) ? m_tileSize : kStaticLayerMargin;
+    const sf::Vector2f corner = m_viewRect.position - sf::Vector2f{kStaticLayerMargin, kStaticLayerMargin};
+    const sf::Vector2f snapped{
+        m_tileOffset.x + std::floor((corner.x - m_tileOffset.x) / step) * step,
+        m_tileOffset.y + std::floor((corner.y - m_tileOffset.y) / step) * step};
+    m_staticRegion = sf::FloatRect(snapped, sf::Vector2f(m_staticLayer.getSize()));
+}
+
+bool LightSystem::staticRegionCovers(const sf::FloatRect& view) const {
+    return view.position.x >= m_staticRegion.position.x &&
+           view.position.y >= m_staticRegion.position.y &&
+           view.position.x + view.size.x <= m_staticRegion.position.x + m_staticRegion.size.x &&
+           view.position.y + view.size.y <= m_staticRegion.position.y + m_staticRegion.size.y;
+}
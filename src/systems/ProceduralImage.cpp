@@ -0,0 +1,277 @@
+#include "systems/ProceduralImage.h"
+#include "Log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace procedural {
+
+namespace {
+// Bump whenever a generator's output changes so stale cache files are redone
+constexpr std::uint32_t kGeneratorVersion = 1;
+constexpr char kCacheMagic[4] = { 'E', 'O', 'L', 'I' };
+constexpr std::size_t kHeaderSize = 16;     // magic, version, width, height
+constexpr std::uint32_t kMaxCachedEdge = 8192;
+
+// Writes count pixels lerped from a to b by t[i] and scaled by coverage[i].
+// Same arithmetic as the old per-pixel setPixel path (truncating), so a
+// falloff comes out byte-identical.
+void shadeRow(const float* t, const float* coverage, std::size_t count,
+              const sf::Color& a, const sf::Color& b, std::uint8_t* out) {
+    const float ar = a.r, ag = a.g, ab = a.b, aa = a.a;
+    const float br = b.r, bg = b.g, bb = b.b, ba = b.a;
+    for (std::size_t i = 0; i < count; ++i) {
+        const float s = 1.f - t[i];
+        const float c = coverage[i];
+        out[i * 4 + 0] = static_cast<std::uint8_t>((ar * s + br * t[i]) * c);
+        out[i * 4 + 1] = static_cast<std::uint8_t>((ag * s + bg * t[i]) * c);
+        out[i * 4 + 2] = static_cast<std::uint8_t>((ab * s + bb * t[i]) * c);
+        out[i * 4 + 3] = static_cast<std::uint8_t>((aa * s + ba * t[i]) * c);
+    }
+}
+
+// Lattice value in [0, 1]; integer hash so it is identical everywhere
+float latticeValue(std::int32_t x, std::int32_t y, std::uint32_t seed) {
+    std::uint32_t h = seed ^ (static_cast<std::uint32_t>(x) * 0x27D4EB2Du) ^ (static_cast<std::uint32_t>(y) * 0x165667B1u);
+    h ^= h >> 15;
+    h *= 0x85EBCA6Bu;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35u;
+    h ^= h >> 16;
+    return static_cast<float>(h & 0xFFFFFFu) / static_cast<float>(0xFFFFFF);
+}
+
+float smoothstep(float t) {
+    return t * t * (3.f - 2.f * t);
+}
+
+void appendColor(std::ostringstream& key, const sf::Color& color) {
+    char hex[9];
+    std::snprintf(hex, sizeof(hex), "%02x%02x%02x%02x", color.r, color.g, color.b, color.a);
+    key << '_' << hex;
+}
+
+void writeU32(std::ostream& out, std::uint32_t value) {
+    const char bytes[4] = {
+        static_cast<char>(value & 0xFF), static_cast<char>((value >> 8) & 0xFF),
+        static_cast<char>((value >> 16) & 0xFF), static_cast<char>((value >> 24) & 0xFF) };
+    out.write(bytes, 4);
+}
+
+std::uint32_t readU32(const unsigned char* bytes) {
+    return static_cast<std::uint32_t>(bytes[0]) | (static_cast<std::uint32_t>(bytes[1]) << 8)
+        | (static_cast<std::uint32_t>(bytes[2]) << 16) | (static_cast<std::uint32_t>(bytes[3]) << 24);
+}
+} // namespace
+
+void PixelBuffer::resize(const sf::Vector2u& newSize) {
+    size = newSize;
+    rgba.assign(static_cast<std::size_t>(newSize.x) * newSize.y * 4, 0);
+}
+
+sf::Image PixelBuffer::toImage() const {
+    if (size.x == 0 || size.y == 0) {
+        return sf::Image();
+    }
+    return sf::Image(size, rgba.data());
+}
+
+void generate(const RadialFalloff& params, PixelBuffer& out) {
+    const unsigned int size = params.size;
+    out.resize({ size, size });
+    if (size == 0) {
+        return;
+    }
+
+    const float half = static_cast<float>(size) * 0.5f;
+
+    // dx^2 is the same for every row
+    std::vector<float> dx2(size);
+    for (unsigned int x = 0; x < size; ++x) {
+        const float dx = static_cast<float>(x) - half + 0.5f;
+        dx2[x] = dx * dx;
+    }
+
+    std::vector<float> t(size);
+    std::vector<float> coverage(size);
+    for (unsigned int y = 0; y < size; ++y) {
+        const float dy = static_cast<float>(y) - half + 0.5f;
+        const float dy2 = dy * dy;
+        for (unsigned int x = 0; x < size; ++x) {
+            const float norm = std::sqrt(dx2[x] + dy2) / half;
+            t[x] = std::min(norm, 1.f);
+            coverage[x] = norm <= 1.f ? 1.f : 0.f;
+        }
+        shadeRow(t.data(), coverage.data(), size, params.center, params.edge,
+                 out.rgba.data() + static_cast<std::size_t>(y) * size * 4);
+    }
+}
+
+void generate(const LinearGradient& params, PixelBuffer& out) {
+    const sf::Vector2u size = params.size;
+    out.resize(size);
+    if (size.x == 0 || size.y == 0) {
+        return;
+    }
+
+    const float steps = static_cast<float>(std::max(1u, (params.vertical ? size.y : size.x) - 1));
+    std::vector<float> t(size.x);
+    const std::vector<float> coverage(size.x, 1.f);
+    for (unsigned int x = 0; x < size.x; ++x) {
+        t[x] = params.vertical ? 0.f : static_cast<float>(x) / steps;
+    }
+
+    for (unsigned int y = 0; y < size.y; ++y) {
+        if (params.vertical) {
+            std::fill(t.begin(), t.end(), static_cast<float>(y) / steps);
+        }
+        shadeRow(t.data(), coverage.data(), size.x, params.from, params.to,
+                 out.rgba.data() + static_cast<std::size_t>(y) * size.x * 4);
+    }
+}
+
+void generate(const ValueNoise& params, PixelBuffer& out) {
+    const sf::Vector2u size = params.size;
+    out.resize(size);
+    if (size.x == 0 || size.y == 0) {
+        return;
+    }
+
+    const float invCell = 1.f / std::max(1.f, params.cellSize);
+
+    // Per column: lattice cell and smoothed weight, shared by all rows
+    std::vector<std::int32_t> cellX(size.x);
+    std::vector<float> weightX(size.x);
+    for (unsigned int x = 0; x < size.x; ++x) {
+        const float fx = static_cast<float>(x) * invCell;
+        cellX[x] = static_cast<std::int32_t>(fx);
+        weightX[x] = smoothstep(fx - static_cast<float>(cellX[x]));
+    }
+    const std::size_t latticeWidth = static_cast<std::size_t>(cellX.back()) + 2;
+
+    std::vector<float> top(latticeWidth);
+    std::vector<float> bottom(latticeWidth);
+    std::vector<float> t(size.x);
+    const std::vector<float> coverage(size.x, 1.f);
+    std::int32_t cachedRow = -1;
+
+    for (unsigned int y = 0; y < size.y; ++y) {
+        const float fy = static_cast<float>(y) * invCell;
+        const std::int32_t cellY = static_cast<std::int32_t>(fy);
+        const float wy = smoothstep(fy - static_cast<float>(cellY));
+
+        // Lattice rows only change once per cell
+        if (cellY != cachedRow) {
+            for (std::size_t i = 0; i < latticeWidth; ++i) {
+                top[i] = latticeValue(static_cast<std::int32_t>(i), cellY, params.seed);
+                bottom[i] = latticeValue(static_cast<std::int32_t>(i), cellY + 1, params.seed);
+            }
+            cachedRow = cellY;
+        }
+
+        for (unsigned int x = 0; x < size.x; ++x) {
+            const std::size_t c = static_cast<std::size_t>(cellX[x]);
+            const float upper = top[c] + (top[c + 1] - top[c]) * weightX[x];
+            const float lower = bottom[c] + (bottom[c + 1] - bottom[c]) * weightX[x];
+            t[x] = upper + (lower - upper) * wy;
+        }
+        shadeRow(t.data(), coverage.data(), size.x, params.low, params.high,
+                 out.rgba.data() + static_cast<std::size_t>(y) * size.x * 4);
+    }
+}
+
+std::string cacheKey(const RadialFalloff& params) {
+    std::ostringstream key;
+    key << "falloff_" << params.size;
+    appendColor(key, params.center);
+    appendColor(key, params.edge);
+    return key.str();
+}
+
+std::string cacheKey(const LinearGradient& params) {
+    std::ostringstream key;
+    key << "gradient_" << params.size.x << 'x' << params.size.y << (params.vertical ? "_v" : "_h");
+    appendColor(key, params.from);
+    appendColor(key, params.to);
+    return key.str();
+}
+
+std::string cacheKey(const ValueNoise& params) {
+    std::ostringstream key;
+    // Cell size by bit pattern would be exact but unreadable; 1/1000 px is plenty
+    key << "noise_" << params.size.x << 'x' << params.size.y
+        << "_c" << static_cast<long>(std::lround(params.cellSize * 1000.f)) << "_s" << params.seed;
+    appendColor(key, params.low);
+    appendColor(key, params.high);
+    return key.str();
+}
+
+ImageCache::ImageCache(std::string directory)
+    : m_directory(std::move(directory)) {
+}
+
+std::string ImageCache::pathFor(const std::string& key) const {
+    return m_directory + "/" + key + ".eoli";
+}
+
+bool ImageCache::load(const std::string& key, PixelBuffer& out) const {
+    std::ifstream file(pathFor(key), std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    unsigned char header[kHeaderSize];
+    if (!file.read(reinterpret_cast<char*>(header), kHeaderSize)
+        || !std::equal(kCacheMagic, kCacheMagic + 4, header)
+        || readU32(header + 4) != kGeneratorVersion) {
+        return false;
+    }
+
+    const sf::Vector2u size{ readU32(header + 8), readU32(header + 12) };
+    if (size.x > kMaxCachedEdge || size.y > kMaxCachedEdge) {
+        return false;
+    }
+    out.resize(size);
+    if (!file.read(reinterpret_cast<char*>(out.rgba.data()), static_cast<std::streamsize>(out.rgba.size()))) {
+        EOL_LOG_WARNING << "Truncated image cache file for " << key << ", regenerating";
+        return false;
+    }
+    return true;
+}
+
+void ImageCache::store(const std::string& key, const PixelBuffer& pixels) const {
+    std::error_code error;
+    std::filesystem::create_directories(m_directory, error);
+
+    // Written aside and renamed, so a reader never sees half a file
+    const std::string path = pathFor(key);
+    const std::string temp = path + ".tmp";
+    {
+        std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            EOL_LOG_WARNING << "Cannot write image cache file " << temp;
+            return;
+        }
+        file.write(kCacheMagic, 4);
+        writeU32(file, kGeneratorVersion);
+        writeU32(file, pixels.size.x);
+        writeU32(file, pixels.size.y);
+        file.write(reinterpret_cast<const char*>(pixels.rgba.data()), static_cast<std::streamsize>(pixels.rgba.size()));
+        if (!file) {
+            EOL_LOG_WARNING << "Cannot write image cache file " << temp;
+            return;
+        }
+    }
+
+    std::filesystem::rename(temp, path, error);
+    if (error) {
+        EOL_LOG_WARNING << "Cannot store image cache file " << path << ": " << error.message();
+        std::filesystem::remove(temp, error);
+    }
+}
+
+} // namespace procedural
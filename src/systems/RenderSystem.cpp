@@ -5,12 +5,21 @@
 #include "components/PlayerComponent.h"
 #include "components/RenderComponent.h"
 #include "components/TransformComponent.h"
+#include "systems/Camera.h"
 
 #include <SFML/Graphics/RectangleShape.hpp>
 #include <algorithm>
 
 void RenderSystem::render(sf::RenderWindow& window, std::vector<Entity*>& entities) {
-    Entity* player = nullptr;
+    // Health bars sit just above the sprite, so look a little past the view
+    constexpr float kMargin = 64.f;
+    sf::FloatRect visibleArea = viewBounds(window.getView());
+    visibleArea.position -= sf::Vector2f(kMargin, kMargin);
+    visibleArea.size += sf::Vector2f(kMargin * 2.f, kMargin * 2.f);
+
+    // Every sprite is brought up to date anyway, so its bounds are tested in
+    // the same pass; the list stays in entity order, keeping the layering
+    m_drawables.clear();
     for (Entity* entity : entities) {
         if (!entity) continue;
 
@@ -21,19 +30,21 @@ void RenderSystem::render(sf::RenderWindow& window, std::vector<Entity*>& entiti
 
         sf::Sprite& sprite = render->getSprite();
         updateSpriteFromComponents(sprite, *entity);
-        window.draw(sprite);
-        drawEnemyHealthBar(window, *entity);
-
-        if (entity->name == "Player") {
-            player = entity;
+        if (geometry::boxesOverlap(sprite.getGlobalBounds(), visibleArea)) {
+            m_drawables.push_back({ entity, &sprite });
         }
     }
 
-    if (player) {
-        drawPlayerHealthBar(window, *player);
+    for (const Drawable& drawable : m_drawables) {
+        window.draw(*drawable.sprite);
+        drawEnemyHealthBar(window, *drawable.entity);
     }
 }
 
+void RenderSystem::renderHud(sf::RenderWindow& window, Entity& player) {
+    drawPlayerHealthBar(window, player);
+}
+
 void RenderSystem::updateSpriteFromComponents(sf::Sprite& sprite, Entity& entity) {
     if (auto* transform = entity.getComponent<eol::TransformComponent>()) {
         sprite.setPosition(transform->getPosition());
@@ -43,10 +54,9 @@ void RenderSystem::updateSpriteFromComponents(sf::Sprite& sprite, Entity& entity
 
     if (auto* animation = entity.getComponent<eol::AnimationComponent>()) {
         if (const sf::Texture* texture = animation->getCurrentTexture()) {
+            const sf::IntRect& frameRect = animation->getCurrentFrameRect();
             sprite.setTexture(*texture, false);
-            sprite.setTextureRect(animation->getCurrentFrameRect());
-
-            sf::IntRect frameRect = animation->getCurrentFrameRect();
+            sprite.setTextureRect(frameRect);
             sprite.setOrigin(sf::Vector2f(frameRect.size.x / 2.f, frameRect.size.y / 2.f));
         }
     }
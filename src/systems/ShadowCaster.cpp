@@ -0,0 +1,184 @@
+#include "systems/ShadowCaster.h"
+
+#include "components/Map.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+constexpr float kPi = 3.1415926535f;
+
+// Fixed rays that keep the polygon round where no wall is in range
+constexpr int kRingRays = 48;
+
+// Angular offset of the extra rays that slip past segment endpoints
+constexpr float kEndpointNudge = 0.0005f;
+
+float cross(const sf::Vector2f& lhs, const sf::Vector2f& rhs) {
+    return lhs.x * rhs.y - lhs.y * rhs.x;
+}
+
+bool isWall(const Map& map, int x, int y) {
+    return map.getTile(x, y) == TileType::WALL;
+}
+} // namespace
+
+ShadowCaster::ShadowCaster()
+    : m_grid(128.f) {
+}
+
+void ShadowCaster::clear() {
+    m_segments.clear();
+    m_segmentBounds.clear();
+    m_grid.build(m_segmentBounds);
+    ++m_version;
+}
+
+void ShadowCaster::build(const Map& map, float tileSize, const sf::Vector2f& offset) {
+    m_segments.clear();
+    m_segmentBounds.clear();
+
+    const int width = map.getWidth();
+    const int height = map.getHeight();
+
+    // Horizontal edges: line y separates row y-1 from row y. Tiles outside
+    // the map count as wall, so the outer border produces no edges.
+    for (int y = 0; y <= height; ++y) {
+        int runStart = -1;
+        for (int x = 0; x <= width; ++x) {
+            const bool edge = x < width && isWall(map, x, y - 1) != isWall(map, x, y);
+            if (edge && runStart < 0) {
+                runStart = x;
+            }
+            else if (!edge && runStart >= 0) {
+                const float py = offset.y + y * tileSize;
+                m_segments.push_back({ { offset.x + runStart * tileSize, py },
+                                       { offset.x + x * tileSize, py } });
+                runStart = -1;
+            }
+        }
+    }
+
+    // Vertical edges: line x separates column x-1 from column x
+    for (int x = 0; x <= width; ++x) {
+        int runStart = -1;
+        for (int y = 0; y <= height; ++y) {
+            const bool edge = y < height && isWall(map, x - 1, y) != isWall(map, x, y);
+            if (edge && runStart < 0) {
+                runStart = y;
+            }
+            else if (!edge && runStart >= 0) {
+                const float px = offset.x + x * tileSize;
+                m_segments.push_back({ { px, offset.y + runStart * tileSize },
+                                       { px, offset.y + y * tileSize } });
+                runStart = -1;
+            }
+        }
+    }
+
+    m_segmentBounds.reserve(m_segments.size());
+    for (const Segment& segment : m_segments) {
+        const sf::Vector2f minCorner{ std::min(segment.a.x, segment.b.x), std::min(segment.a.y, segment.b.y) };
+        const sf::Vector2f maxCorner{ std::max(segment.a.x, segment.b.x), std::max(segment.a.y, segment.b.y) };
+        m_segmentBounds.emplace_back(minCorner, maxCorner - minCorner);
+    }
+
+    m_grid.setCellSize(std::max(tileSize * 4.f, 32.f));
+    m_grid.build(m_segmentBounds);
+    ++m_version;
+}
+
+void ShadowCaster::computeVisibility(const sf::Vector2f& origin,
+                                     float radius,
+                                     std::vector<sf::Vector2f>& outPolygon) const {
+    outPolygon.clear();
+    if (radius <= 0.f) {
+        return;
+    }
+
+    m_nearby.clear();
+    m_angles.clear();
+
+    const sf::FloatRect area{ origin - sf::Vector2f{ radius, radius }, { radius * 2.f, radius * 2.f } };
+    m_grid.query(area, [this](std::size_t index) {
+        m_nearby.push_back(static_cast<std::uint32_t>(index));
+    });
+
+    for (int i = 0; i < kRingRays; ++i) {
+        m_angles.push_back(-kPi + (2.f * kPi * i) / kRingRays);
+    }
+
+    const float radiusSq = radius * radius;
+    const auto addRaysAt = [this, &origin](const sf::Vector2f& point, bool slipPast) {
+        const sf::Vector2f toPoint = point - origin;
+        const float angle = std::atan2(toPoint.y, toPoint.x);
+        m_angles.push_back(angle);
+        if (slipPast) {
+            m_angles.push_back(angle - kEndpointNudge);
+            m_angles.push_back(angle + kEndpointNudge);
+        }
+    };
+
+    for (std::uint32_t index : m_nearby) {
+        // Clip the segment to the light circle: |a + u * span - origin| = radius
+        const Segment& segment = m_segments[index];
+        const sf::Vector2f span = segment.b - segment.a;
+        const sf::Vector2f fromOrigin = segment.a - origin;
+        const float a = span.x * span.x + span.y * span.y;
+        const float b = fromOrigin.x * span.x + fromOrigin.y * span.y;
+        const float c = fromOrigin.x * fromOrigin.x + fromOrigin.y * fromOrigin.y - radiusSq;
+        const float discriminant = b * b - a * c;
+        if (a <= 0.f || discriminant < 0.f) {
+            continue;
+        }
+
+        const float root = std::sqrt(discriminant);
+        const float enter = (-b - root) / a;
+        const float leave = (-b + root) / a;
+        if (enter > 1.f || leave < 0.f) {
+            continue;
+        }
+
+        // A real endpoint gets rays either side so the sweep can slip past
+        // it; a point where the wall crosses the circle only needs its own
+        // ray to put a polygon corner on the wall at the edge of the light
+        if (enter <= 0.f) {
+            addRaysAt(segment.a, true);
+        }
+        else {
+            addRaysAt(segment.a + span * enter, false);
+        }
+        if (leave >= 1.f) {
+            addRaysAt(segment.b, true);
+        }
+        else {
+            addRaysAt(segment.a + span * leave, false);
+        }
+    }
+
+    std::sort(m_angles.begin(), m_angles.end());
+
+    outPolygon.reserve(m_angles.size());
+    for (float angle : m_angles) {
+        const sf::Vector2f direction{ std::cos(angle), std::sin(angle) };
+        float closest = radius;
+
+        for (std::uint32_t index : m_nearby) {
+            const Segment& segment = m_segments[index];
+            const sf::Vector2f span = segment.b - segment.a;
+            const float denom = cross(direction, span);
+            if (std::abs(denom) < 1e-6f) {
+                continue;
+            }
+
+            const sf::Vector2f toStart = segment.a - origin;
+            const float t = cross(toStart, span) / denom;
+            const float u = cross(toStart, direction) / denom;
+            if (t >= 0.f && t < closest && u >= 0.f && u <= 1.f) {
+                closest = t;
+            }
+        }
+
+        outPolygon.push_back(origin + direction * closest);
+    }
+}
@@ -0,0 +1,111 @@
+#include "systems/SpatialGrid.h"
+
+#include <cmath>
+
+namespace {
+// Upper bound on cells per build; larger areas get coarser cells instead
+constexpr int kMaxCells = 128 * 128;
+} // namespace
+
+SpatialGrid::SpatialGrid(float cellSize)
+    : m_cellSize(std::max(1.f, cellSize))
+    , m_activeCellSize(m_cellSize) {
+}
+
+void SpatialGrid::setCellSize(float cellSize) noexcept {
+    m_cellSize = std::max(1.f, cellSize);
+}
+
+float SpatialGrid::getCellSize() const noexcept {
+    return m_cellSize;
+}
+
+void SpatialGrid::build(const std::vector<sf::FloatRect>& bounds) {
+    m_itemCount = bounds.size();
+    m_columns = 0;
+    m_rows = 0;
+    m_cellStart.clear();
+    m_cellItems.clear();
+    m_visitStamp.assign(m_itemCount, 0u);
+    m_currentStamp = 0;
+
+    if (bounds.empty()) {
+        return;
+    }
+
+    // Grid covers the union of all items
+    sf::Vector2f minCorner = bounds[0].position;
+    sf::Vector2f maxCorner = bounds[0].position + bounds[0].size;
+    for (const sf::FloatRect& rect : bounds) {
+        minCorner.x = std::min(minCorner.x, rect.position.x);
+        minCorner.y = std::min(minCorner.y, rect.position.y);
+        maxCorner.x = std::max(maxCorner.x, rect.position.x + rect.size.x);
+        maxCorner.y = std::max(maxCorner.y, rect.position.y + rect.size.y);
+    }
+
+    m_origin = minCorner;
+    m_activeCellSize = m_cellSize;
+    const sf::Vector2f extent = maxCorner - minCorner;
+    for (;;) {
+        m_columns = std::max(1, static_cast<int>(std::ceil(extent.x / m_activeCellSize)) + 1);
+        m_rows = std::max(1, static_cast<int>(std::ceil(extent.y / m_activeCellSize)) + 1);
+        if (m_columns * m_rows <= kMaxCells) {
+            break;
+        }
+        m_activeCellSize *= 2.f;
+    }
+
+    const std::size_t cellCount = static_cast<std::size_t>(m_columns) * m_rows;
+    m_cellStart.assign(cellCount + 1, 0u);
+
+    // Pass 1: count items per cell (shifted by one for the prefix sum)
+    for (const sf::FloatRect& rect : bounds) {
+        int x0, y0, x1, y1;
+        cellRange(rect, x0, y0, x1, y1);
+        for (int cy = y0; cy <= y1; ++cy) {
+            for (int cx = x0; cx <= x1; ++cx) {
+                ++m_cellStart[static_cast<std::size_t>(cy) * m_columns + cx + 1];
+            }
+        }
+    }
+
+    for (std::size_t i = 1; i <= cellCount; ++i) {
+        m_cellStart[i] += m_cellStart[i - 1];
+    }
+
+    // Pass 2: scatter item indices into their cells
+    m_cellItems.resize(m_cellStart[cellCount]);
+    m_fillCursor.assign(m_cellStart.begin(), m_cellStart.end() - 1);
+    for (std::size_t item = 0; item < bounds.size(); ++item) {
+        int x0, y0, x1, y1;
+        cellRange(bounds[item], x0, y0, x1, y1);
+        for (int cy = y0; cy <= y1; ++cy) {
+            for (int cx = x0; cx <= x1; ++cx) {
+                const std::size_t cell = static_cast<std::size_t>(cy) * m_columns + cx;
+                m_cellItems[m_fillCursor[cell]++] = static_cast<std::uint32_t>(item);
+            }
+        }
+    }
+}
+
+bool SpatialGrid::cellRange(const sf::FloatRect& area, int& x0, int& y0, int& x1, int& y1) const {
+    if (m_columns == 0 || m_rows == 0) {
+        return false;
+    }
+
+    const float inv = 1.f / m_activeCellSize;
+    x0 = static_cast<int>(std::floor((area.position.x - m_origin.x) * inv));
+    y0 = static_cast<int>(std::floor((area.position.y - m_origin.y) * inv));
+    x1 = static_cast<int>(std::floor((area.position.x + area.size.x - m_origin.x) * inv));
+    y1 = static_cast<int>(std::floor((area.position.y + area.size.y - m_origin.y) * inv));
+
+    if (x1 < 0 || y1 < 0 || x0 >= m_columns || y0 >= m_rows) {
+        return false;
+    }
+
+    x0 = std::max(0, x0);
+    y0 = std::max(0, y0);
+    x1 = std::min(m_columns - 1, x1);
+    y1 = std::min(m_rows - 1, y1);
+    return true;
+}
@@ -0,0 +1,137 @@
+#include "systems/TextLayout.h"
+
+#include <algorithm>
+
+namespace {
+// Same glyph padding sf::Text uses, so the quads sample identical texels
+constexpr float kGlyphPadding = 1.f;
+
+char32_t toCodepoint(char c) {
+    return static_cast<char32_t>(static_cast<unsigned char>(c));
+}
+
+bool isBreak(char32_t c) {
+    return c == U' ' || c == U'\t' || c == U'\n' || c == U'\r';
+}
+
+void appendQuad(std::vector<sf::Vertex>& out, const sf::Vector2f& pen, const sf::Glyph& glyph, sf::Color color) {
+    const float left = glyph.bounds.position.x - kGlyphPadding;
+    const float top = glyph.bounds.position.y - kGlyphPadding;
+    const float right = glyph.bounds.position.x + glyph.bounds.size.x + kGlyphPadding;
+    const float bottom = glyph.bounds.position.y + glyph.bounds.size.y + kGlyphPadding;
+
+    const float u1 = static_cast<float>(glyph.textureRect.position.x) - kGlyphPadding;
+    const float v1 = static_cast<float>(glyph.textureRect.position.y) - kGlyphPadding;
+    const float u2 = static_cast<float>(glyph.textureRect.position.x + glyph.textureRect.size.x) + kGlyphPadding;
+    const float v2 = static_cast<float>(glyph.textureRect.position.y + glyph.textureRect.size.y) + kGlyphPadding;
+
+    out.push_back(sf::Vertex{pen + sf::Vector2f{left, top}, color, {u1, v1}});
+    out.push_back(sf::Vertex{pen + sf::Vector2f{right, top}, color, {u2, v1}});
+    out.push_back(sf::Vertex{pen + sf::Vector2f{left, bottom}, color, {u1, v2}});
+    out.push_back(sf::Vertex{pen + sf::Vector2f{left, bottom}, color, {u1, v2}});
+    out.push_back(sf::Vertex{pen + sf::Vector2f{right, top}, color, {u2, v1}});
+    out.push_back(sf::Vertex{pen + sf::Vector2f{right, bottom}, color, {u2, v2}});
+}
+} // namespace
+
+void TextLayout::build(const sf::Font& font,
+                       const std::string& text,
+                       unsigned int characterSize,
+                       float maxWidth,
+                       sf::Color color) {
+    m_font = &font;
+    m_characterSize = characterSize;
+    m_vertices.clear();
+    m_vertexEnd.clear();
+    m_vertices.reserve(text.size() * 6);
+    m_vertexEnd.reserve(text.size() + 1);
+    m_vertexEnd.push_back(0);
+
+    const float whitespaceWidth = font.getGlyph(U' ', characterSize, false).advance;
+    const float lineSpacing = font.getLineSpacing(characterSize);
+
+    sf::Vector2f pen{0.f, static_cast<float>(characterSize)};
+    char32_t previous = 0;
+
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        const char32_t current = toCodepoint(text[i]);
+
+        if (current == U'\r') {
+            m_vertexEnd.push_back(m_vertices.size());
+            continue;
+        }
+
+        // Wrap before a word that would overrun the line
+        const bool wordStart = !isBreak(current) && (i == 0 || isBreak(toCodepoint(text[i - 1])));
+        if (wordStart && maxWidth > 0.f && pen.x > 0.f && pen.x + measureWord(text, i) > maxWidth) {
+            pen.x = 0.f;
+            pen.y += lineSpacing;
+            previous = 0;
+        }
+
+        pen.x += font.getKerning(previous, current, characterSize);
+        previous = current;
+
+        switch (current) {
+        case U' ':
+            pen.x += whitespaceWidth;
+            break;
+        case U'\t':
+            pen.x += whitespaceWidth * 4.f;
+            break;
+        case U'\n':
+            pen.x = 0.f;
+            pen.y += lineSpacing;
+            break;
+        default: {
+            const sf::Glyph& glyph = font.getGlyph(current, characterSize, false);
+            appendQuad(m_vertices, pen, glyph, color);
+            pen.x += glyph.advance;
+            break;
+        }
+        }
+
+        m_vertexEnd.push_back(m_vertices.size());
+    }
+}
+
+float TextLayout::measureWord(const std::string& text, std::size_t first) const {
+    float width = 0.f;
+    char32_t previous = 0;
+    for (std::size_t i = first; i < text.size(); ++i) {
+        const char32_t current = toCodepoint(text[i]);
+        if (isBreak(current)) {
+            break;
+        }
+        width += m_font->getKerning(previous, current, m_characterSize);
+        width += m_font->getGlyph(current, m_characterSize, false).advance;
+        previous = current;
+    }
+    return width;
+}
+
+void TextLayout::clear() {
+    m_vertices.clear();
+    m_vertexEnd.clear();
+}
+
+void TextLayout::setColor(sf::Color color) {
+    for (sf::Vertex& vertex : m_vertices) {
+        vertex.color = color;
+    }
+}
+
+void TextLayout::draw(sf::RenderTarget& target, std::size_t characters, sf::RenderStates states) const {
+    if (!m_font || m_vertexEnd.empty()) {
+        return;
+    }
+
+    const std::size_t count = m_vertexEnd[std::min(characters, m_vertexEnd.size() - 1)];
+    if (count == 0) {
+        return;
+    }
+
+    states.transform.translate(m_position);
+    states.texture = &m_font->getTexture(m_characterSize);
+    target.draw(m_vertices.data(), count, sf::PrimitiveType::Triangles, states);
+}
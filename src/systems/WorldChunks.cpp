@@ -0,0 +1,222 @@
+#include "systems/WorldChunks.h"
+
+#include "Systems.h"
+#include "components/Map.h"
+#include "components/TransformComponent.h"
+#include "systems/Camera.h"
+#include "systems/Geometry.h"
+
+#include <algorithm>
+#include <cmath>
+
+void WorldChunks::build(const Map& map, float tileSize, const sf::Vector2f& offset) {
+    clear();
+
+    m_map = &map;
+    m_tileSize = tileSize;
+    m_offset = offset;
+    if (map.getWidth() <= 0 || map.getHeight() <= 0 || tileSize <= 0.f) {
+        return;
+    }
+
+    m_columns = (map.getWidth() + kChunkTiles - 1) / kChunkTiles;
+    m_rows = (map.getHeight() + kChunkTiles - 1) / kChunkTiles;
+    m_chunks.resize(static_cast<std::size_t>(m_columns) * m_rows);
+
+    for (int cy = 0; cy < m_rows; ++cy) {
+        for (int cx = 0; cx < m_columns; ++cx) {
+            Chunk& chunk = m_chunks[static_cast<std::size_t>(cy) * m_columns + cx];
+            const sf::Vector2i first{ cx * kChunkTiles, cy * kChunkTiles };
+            const sf::Vector2i size{ std::min(kChunkTiles, map.getWidth() - first.x),
+                                     std::min(kChunkTiles, map.getHeight() - first.y) };
+            chunk.tiles = sf::IntRect(first, size);
+            chunk.bounds = sf::FloatRect(
+                offset + sf::Vector2f(static_cast<float>(first.x), static_cast<float>(first.y)) * tileSize,
+                sf::Vector2f(static_cast<float>(size.x), static_cast<float>(size.y)) * tileSize);
+        }
+    }
+}
+
+void WorldChunks::clear() {
+    m_map = nullptr;
+    m_columns = 0;
+    m_rows = 0;
+    m_chunks.clear();
+    m_awake.clear();
+    m_unplaced.clear();
+    m_active.clear();
+    m_nextOrder = 0;
+}
+
+void WorldChunks::assign(const std::vector<Entity*>& entities) {
+    for (Chunk& chunk : m_chunks) {
+        chunk.residents.clear();
+    }
+    m_unplaced.clear();
+    m_nextOrder = 0;
+
+    for (Entity* entity : entities) {
+        add(entity);
+    }
+}
+
+void WorldChunks::add(Entity* entity) {
+    if (!entity) {
+        return;
+    }
+
+    const Resident resident{ m_nextOrder++, entity };
+    const std::uint32_t chunk = chunkOf(*entity);
+    if (chunk == kNoChunk) {
+        m_unplaced.push_back(resident);
+    }
+    else {
+        m_chunks[chunk].residents.push_back(resident);
+    }
+}
+
+void WorldChunks::update(const sf::FloatRect& focus) {
+    m_active.clear();
+    m_activeScratch.assign(m_unplaced.begin(), m_unplaced.end());
+
+    if (!m_chunks.empty()) {
+        // Focus grown by one chunk on every side
+        const float chunkSize = m_tileSize * kChunkTiles;
+        const int x0 = std::clamp(static_cast<int>(std::floor((focus.position.x - m_offset.x) / chunkSize)) - 1, 0, m_columns - 1);
+        const int y0 = std::clamp(static_cast<int>(std::floor((focus.position.y - m_offset.y) / chunkSize)) - 1, 0, m_rows - 1);
+        const int x1 = std::clamp(static_cast<int>(std::floor((focus.position.x + focus.size.x - m_offset.x) / chunkSize)) + 1, 0, m_columns - 1);
+        const int y1 = std::clamp(static_cast<int>(std::floor((focus.position.y + focus.size.y - m_offset.y) / chunkSize)) + 1, 0, m_rows - 1);
+
+        m_wakeScratch.clear();
+        for (int cy = y0; cy <= y1; ++cy) {
+            for (int cx = x0; cx <= x1; ++cx) {
+                m_wakeScratch.push_back(static_cast<std::size_t>(cy) * m_columns + cx);
+            }
+        }
+
+        for (std::size_t chunk : m_awake) {
+            if (!std::binary_search(m_wakeScratch.begin(), m_wakeScratch.end(), chunk)) {
+                sleep(chunk);
+            }
+        }
+        for (std::size_t chunk : m_wakeScratch) {
+            if (!m_chunks[chunk].awake) {
+                wake(chunk);
+            }
+        }
+        m_awake.swap(m_wakeScratch);
+
+        // Awake entities may have moved since the last update
+        m_moves.clear();
+        for (std::size_t chunkIndex : m_awake) {
+            std::vector<Resident>& residents = m_chunks[chunkIndex].residents;
+            for (std::size_t i = residents.size(); i-- > 0;) {
+                const std::uint32_t target = chunkOf(*residents[i].entity);
+                if (target != kNoChunk && target != chunkIndex) {
+                    m_moves.emplace_back(residents[i], target);
+                    residents[i] = residents.back();
+                    residents.pop_back();
+                }
+            }
+        }
+        for (const auto& move : m_moves) {
+            m_chunks[move.second].residents.push_back(move.first);
+        }
+
+        for (std::size_t chunkIndex : m_awake) {
+            const std::vector<Resident>& residents = m_chunks[chunkIndex].residents;
+            m_activeScratch.insert(m_activeScratch.end(), residents.begin(), residents.end());
+        }
+    }
+
+    std::sort(m_activeScratch.begin(), m_activeScratch.end(),
+        [](const Resident& a, const Resident& b) { return a.order < b.order; });
+    m_active.reserve(m_activeScratch.size());
+    for (const Resident& resident : m_activeScratch) {
+        m_active.push_back(resident.entity);
+    }
+}
+
+void WorldChunks::drawMap(sf::RenderTarget& target) const {
+    const sf::FloatRect visible = viewBounds(target.getView());
+    for (std::size_t chunkIndex : m_awake) {
+        const Chunk& chunk = m_chunks[chunkIndex];
+        if (!geometry::boxesOverlap(chunk.bounds, visible)) {
+            continue;
+        }
+
+        for (const MeshLayer& layer : chunk.mesh) {
+            sf::RenderStates states;
+            states.texture = layer.texture;
+            target.draw(layer.vertices.data(), layer.vertices.size(), sf::PrimitiveType::Triangles, states);
+        }
+    }
+}
+
+std::uint32_t WorldChunks::chunkAt(const sf::Vector2f& position) const {
+    // Positions off the map (the margin around a small level) use the edge chunk
+    const float chunkSize = m_tileSize * kChunkTiles;
+    const int cx = std::clamp(static_cast<int>(std::floor((position.x - m_offset.x) / chunkSize)), 0, m_columns - 1);
+    const int cy = std::clamp(static_cast<int>(std::floor((position.y - m_offset.y) / chunkSize)), 0, m_rows - 1);
+    return static_cast<std::uint32_t>(cy * m_columns + cx);
+}
+
+std::uint32_t WorldChunks::chunkOf(Entity& entity) const {
+    if (m_chunks.empty()) {
+        return kNoChunk;
+    }
+    auto* transform = entity.getComponent<eol::TransformComponent>();
+    return transform ? chunkAt(transform->getPosition()) : kNoChunk;
+}
+
+void WorldChunks::wake(std::size_t chunk) {
+    m_chunks[chunk].awake = true;
+    bakeMesh(m_chunks[chunk]);
+}
+
+void WorldChunks::sleep(std::size_t chunk) {
+    // Release the mesh memory, not just the contents
+    m_chunks[chunk].awake = false;
+    std::vector<MeshLayer>().swap(m_chunks[chunk].mesh);
+}
+
+void WorldChunks::bakeMesh(Chunk& chunk) const {
+    chunk.mesh.clear();
+    if (!m_map) {
+        return;
+    }
+
+    for (int y = chunk.tiles.position.y; y < chunk.tiles.position.y + chunk.tiles.size.y; ++y) {
+        for (int x = chunk.tiles.position.x; x < chunk.tiles.position.x + chunk.tiles.size.x; ++x) {
+            sf::Color color;
+            const sf::Texture* texture = m_map->getTileTexture(m_map->getTile(x, y), color);
+            if (texture) {
+                color = sf::Color::White;
+            }
+
+            // One layer per texture; a chunk only ever uses a handful
+            auto layer = std::find_if(chunk.mesh.begin(), chunk.mesh.end(),
+                [texture](const MeshLayer& candidate) { return candidate.texture == texture; });
+            if (layer == chunk.mesh.end()) {
+                chunk.mesh.push_back(MeshLayer{ texture, {} });
+                layer = chunk.mesh.end() - 1;
+            }
+
+            const sf::Vector2f topLeft = m_offset + sf::Vector2f(static_cast<float>(x), static_cast<float>(y)) * m_tileSize;
+            const sf::Vector2f bottomRight = topLeft + sf::Vector2f(m_tileSize, m_tileSize);
+            const sf::Vector2f texSize = texture
+                ? sf::Vector2f(static_cast<float>(texture->getSize().x), static_cast<float>(texture->getSize().y))
+                : sf::Vector2f(0.f, 0.f);
+
+            const sf::Vertex quad[6] = {
+                { topLeft, color, { 0.f, 0.f } },
+                { { bottomRight.x, topLeft.y }, color, { texSize.x, 0.f } },
+                { { topLeft.x, bottomRight.y }, color, { 0.f, texSize.y } },
+                { { topLeft.x, bottomRight.y }, color, { 0.f, texSize.y } },
+                { { bottomRight.x, topLeft.y }, color, { texSize.x, 0.f } },
+                { bottomRight, color, texSize },
+            };
+            layer->vertices.insert(layer->vertices.end(), quad, quad + 6);
+        }
+    }
+}